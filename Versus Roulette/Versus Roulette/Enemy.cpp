@@ -6,6 +6,8 @@
 #include "Player.h"   
 #include <SFML/Graphics/Transformable.hpp>
 #include "Game.h"
+#include "TextureCache.h"
+#include "Logger.h"
 #include "Globals.h"
 #include "Enemy.h"
 
@@ -15,12 +17,13 @@ Enemy::Enemy() //default constructor
 	initializeInventoryArray();
 	animationPlaying = false;
 	currentAnimation = 0;
+	animationsStarted = 0;
 	enemyFrame = -1;
 	frameCounter = 0.0f;
 	frameIncrement = 0.2f;
 
 	itemsHeld = 0;
-	health = 5;
+	health = ClassicRules::startingHealth;
 }
 
 /// <summary>
@@ -29,26 +32,26 @@ Enemy::Enemy() //default constructor
 void Enemy::setupSprite()
 {
 	//loads blank and live spritesheet textures
-	if (!textureBlank.loadFromFile("ASSETS\\IMAGES\\enemy shoot blank sheet.png"))
+	if (!loadTextureCached(textureBlank, "ASSETS\\IMAGES\\enemy shoot blank sheet.png"))
 	{
-		std::cout << "problem loading enemy shoot blank texture" << std::endl;
+		LOG_ERROR("problem loading enemy shoot blank texture");
 	}
-	if (!textureLive.loadFromFile("ASSETS\\IMAGES\\enemy shoot live sheet.png"))
+	if (!loadTextureCached(textureLive, "ASSETS\\IMAGES\\enemy shoot live sheet.png"))
 	{
-		std::cout << "problem loading enemy shoot live texture" << std::endl;
+		LOG_ERROR("problem loading enemy shoot live texture");
 	}
-	if (!textureBlankSelf.loadFromFile("ASSETS\\IMAGES\\enemy shoot self blank-Sheet.png"))
+	if (!loadTextureCached(textureBlankSelf, "ASSETS\\IMAGES\\enemy shoot self blank-Sheet.png"))
 	{
-		std::cout << "problem loading enemy shoot self blank texture" << std::endl;
+		LOG_ERROR("problem loading enemy shoot self blank texture");
 	}
-	if (!textureLiveSelf.loadFromFile("ASSETS\\IMAGES\\enemy shoot self live-Sheet.png"))
+	if (!loadTextureCached(textureLiveSelf, "ASSETS\\IMAGES\\enemy shoot self live-Sheet.png"))
 	{
-		std::cout << "problem loading enemy shoot self live texture" << std::endl;
+		LOG_ERROR("problem loading enemy shoot self live texture");
 	}
 
-	if (!textureHit.loadFromFile("ASSETS\\IMAGES\\enemy tased-Sheet.png"))
+	if (!loadTextureCached(textureHit, "ASSETS\\IMAGES\\enemy tased-Sheet.png"))
 	{
-		std::cout << "problem loading enemy tased texture" << std::endl;
+		LOG_ERROR("problem loading enemy tased texture");
 	}
 
 	sprite.setTexture(textureLive);
@@ -72,6 +75,10 @@ void Enemy::setAnimationPlaying(bool t_AnimationPlaying, int t_animationToPlay)
 {
 	animationPlaying = t_AnimationPlaying;
 	currentAnimation = t_animationToPlay;
+	if (t_AnimationPlaying)
+	{
+		animationsStarted++;
+	}
 }
 
 bool Enemy::getAnimationPlaying() // returns whether animation playing or not
@@ -79,6 +86,16 @@ bool Enemy::getAnimationPlaying() // returns whether animation playing or not
 	return animationPlaying;
 }
 
+int Enemy::getCurrentAnimation() const // returns the animation playing, 0 for none
+{
+	return animationPlaying ? currentAnimation : 0;
+}
+
+int Enemy::getAnimationsStarted() const // returns how many animations have been started
+{
+	return animationsStarted;
+}
+
 void Enemy::playAnimation() // calls currently selected animation to play
 {
 	switch (currentAnimation)
@@ -230,7 +247,7 @@ void Enemy::initializeInventoryArray()
 }
 
 // returns invetory item from space specified
-int Enemy::getInventoryArray(int t_index)
+int Enemy::getInventoryArray(int t_index) const
 {
 	return inventoryArray[t_index];
 }
@@ -268,7 +285,7 @@ int Enemy::getHealth() const
 // resets variables to default
 void Enemy::reset() 
 {
-	health = 5;
+	health = ClassicRules::startingHealth;
 	itemsHeld = 0;
 	animationPlaying = false;
 	currentAnimation = 0;
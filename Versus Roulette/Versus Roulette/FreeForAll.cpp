@@ -0,0 +1,340 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "FreeForAll.h"
+#include "Policy.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+
+void FfaMatch::reset(int t_seats)
+{
+	seats = std::clamp(t_seats, 2, MAX_FFA_SEATS);
+	round = 0;
+	for (int index = 0; index < Rules::SHOT_CAPACITY; index++)
+	{
+		taserArray[index] = 0;
+	}
+	currentShot = -1;
+	currentLoadedShots = 0;
+	liveRounds = 0;
+	blankRounds = 0;
+	turn = 0;
+	doubleDamage = false;
+	knowItsLive = false;
+	knowItsBlank = false;
+	alive = (1u << seats) - 1;
+	paused = 0;
+	for (int seat = 0; seat < MAX_FFA_SEATS; seat++)
+	{
+		health[seat] = seat < seats ? static_cast<std::int8_t>(Rules::startingHealth) : 0;
+	}
+	for (int slot = 0; slot < Rules::ITEM_CAPACITY; slot++)
+	{
+		for (int seat = 0; seat < MAX_FFA_SEATS; seat++)
+		{
+			inventory[slot][seat] = 0;
+		}
+	}
+}
+
+/// <summary>
+/// loads the taser, deals the robots still standing their items and gives the first turn
+/// to the next robot round the table from whoever started the last round
+/// </summary>
+void FfaMatch::startRound(FastRandom& t_random)
+{
+	const Rules rules;
+	loadRandomTaser(*this, t_random, rules);
+
+	int itemsGiven[MAX_FFA_SEATS] = {};
+	for (int slot = 0; slot < Rules::itemSlots; slot++)
+	{
+		for (int seat = 0; seat < seats; seat++)
+		{
+			if (!isAlive(seat))
+			{
+				continue;
+			}
+			dealItem(inventory[slot][seat], itemsGiven[seat], t_random, rules);
+		}
+	}
+	passTurn((round + seats - 1) % seats); // a pause carries into the new round, like the two seat game
+	round++;
+}
+
+/// <summary>
+/// plays t_action for t_seat. a target that isn't another robot still standing
+/// becomes the next one round the table, so a bad choice can't stall the match
+/// </summary>
+FfaOutcome FfaMatch::apply(int t_seat, FfaAction t_action)
+{
+	FfaOutcome outcome{ 0, false, false, -1, 0 };
+	int target = t_action.target;
+	if (target < 0 || target >= seats || target == t_seat || !isAlive(target))
+	{
+		target = nextSeatAfter(t_seat);
+	}
+	switch (t_action.type)
+	{
+	case SHOOT_SELF_ACTION:
+	case SHOOT_OPPONENT_ACTION:
+	{
+		outcome.shot = true;
+		outcome.damage = chargeDamage(*this);
+		outcome.live = fireShot(*this) == 1;
+		if (t_action.type == SHOOT_SELF_ACTION)
+		{
+			if (!outcome.live)
+			{
+				return outcome; // a blank on yourself keeps the turn
+			}
+			outcome.hitSeat = t_seat;
+		}
+		else if (outcome.live)
+		{
+			outcome.hitSeat = target;
+		}
+		if (outcome.hitSeat != -1)
+		{
+			hit(outcome.hitSeat, outcome.damage);
+		}
+		passTurn(t_seat);
+		break;
+	}
+	case USE_ITEM_ACTION:
+		if (t_action.slot < 0 || t_action.slot >= Rules::itemSlots)
+		{
+			break;
+		}
+		outcome.item = inventory[t_action.slot][t_seat];
+		inventory[t_action.slot][t_seat] = 0;
+		if (outcome.item == PAUSE_REMOTE)
+		{
+			paused |= 1u << target;
+		}
+		else
+		{
+			outcome.live = applyItemEffect(*this, outcome.item, t_seat) == 1;
+		}
+		break;
+	}
+	return outcome;
+}
+
+int FfaMatch::aliveCount() const
+{
+	return std::popcount(alive);
+}
+
+int FfaMatch::findItem(int t_seat, int t_item) const
+{
+	for (int slot = 0; slot < Rules::itemSlots; slot++)
+	{
+		if (inventory[slot][t_seat] == t_item)
+		{
+			return slot;
+		}
+	}
+	return -1;
+}
+
+int FfaMatch::nextSeatAfter(int t_seat) const
+{
+	const std::uint32_t self = 1u << t_seat;
+	const std::uint32_t others = alive & ~self;
+	if (others == 0)
+	{
+		return t_seat;
+	}
+	const std::uint32_t above = others & ~((self << 1) - 1);
+	return std::countr_zero(above != 0 ? above : others);
+}
+
+int FfaMatch::nextReadySeatAfter(int t_seat) const
+{
+	const std::uint32_t ready = alive & ~paused & ~(1u << t_seat);
+	if (ready == 0)
+	{
+		return t_seat;
+	}
+	const std::uint32_t above = ready & ~((2u << t_seat) - 1);
+	return std::countr_zero(above != 0 ? above : ready);
+}
+
+int FfaMatch::winner() const
+{
+	if (isOver())
+	{
+		return alive == 0 ? NO_WINNER : std::countr_zero(alive);
+	}
+	int best = NO_WINNER;
+	bool tied = false;
+	for (int seat = 0; seat < seats; seat++)
+	{
+		if (!isAlive(seat))
+		{
+			continue;
+		}
+		if (best == NO_WINNER || health[seat] > health[best])
+		{
+			best = seat;
+			tied = false;
+		}
+		else if (health[seat] == health[best])
+		{
+			tied = true;
+		}
+	}
+	return tied ? NO_WINNER : best;
+}
+
+/// <summary>
+/// gives the turn to the next robot round the table that isn't paused. the paused robots
+/// passed over miss their turn and lose the pause, if everyone else is paused t_seat goes again
+/// </summary>
+void FfaMatch::passTurn(int t_seat)
+{
+	const std::uint32_t self = 1u << t_seat;
+	const std::uint32_t upTo = (self << 1) - 1; // t_seat and every seat before it
+	const int next = nextReadySeatAfter(t_seat);
+	if (next == t_seat)
+	{
+		paused &= self;
+		turn = isAlive(t_seat) ? t_seat : nextSeatAfter(t_seat);
+		return;
+	}
+	const std::uint32_t before = (1u << next) - 1;
+	const std::uint32_t skipped = next > t_seat ? before & ~upTo : before | ~upTo;
+	paused &= ~skipped;
+	turn = next;
+}
+
+void FfaMatch::hit(int t_seat, int t_damage)
+{
+	health[t_seat] = static_cast<std::int8_t>(health[t_seat] - t_damage);
+	if (health[t_seat] <= 0)
+	{
+		alive &= ~(1u << t_seat);
+		paused &= ~(1u << t_seat);
+	}
+}
+
+/// <summary>
+/// the table as a two seat match between t_seat and t_target, t_seat to move as PLAYER.
+/// the taser and item flags are shared so they carry over as they are
+/// </summary>
+MatchState FfaMatch::duelView(int t_seat, int t_target) const
+{
+	MatchState duel;
+	duel.round = round;
+	for (int index = 0; index < Rules::SHOT_CAPACITY; index++)
+	{
+		duel.taserArray[index] = taserArray[index];
+	}
+	duel.currentShot = currentShot;
+	duel.currentLoadedShots = currentLoadedShots;
+	duel.liveRounds = liveRounds;
+	duel.blankRounds = blankRounds;
+	const int seats[2] = { t_seat, t_target };
+	for (int seat = 0; seat < 2; seat++)
+	{
+		duel.health[seat] = health[seats[seat]];
+		duel.paused[seat] = isPaused(seats[seat]);
+		for (int slot = 0; slot < Rules::ITEM_CAPACITY; slot++)
+		{
+			duel.inventory[seat][slot] = inventory[slot][seats[seat]];
+		}
+	}
+	duel.turn = PLAYER;
+	duel.doubleDamage = doubleDamage;
+	duel.knowItsLive = knowItsLive;
+	duel.knowItsBlank = knowItsBlank;
+	return duel;
+}
+
+FfaAction ffaHeuristic(const FfaMatch& t_state)
+{
+	const int seat = t_state.turn;
+
+	// the weakest robot left, the nearest in turn order on a tie
+	int target = -1;
+	for (int step = 1; step < t_state.seats; step++)
+	{
+		int other = seat + step;
+		if (other >= t_state.seats)
+		{
+			other -= t_state.seats;
+		}
+		if (t_state.isAlive(other) && (target == -1 || t_state.health[other] < t_state.health[target]))
+		{
+			target = other;
+		}
+	}
+
+	const MatchState duel = t_state.duelView(seat, target);
+	HeuristicPolicy policy;
+	Action action = policy.chooseAction(Observation(duel, PLAYER));
+	if (action.type == USE_ITEM_ACTION && t_state.inventory[action.slot][seat] == PAUSE_REMOTE)
+	{
+		const int next = t_state.nextReadySeatAfter(seat); // whoever would move next, if anyone isn't paused already
+		target = next != seat ? next : target;
+	}
+	return { action.type, action.slot, target };
+}
+
+int playFfaMatch(FfaMatch& t_state, int t_seats, FastRandom& t_random, long long& t_actions)
+{
+	t_state.reset(t_seats);
+	while (!t_state.isOver() && !t_state.isOutOfRounds())
+	{
+		if (t_state.needsNewRound())
+		{
+			t_state.startRound(t_random);
+		}
+		t_state.apply(t_state.turn, ffaHeuristic(t_state));
+		t_actions++;
+	}
+	return t_state.winner();
+}
+
+void runFreeForAllBenchmark(int t_matches, std::uint64_t t_seed)
+{
+	if (t_matches <= 0)
+	{
+		return;
+	}
+
+	// two seats goes through the same code, as the baseline the bigger tables are measured against
+	const int tableSizes[] = { 2, 3, 4, 6, 8, 12, 16 };
+	std::cout << "robots  matches/s  actions/match  ns/action  ns/action/robot  first seat wins  draws" << std::endl;
+	FfaMatch state;
+	for (int seats : tableSizes)
+	{
+		FastRandom random(t_seed);
+		long long actions = 0;
+		long long wins[MAX_FFA_SEATS] = {};
+		long long draws = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int match = 0; match < t_matches; match++)
+		{
+			int winner = playFfaMatch(state, seats, random, actions);
+			if (winner == NO_WINNER)
+			{
+				draws++;
+			}
+			else
+			{
+				wins[winner]++;
+			}
+		}
+		double seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-9);
+		double nanosecondsPerAction = seconds * 1e9 / std::max(actions, 1LL);
+		std::cout << seats << "  " << static_cast<long long>(t_matches / seconds) << "  " << static_cast<double>(actions) / t_matches
+			<< "  " << nanosecondsPerAction << "  " << nanosecondsPerAction / seats
+			<< "  " << 100.0 * wins[0] / t_matches << "% (fair " << 100.0 / seats << "%)  " << 100.0 * draws / t_matches << "%" << std::endl;
+	}
+}
@@ -0,0 +1,102 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Free for all: 3 to 16 robots round one table sharing one taser, with the classic rules otherwise.
+/// The shooter picks who to shoot, the pause remote skips one robot's next turn, and the last robot
+/// standing wins. The taser, the deal, damage and the items go through the same rule functions as
+/// MatchState (MatchState.h), only the seats differ. Each seat field is an array over the seats (health,
+/// then every inventory slot), and who is alive or paused is a bit per seat, so passing the turn is a
+/// couple of bit operations and the per action work only grows with the scans over the seats.
+/// The robots play HeuristicPolicy on a two seat view of themselves against the robot they target.
+#pragma once
+
+#include <cstdint>
+#include "MatchRules.h"
+#include "MatchState.h"
+#include "Random.h"
+
+const int static MIN_FFA_SEATS = 3;
+const int static MAX_FFA_SEATS = 16;
+
+/// <summary>
+/// an action in a free for all, t_target is the seat shot or paused
+/// </summary>
+struct FfaAction
+{
+	int type; // SHOOT_SELF_ACTION, SHOOT_OPPONENT_ACTION or USE_ITEM_ACTION
+	int slot;
+	int target;
+};
+
+/// <summary>
+/// what the last action did, for the window
+/// </summary>
+struct FfaOutcome
+{
+	int item; // the item used, 0 for a shot
+	bool shot;
+	bool live;
+	int hitSeat; // -1 when nobody was hit
+	int damage;
+};
+
+struct FfaMatch
+{
+	using Rules = ClassicRules;
+
+	int seats;
+	int round;
+	int taserArray[Rules::SHOT_CAPACITY]; // 1 is live, 0 is blank, the same taser as MatchState
+	int currentShot; // index of the shot that fires next, -1 once the taser is empty
+	int currentLoadedShots;
+	int liveRounds;
+	int blankRounds;
+	int turn;
+	bool doubleDamage;
+	bool knowItsLive;
+	bool knowItsBlank;
+	std::uint32_t alive; // bit per seat
+	std::uint32_t paused; // bit per seat, skipped the next time the turn reaches it
+
+	// structure of arrays, one entry per seat. slot by slot so dealing a slot to every seat is one run
+	std::int8_t health[MAX_FFA_SEATS];
+	std::uint8_t inventory[Rules::ITEM_CAPACITY][MAX_FFA_SEATS];
+
+	void reset(int t_seats);
+	void startRound(FastRandom& t_random);
+	FfaOutcome apply(int t_seat, FfaAction t_action);
+
+	bool needsNewRound() const { return currentLoadedShots <= 0; }
+	bool isOver() const { return (alive & (alive - 1)) == 0; } // one robot or none left
+	bool isOutOfRounds() const { return needsNewRound() && round >= Rules::maxRounds; }
+	bool isAlive(int t_seat) const { return (alive >> t_seat) & 1; }
+	bool isPaused(int t_seat) const { return (paused >> t_seat) & 1; }
+	int aliveCount() const;
+	int findItem(int t_seat, int t_item) const;
+	int nextSeatAfter(int t_seat) const; // the next robot alive, ignoring pauses, t_seat itself if it's the only one
+	int nextReadySeatAfter(int t_seat) const; // who passTurn would hand the turn to, t_seat if everyone else is paused
+	int winner() const; // the last robot standing, or the healthiest after the last round, NO_WINNER on a tie
+	MatchState duelView(int t_seat, int t_target) const; // t_seat as PLAYER against t_target, for the two seat policies
+
+private:
+	void passTurn(int t_seat);
+	void hit(int t_seat, int t_damage);
+};
+
+/// <summary>
+/// HeuristicPolicy with a choice of target: it plays against the weakest robot left,
+/// the one nearest in turn order on a tie, and pauses whoever moves next
+/// </summary>
+FfaAction ffaHeuristic(const FfaMatch& t_state);
+
+/// <summary>
+/// plays a match from a fresh table with every robot on the heuristic, returns the winning seat
+/// </summary>
+int playFfaMatch(FfaMatch& t_state, int t_seats, FastRandom& t_random, long long& t_actions);
+
+/// <summary>
+/// entry point for "--ffa [matches] [seed]": plays t_matches at every table size
+/// and prints matches per second and the cost per action and per seat
+/// </summary>
+void runFreeForAllBenchmark(int t_matches, std::uint64_t t_seed);
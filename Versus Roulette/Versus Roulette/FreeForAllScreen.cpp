@@ -0,0 +1,492 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "FreeForAllScreen.h"
+#include "Globals.h"
+#include "TextureCache.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+
+const int static FFA_FRAME_WIDTH = 192; // first frame of the player sheet
+const int static FFA_FRAME_HEIGHT = 128;
+const int static FFA_ACTION_TICKS = 40; // ticks between moves, so a move can be followed
+const int static FFA_FLASH_TICKS = 30;
+const int static FFA_RESTART_TICKS = 240;
+const char* const FFA_ITEM_NAMES[RUBBISH_BIN + 1] = { "nothing", "an oil drink", "the scanner", "the pause remote", "the overcharger", "the rubbish bin" };
+
+/// <summary>
+/// adds a rectangle as four corners of a quad, t_texture is in pixels and flipped left to right when t_flip is set
+/// </summary>
+static void appendQuad(sf::VertexArray& t_vertices, const sf::FloatRect& t_area, const sf::FloatRect& t_texture,
+	const sf::Color& t_colour, bool t_flip = false)
+{
+	float left = t_flip ? t_texture.left + t_texture.width : t_texture.left;
+	float right = t_flip ? t_texture.left : t_texture.left + t_texture.width;
+	float bottom = t_texture.top + t_texture.height;
+	t_vertices.append(sf::Vertex(sf::Vector2f(t_area.left, t_area.top), t_colour, sf::Vector2f(left, t_texture.top)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(t_area.left + t_area.width, t_area.top), t_colour, sf::Vector2f(right, t_texture.top)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(t_area.left + t_area.width, t_area.top + t_area.height), t_colour, sf::Vector2f(right, bottom)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(t_area.left, t_area.top + t_area.height), t_colour, sf::Vector2f(left, bottom)));
+}
+
+FreeForAllScreen::FreeForAllScreen() :
+	flashTicks{},
+	keyboardSeat(-1),
+	target(-1),
+	robots{ sf::Quads },
+	markers{ sf::Quads },
+	items{ sf::Quads }
+{
+	state.reset(MIN_FFA_SEATS);
+	if (!loadTextureCached(robotTexture, "ASSETS\\IMAGES\\player shoot blank sheet.png"))
+	{
+		LOG_ERROR("problem loading player shoot blank texture");
+	}
+	if (!loadTextureCached(itemSheetTexture, "ASSETS\\IMAGES\\Item-Sheet.png"))
+	{
+		LOG_ERROR("problem loading item sheet texture");
+	}
+	if (!loadTextureCached(tableTexture, "ASSETS\\IMAGES\\table.png"))
+	{
+		LOG_ERROR("problem loading table texture");
+	}
+	background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
+	background.setFillColor(sf::Color(30, 30, 38));
+	tableSprite.setTexture(tableTexture);
+	sf::Vector2u tableSize = tableTexture.getSize();
+	if (tableSize.x > 0 && tableSize.y > 0)
+	{
+		float scale = std::min(320.0f / tableSize.x, 200.0f / tableSize.y);
+		tableSprite.setScale(scale, scale);
+		tableSprite.setPosition(SCREEN_WIDTH / 2.0f - tableSize.x * scale / 2.0f, 310.0f - tableSize.y * scale / 2.0f);
+	}
+
+	if (!font.loadFromFile("ASSETS\\FONTS\\ariblk.ttf"))
+	{
+		LOG_ERROR("problem loading arial black font");
+	}
+	message.setFont(font);
+	message.setCharacterSize(20U);
+	message.setStyle(sf::Text::Italic | sf::Text::Bold);
+	message.setFillColor(sf::Color::White);
+	message.setPosition(15.0f, 10.0f);
+	prompt.setFont(font);
+	prompt.setCharacterSize(14U);
+	prompt.setStyle(sf::Text::Bold);
+	prompt.setFillColor(sf::Color(150, 220, 255));
+	prompt.setPosition(520.0f, 10.0f);
+}
+
+/// <summary>
+/// takes a copy of the table after a move, t_hitSeat flashes red
+/// </summary>
+void FreeForAllScreen::show(const FfaMatch& t_state, const std::string& t_message, int t_hitSeat)
+{
+	state = t_state;
+	if (t_hitSeat >= 0 && t_hitSeat < MAX_FFA_SEATS)
+	{
+		flashTicks[t_hitSeat] = FFA_FLASH_TICKS;
+	}
+	message.setString(t_message);
+}
+
+/// <summary>
+/// marks the robot on the keyboard and the one it's aiming at, with t_prompt in the corner
+/// </summary>
+void FreeForAllScreen::setSelection(int t_keyboardSeat, int t_target, const std::string& t_prompt)
+{
+	keyboardSeat = t_keyboardSeat;
+	target = t_target;
+	prompt.setString(t_prompt);
+}
+
+void FreeForAllScreen::update()
+{
+	for (int seat = 0; seat < MAX_FFA_SEATS; seat++)
+	{
+		if (flashTicks[seat] > 0)
+		{
+			flashTicks[seat]--;
+		}
+	}
+}
+
+void FreeForAllScreen::draw(RenderBackend& t_renderer)
+{
+	buildVertices();
+	t_renderer.draw(background);
+	t_renderer.draw(tableSprite);
+	t_renderer.draw(robots, sf::RenderStates(&robotTexture));
+	t_renderer.draw(markers, sf::RenderStates::Default);
+	t_renderer.draw(items, sf::RenderStates(&itemSheetTexture));
+	t_renderer.draw(message);
+	t_renderer.draw(prompt);
+}
+
+/// <summary>
+/// seat 0 at the bottom, the rest clockwise round an oval about the table
+/// </summary>
+sf::Vector2f FreeForAllScreen::seatPosition(int t_seat) const
+{
+	const float angle = 1.5707963f + 6.2831853f * t_seat / state.seats;
+	return sf::Vector2f(SCREEN_WIDTH / 2.0f + 310.0f * std::cos(angle), 320.0f + 200.0f * std::sin(angle));
+}
+
+/// <summary>
+/// refills the three vertex arrays, they keep their memory so this doesn't allocate after the first frame
+/// </summary>
+void FreeForAllScreen::buildVertices()
+{
+	const sf::IntRect itemRects[RUBBISH_BIN + 1] = { NULL_RECT, OIL_DRINK_RECT, SCANNER_RECT, PAUSE_REMOTE_RECT, OVERCHARGER_RECT, RUBBISH_BIN_RECT };
+	const float scale = state.seats <= 4 ? 1.0f : (state.seats <= 8 ? 0.75f : 0.5f);
+	const float width = FFA_FRAME_WIDTH * scale;
+	const float height = FFA_FRAME_HEIGHT * scale;
+	const float pip = 8.0f * scale + 2.0f;
+	const float itemSize = 64.0f * 0.4f * scale;
+
+	robots.clear();
+	markers.clear();
+	items.clear();
+	for (int seat = 0; seat < state.seats; seat++)
+	{
+		const sf::Vector2f centre = seatPosition(seat);
+		const sf::FloatRect body(centre.x - width / 2.0f, centre.y - height / 2.0f, width, height);
+		const bool over = state.isOver();
+
+		sf::Color tint(200, 200, 200);
+		if (!state.isAlive(seat))
+		{
+			tint = sf::Color(70, 70, 70, 140);
+		}
+		else if (flashTicks[seat] > 0)
+		{
+			tint = sf::Color(255, 110, 110);
+		}
+		else if (state.isPaused(seat))
+		{
+			tint = sf::Color(130, 160, 255);
+		}
+		else if (seat == state.turn && !over)
+		{
+			tint = sf::Color::White;
+		}
+		// the sheet faces right, robots on the right of the table are flipped to face it
+		appendQuad(robots, body, sf::FloatRect(0.0f, 0.0f, static_cast<float>(FFA_FRAME_WIDTH), static_cast<float>(FFA_FRAME_HEIGHT)),
+			tint, centre.x > SCREEN_WIDTH / 2.0f + 1.0f);
+
+		if (!state.isAlive(seat))
+		{
+			continue;
+		}
+		const sf::FloatRect none(0.0f, 0.0f, 0.0f, 0.0f);
+		if (seat == state.turn && !over)
+		{
+			appendQuad(markers, sf::FloatRect(body.left, body.top + height, width, 4.0f), none, sf::Color::Yellow);
+		}
+		if (seat == keyboardSeat)
+		{
+			appendQuad(markers, sf::FloatRect(body.left, body.top - pip - 6.0f, width, 3.0f), none, sf::Color(150, 220, 255));
+		}
+		if (seat == target)
+		{
+			const sf::Color aim(255, 60, 60);
+			appendQuad(markers, sf::FloatRect(body.left, body.top, width, 2.0f), none, aim);
+			appendQuad(markers, sf::FloatRect(body.left, body.top + height - 2.0f, width, 2.0f), none, aim);
+			appendQuad(markers, sf::FloatRect(body.left, body.top, 2.0f, height), none, aim);
+			appendQuad(markers, sf::FloatRect(body.left + width - 2.0f, body.top, 2.0f, height), none, aim);
+		}
+		const int pips = std::max(static_cast<int>(state.health[seat]), FfaMatch::Rules::startingHealth);
+		const float pipsLeft = centre.x - pips * pip / 2.0f;
+		for (int index = 0; index < pips; index++)
+		{
+			sf::Color colour = index < state.health[seat] ? sf::Color(60, 220, 90) : sf::Color(60, 60, 60);
+			appendQuad(markers, sf::FloatRect(pipsLeft + index * pip, body.top - pip, pip - 2.0f, pip - 2.0f), none, colour);
+		}
+
+		const float itemsLeft = centre.x - FfaMatch::Rules::itemSlots * itemSize / 2.0f;
+		for (int slot = 0; slot < FfaMatch::Rules::itemSlots; slot++)
+		{
+			int item = state.inventory[slot][seat];
+			if (item > 0 && item <= RUBBISH_BIN)
+			{
+				const sf::IntRect& rect = itemRects[item];
+				appendQuad(items, sf::FloatRect(itemsLeft + slot * itemSize, body.top + height + 6.0f, itemSize, itemSize),
+					sf::FloatRect(static_cast<float>(rect.left), static_cast<float>(rect.top), static_cast<float>(rect.width), static_cast<float>(rect.height)),
+					sf::Color::White);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// describes a move for the message line
+/// </summary>
+static std::string describeMove(int t_seat, FfaAction t_action, const FfaOutcome& t_outcome, const FfaMatch& t_after)
+{
+	std::string robot = "Robot " + std::to_string(t_seat + 1);
+	std::string text;
+	if (!t_outcome.shot)
+	{
+		text = robot + " uses " + FFA_ITEM_NAMES[std::min(std::max(t_outcome.item, 0), static_cast<int>(RUBBISH_BIN))];
+		if (t_outcome.item == PAUSE_REMOTE)
+		{
+			text += " on robot " + std::to_string(t_action.target + 1);
+		}
+		else if (t_outcome.item == RUBBISH_BIN)
+		{
+			text += t_outcome.live ? ", out goes a live" : ", out goes a blank";
+		}
+	}
+	else if (t_action.type == SHOOT_SELF_ACTION)
+	{
+		text = robot + " shoots itself, " + (t_outcome.live ? "live" : "blank");
+	}
+	else
+	{
+		int target = t_outcome.hitSeat != -1 ? t_outcome.hitSeat : t_action.target;
+		text = robot + " shoots robot " + std::to_string(target + 1) + ", " + (t_outcome.live ? "live" : "blank");
+	}
+	if (t_outcome.hitSeat != -1 && !t_after.isAlive(t_outcome.hitSeat))
+	{
+		text += " - robot " + std::to_string(t_outcome.hitSeat + 1) + " is out";
+	}
+	return text + "\nRound " + std::to_string(t_after.round) + "   live " + std::to_string(t_after.liveRounds)
+		+ "   blank " + std::to_string(t_after.blankRounds);
+}
+
+FreeForAllTable::FreeForAllTable() :
+	keyboardSeat(-1),
+	cursor(0),
+	target(-1),
+	ticksToMove(FFA_ACTION_TICKS)
+{
+	start(MIN_FFA_SEATS, -1);
+}
+
+void FreeForAllTable::start(int t_seats, int t_keyboardSeat)
+{
+	state.reset(std::clamp(t_seats, MIN_FFA_SEATS, MAX_FFA_SEATS));
+	keyboardSeat = t_keyboardSeat < state.seats ? t_keyboardSeat : -1;
+	cursor = 0;
+	target = -1;
+	ticksToMove = FFA_ACTION_TICKS;
+	lastMove = std::to_string(state.seats) + " robots, one taser";
+	screen.show(state, lastMove, -1);
+	showPrompt();
+}
+
+/// <summary>
+/// one move every FFA_ACTION_TICKS so it can be followed, the keyboard's turn waits for confirm
+/// </summary>
+void FreeForAllTable::update(FastRandom& t_random)
+{
+	screen.update();
+	if (--ticksToMove > 0)
+	{
+		return;
+	}
+	ticksToMove = FFA_ACTION_TICKS;
+	if (state.isOver() || state.isOutOfRounds())
+	{
+		if (keyboardSeat == -1)
+		{
+			start(state.seats, -1); // the winner has been on screen long enough
+		}
+		return;
+	}
+	if (state.needsNewRound())
+	{
+		state.startRound(t_random);
+		lastMove = "Round " + std::to_string(state.round) + ", robot " + std::to_string(state.turn + 1) + " starts";
+		screen.show(state, lastMove, -1);
+		showPrompt();
+	}
+	else if (!isKeyboardTurn())
+	{
+		play(state.turn, ffaHeuristic(state));
+	}
+}
+
+void FreeForAllTable::moveCursor(int t_step)
+{
+	if (!isKeyboardTurn())
+	{
+		return;
+	}
+	FfaAction options[2 + FfaMatch::Rules::ITEM_CAPACITY];
+	const int count = choices(options);
+	cursor = ((cursor + t_step) % count + count) % count;
+	showPrompt();
+}
+
+void FreeForAllTable::moveTarget(int t_step)
+{
+	if (keyboardSeat == -1)
+	{
+		return;
+	}
+	int seat = target;
+	for (int tries = 0; tries < state.seats; tries++)
+	{
+		seat = ((seat + t_step) % state.seats + state.seats) % state.seats;
+		if (seat != keyboardSeat && state.isAlive(seat))
+		{
+			target = seat;
+			break;
+		}
+	}
+	showPrompt();
+}
+
+void FreeForAllTable::confirm()
+{
+	if (keyboardSeat == -1)
+	{
+		return;
+	}
+	if (state.isOver() || state.isOutOfRounds())
+	{
+		start(state.seats, keyboardSeat);
+	}
+	else if (isKeyboardTurn())
+	{
+		FfaAction options[2 + FfaMatch::Rules::ITEM_CAPACITY];
+		const int count = choices(options);
+		play(keyboardSeat, options[std::min(cursor, count - 1)]);
+		cursor = 0;
+	}
+}
+
+bool FreeForAllTable::isKeyboardTurn() const
+{
+	return keyboardSeat != -1 && state.turn == keyboardSeat && state.isAlive(keyboardSeat)
+		&& !state.needsNewRound() && !state.isOver() && !state.isOutOfRounds();
+}
+
+/// <summary>
+/// shooting the target first, then shooting itself, then each slot holding an item
+/// </summary>
+int FreeForAllTable::choices(FfaAction* t_choices) const
+{
+	int count = 0;
+	t_choices[count++] = { SHOOT_OPPONENT_ACTION, 0, target };
+	t_choices[count++] = { SHOOT_SELF_ACTION, 0, target };
+	for (int slot = 0; slot < FfaMatch::Rules::ITEM_CAPACITY; slot++)
+	{
+		if (state.inventory[slot][keyboardSeat] != 0)
+		{
+			t_choices[count++] = { USE_ITEM_ACTION, slot, target };
+		}
+	}
+	return count;
+}
+
+void FreeForAllTable::play(int t_seat, FfaAction t_action)
+{
+	FfaOutcome outcome = state.apply(t_seat, t_action);
+	lastMove = describeMove(t_seat, t_action, outcome, state);
+	if (state.isOver() || state.isOutOfRounds())
+	{
+		int winner = state.winner();
+		lastMove += winner == NO_WINNER ? "\nNobody wins" : "\nRobot " + std::to_string(winner + 1) + " wins";
+		ticksToMove = FFA_RESTART_TICKS;
+	}
+	else
+	{
+		ticksToMove = FFA_ACTION_TICKS;
+	}
+	screen.show(state, lastMove, outcome.hitSeat);
+	showPrompt();
+}
+
+/// <summary>
+/// keeps the target on a robot still standing and tells the keyboard what return would do
+/// </summary>
+void FreeForAllTable::showPrompt()
+{
+	if (keyboardSeat == -1)
+	{
+		screen.setSelection(-1, -1, "");
+		return;
+	}
+	if (target < 0 || target >= state.seats || target == keyboardSeat || !state.isAlive(target))
+	{
+		target = state.nextSeatAfter(keyboardSeat);
+	}
+
+	std::string text = "You are robot " + std::to_string(keyboardSeat + 1);
+	if (state.isOver() || state.isOutOfRounds())
+	{
+		text += "\nReturn for another match";
+	}
+	else if (!state.isAlive(keyboardSeat))
+	{
+		text += ", you're out";
+	}
+	else if (isKeyboardTurn())
+	{
+		FfaAction options[2 + FfaMatch::Rules::ITEM_CAPACITY];
+		const int count = choices(options);
+		cursor = std::min(cursor, count - 1);
+		const FfaAction& choice = options[cursor];
+		const std::string robot = "robot " + std::to_string(target + 1);
+		text += "\nYour move: ";
+		if (choice.type == SHOOT_OPPONENT_ACTION)
+		{
+			text += "shoot " + robot;
+		}
+		else if (choice.type == SHOOT_SELF_ACTION)
+		{
+			text += "shoot yourself";
+		}
+		else
+		{
+			const int item = state.inventory[choice.slot][keyboardSeat];
+			text += std::string("use ") + FFA_ITEM_NAMES[item] + (item == PAUSE_REMOTE ? " on " + robot : "");
+		}
+		text += "\nUp/down: move  Left/right: target\nReturn plays it";
+	}
+	else
+	{
+		text += "\nRobot " + std::to_string(state.turn + 1) + " to move";
+	}
+	text += "\n+/- robots, B leaves the table";
+	screen.setSelection(keyboardSeat, isKeyboardTurn() ? target : -1, text);
+}
+
+void runFreeForAllWindow(int t_seats, std::uint64_t t_seed)
+{
+	sf::RenderWindow window{ sf::VideoMode{ static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT), 32U }, "Versus Roulette - Free For All" };
+	WindowRenderBackend renderer(window);
+	FastRandom random(t_seed);
+	FreeForAllTable table;
+	table.start(t_seats, -1);
+
+	sf::Clock clock;
+	sf::Time timeSinceLastUpdate = sf::Time::Zero;
+	sf::Time timePerFrame = sf::seconds(1.0f / 60.0f);
+	while (window.isOpen())
+	{
+		sf::Event newEvent;
+		while (window.pollEvent(newEvent))
+		{
+			if (sf::Event::Closed == newEvent.type
+				|| (sf::Event::KeyPressed == newEvent.type && sf::Keyboard::Escape == newEvent.key.code))
+			{
+				window.close();
+			}
+		}
+		timeSinceLastUpdate += clock.restart();
+		while (timeSinceLastUpdate > timePerFrame)
+		{
+			timeSinceLastUpdate -= timePerFrame;
+			table.update(random);
+		}
+		renderer.clear(sf::Color(30, 30, 38));
+		table.draw(renderer);
+		renderer.display();
+	}
+}
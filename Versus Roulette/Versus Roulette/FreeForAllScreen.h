@@ -0,0 +1,87 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// The free for all (FreeForAll.h) on screen. FreeForAllScreen draws the table: however many robots
+/// there are a frame is the same handful of draws, the background, the table, every robot body in one
+/// vertex array off one sheet, every health pip and marker in another, every item in a third, and the text.
+/// FreeForAllTable plays a match on it, one robot on the keyboard and the rest on the heuristic. Game
+/// shows it from the main menu, "--ffa-watch" opens it in its own window with every robot on the heuristic.
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include "FreeForAll.h"
+#include "RenderBackend.h"
+
+const int static FFA_MENU_SEATS = 4; // robots at the table when it's started from the main menu
+
+class FreeForAllScreen
+{
+public:
+	FreeForAllScreen();
+
+	void show(const FfaMatch& t_state, const std::string& t_message, int t_hitSeat);
+	void setSelection(int t_keyboardSeat, int t_target, const std::string& t_prompt); // -1 for either draws no marker
+	void update(); // once a tick, fades the hit flashes
+	void draw(RenderBackend& t_renderer);
+
+private:
+	sf::Vector2f seatPosition(int t_seat) const;
+	void buildVertices();
+
+	FfaMatch state;
+	int flashTicks[MAX_FFA_SEATS];
+	int keyboardSeat;
+	int target;
+
+	sf::Texture robotTexture;
+	sf::Texture itemSheetTexture;
+	sf::Texture tableTexture;
+	sf::RectangleShape background;
+	sf::Sprite tableSprite;
+	sf::VertexArray robots;
+	sf::VertexArray markers;
+	sf::VertexArray items;
+	sf::Font font;
+	sf::Text message;
+	sf::Text prompt; // what the keyboard's robot can do, top right
+};
+
+/// <summary>
+/// a free for all being played: the match, the keyboard's choice of move and target, and the pacing of the robots
+/// </summary>
+class FreeForAllTable
+{
+public:
+	FreeForAllTable();
+
+	void start(int t_seats, int t_keyboardSeat); // a new match, t_keyboardSeat -1 gives every robot to the heuristic
+	void update(FastRandom& t_random); // once a tick: new rounds and the robots' moves
+	void moveCursor(int t_step); // through shooting the target, shooting itself and each item held
+	void moveTarget(int t_step); // through the other robots still standing
+	void confirm(); // plays the keyboard's move, or starts another match once this one is over
+	void draw(RenderBackend& t_renderer) { screen.draw(t_renderer); }
+
+	int getSeats() const { return state.seats; }
+
+private:
+	bool isKeyboardTurn() const;
+	int choices(FfaAction* t_choices) const; // the keyboard seat's moves, into t_choices, returns how many
+	void play(int t_seat, FfaAction t_action);
+	void showPrompt();
+
+	FreeForAllScreen screen;
+	FfaMatch state;
+	int keyboardSeat;
+	int cursor; // into choices()
+	int target;
+	int ticksToMove;
+	std::string lastMove; // the message line above the prompt
+};
+
+/// <summary>
+/// entry point for "--ffa-watch [robots] [seed]", a new match starts a few seconds after each one ends
+/// </summary>
+void runFreeForAllWindow(int t_seats, std::uint64_t t_seed);
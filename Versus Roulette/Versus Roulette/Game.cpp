@@ -10,6 +10,10 @@
 
 #include "Globals.h"
 #include "Game.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <iostream>
 #include <stdlib.h>
 #include <time.h>
@@ -22,10 +26,25 @@
 /// load and setup thne image
 /// </summary>
 Game::Game() :
-	m_window{ sf::VideoMode{static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT), 32U }, "SFML Game" },
+	Game(false)
+{
+}
+
+/// <summary>
+/// headless leaves the window closed and the audio off, render() then goes to whatever
+/// backend runRenderBenchmark is given
+/// </summary>
+Game::Game(bool t_headless) :
+	windowRenderer{ m_window },
+	renderer{ &windowRenderer },
+	headless{ t_headless },
 	m_exitGame{ false } //when true game will exit
 {
-	srand(time(NULL)); // randomize seed
+	if (!headless)
+	{
+		m_window.create(sf::VideoMode{ static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT), 32U }, "SFML Game");
+	}
+	matchRandom.seed(static_cast<std::uint64_t>(time(NULL))); // randomize seed
 	setupVariables(); //sets up game logic variables
 	setupFontAndText(); // load font 
 	setupSprite(); // load texture
@@ -35,8 +54,14 @@ Game::Game() :
 	setupItems(); // setup inventory items
 	setupInventory(); // setup inventory screen
 	setupGameOver();
-	setupAudio();
+	particles.setup();
+	if (!headless)
+	{
+		setupAudio();
+	}
 	setupHUD(); // Call the setupHUD function
+	setupScreenTextures();
+	printTextureCacheStats("startup");
 	
 }
 
@@ -50,12 +75,153 @@ Game::~Game()
 
 /// <summary>
 /// main game loop
-/// update 60 times per second,
+/// the simulation runs on its own thread at a fixed 60 updates per second and hands each frame over
+/// as a RenderFrame, this thread only handles the window and draws the newest frame,
+/// so a slow display() can't hold up updates or input
+/// </summary>
+void Game::run()
+{
+	if (!threadedRendering)
+	{
+		runSingleThreaded();
+		return;
+	}
+
+	renderer = &frameCapture;
+	screenTextures.setLock(&textureLock);
+	simulationFinished = false;
+	simulationRunning = true;
+	std::thread simulation(&Game::runSimulation, this);
+
+	while (m_window.isOpen())
+	{
+		sf::Event newEvent;
+		while (m_window.pollEvent(newEvent))
+		{
+			if (sf::Event::Closed != newEvent.type && sf::Event::KeyPressed != newEvent.type)
+			{
+				continue;
+			}
+			if (!inputEvents.push(InputEvent{ newEvent, std::chrono::steady_clock::now() }) && sf::Event::Closed == newEvent.type)
+			{
+				simulationRunning = false; // queue full, close anyway
+			}
+		}
+
+		if (renderFrames.consume())
+		{
+			const RenderFrame& frame = renderFrames.front();
+			{
+				std::lock_guard<std::mutex> locked(textureLock);
+				frame.drawTo(windowRenderer);
+				screenTextures.frameDrawn(frame.screenFrame);
+			}
+			windowRenderer.display();
+			recordLatency(frame.hasInput, frame.inputTime, frame.hasAction, frame.actionTime);
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (simulationFinished)
+		{
+			m_window.close();
+		}
+	}
+
+	simulationRunning = false;
+	simulation.join();
+	screenTextures.setLock(nullptr);
+	renderer = &windowRenderer;
+	printLatency();
+	finishSessionRecording();
+}
+
+/// <summary>
+/// simulation thread: input from the window thread, fixed step updates, and a frame
+/// captured after every batch of updates.
+/// moving a selection only changes what's drawn, so those keys are handled and shown as soon as
+/// they arrive. anything else waits for the next tick, and so does every key behind it, to keep the order
+/// </summary>
+void Game::runSimulation()
+{
+	sf::Clock clock;
+	sf::Time timeSinceLastUpdate = sf::Time::Zero;
+	const sf::Time timePerFrame = sf::seconds(1.0f / 60.0f);
+	const sf::Time pollInterval = sf::seconds(0.001f);
+	std::vector<InputEvent> deferred;
+	deferred.reserve(64);
+	InputEvent input;
+	while (simulationRunning && !m_exitGame)
+	{
+		bool redraw = false;
+		while (inputEvents.pop(input))
+		{
+			if (deferred.empty() && isSelectionKey(input.event))
+			{
+				handleEvent(input.event, input.time);
+				redraw = true;
+			}
+			else
+			{
+				deferred.push_back(input);
+			}
+		}
+
+		timeSinceLastUpdate += clock.restart();
+		while (timeSinceLastUpdate > timePerFrame && !m_exitGame)
+		{
+			timeSinceLastUpdate -= timePerFrame;
+			for (const InputEvent& event : deferred)
+			{
+				handleEvent(event.event, event.time);
+			}
+			deferred.clear();
+			update(timePerFrame);
+			ticks++;
+			redraw = true;
+		}
+
+		if (redraw)
+		{
+			captureFrame();
+		}
+		else
+		{
+			sf::Time untilTick = timePerFrame - timeSinceLastUpdate;
+			std::this_thread::sleep_for(std::chrono::microseconds((untilTick < pollInterval ? untilTick : pollInterval).asMicroseconds()));
+		}
+	}
+	simulationFinished = true;
+}
+
+/// <summary>
+/// render() into the triple buffer's back frame and publish it, with the latency stamps it's first to show
+/// </summary>
+void Game::captureFrame()
+{
+	RenderFrame& frame = renderFrames.back();
+	frameCapture.setTarget(&frame);
+	render();
+	frame.tick = ticks;
+	frame.screenFrame = screenTextures.getFrame();
+	frame.hasInput = hasUnshownInput;
+	frame.inputTime = unshownInputTime;
+	frame.hasAction = hasUnshownAction;
+	frame.actionTime = unshownActionTime;
+	hasUnshownInput = false;
+	hasUnshownAction = false;
+	renderFrames.publish();
+}
+
+/// <summary>
+/// the old loop, update 60 times per second,
 /// process update as often as possible and at least 60 times per second
 /// draw as often as possible but only updates are on time
 /// if updates run slow then don't render frames
 /// </summary>
-void Game::run()
+void Game::runSingleThreaded()
 {
 	sf::Clock clock;
 	sf::Time timeSinceLastUpdate = sf::Time::Zero;
@@ -70,9 +236,20 @@ void Game::run()
 			timeSinceLastUpdate -= timePerFrame;
 			processEvents(); // at least 60 fps
 			update(timePerFrame); //60 fps
+			ticks++;
+		}
+		if (m_exitGame)
+		{
+			m_window.close();
+			break;
 		}
 		render(); // as many as possible
+		recordLatency(hasUnshownInput, unshownInputTime, hasUnshownAction, unshownActionTime);
+		hasUnshownInput = false;
+		hasUnshownAction = false;
 	}
+	printLatency();
+	finishSessionRecording();
 }
 
 /// <summary>
@@ -85,15 +262,49 @@ void Game::processEvents()
 	sf::Event newEvent;
 	while (m_window.pollEvent(newEvent))
 	{
-		if (sf::Event::Closed == newEvent.type) // window message
+		handleEvent(newEvent, std::chrono::steady_clock::now());
+	}
+}
+
+/// <summary>
+/// one window event, from processEvents or the simulation thread's input queue.
+/// t_time is when it came in, the next frame drawn is the one that shows it
+/// </summary>
+void Game::handleEvent(const sf::Event& t_event, std::chrono::steady_clock::time_point t_time)
+{
+	if (sf::Event::Closed == t_event.type) // window message
+	{
+		m_exitGame = true;
+	}
+	if (sf::Event::KeyPressed == t_event.type) //user pressed a key
+	{
+		if (recordingSession)
 		{
-			m_exitGame = true;
+			session.keys.push_back({ static_cast<std::uint32_t>(ticks), static_cast<std::int32_t>(t_event.key.code) });
 		}
-		if (sf::Event::KeyPressed == newEvent.type) //user pressed a key
+		if (!hasUnshownInput)
 		{
-			processKeys(newEvent);
+			hasUnshownInput = true;
+			unshownInputTime = t_time;
 		}
+		handlingInput = true;
+		handlingInputTime = t_time;
+		processKeys(t_event);
+		handlingInput = false;
+	}
+}
+
+/// <summary>
+/// arrow keys only move the highlighted button or slot, nothing in the match changes
+/// </summary>
+bool Game::isSelectionKey(const sf::Event& t_event) const
+{
+	if (sf::Event::KeyPressed != t_event.type)
+	{
+		return false;
 	}
+	sf::Keyboard::Key key = t_event.key.code;
+	return sf::Keyboard::Up == key || sf::Keyboard::Down == key || sf::Keyboard::Left == key || sf::Keyboard::Right == key;
 }
 
 /// <summary>
@@ -109,7 +320,7 @@ void Game::processKeys(sf::Event t_event)
 	if (sf::Keyboard::Up == t_event.key.code)
 	{
 		upArrowPressed = true;
-		m_boop.play();
+		sounds.play(SFX_MENU_BOOP);
 		switch (gameScreen)
 		{
 		case MAIN_MENU:
@@ -125,12 +336,15 @@ void Game::processKeys(sf::Event t_event)
 			break;
 		case GAME_OVER:
 			break;
+		case FREE_FOR_ALL:
+			freeForAll.moveCursor(-1);
+			break;
 		}
 	}
 	if (sf::Keyboard::Down == t_event.key.code)
 	{
 		downArrowPressed = true;
-		m_boop.play();
+		sounds.play(SFX_MENU_BOOP);
 		switch (gameScreen)
 		{
 		case MAIN_MENU:
@@ -146,37 +360,46 @@ void Game::processKeys(sf::Event t_event)
 			break;
 		case GAME_OVER:
 			break;
+		case FREE_FOR_ALL:
+			freeForAll.moveCursor(1);
+			break;
 		}
 	}
 
 	if (sf::Keyboard::Left == t_event.key.code)
 	{
 		leftArrowPressed = true;
-		m_boop.play();
+		sounds.play(SFX_MENU_BOOP);
 		switch (gameScreen)
 		{
 		case INVENTORY:
 			inventorySelect();
 			break;
+		case FREE_FOR_ALL:
+			freeForAll.moveTarget(-1);
+			break;
 		}
 	}
 
 	if (sf::Keyboard::Right == t_event.key.code)
 	{
 		rightArrowPressed = true;
-		m_boop.play();
+		sounds.play(SFX_MENU_BOOP);
 		switch (gameScreen)
 		{
 		case INVENTORY:
 			inventorySelect();
 			break;
+		case FREE_FOR_ALL:
+			freeForAll.moveTarget(1);
+			break;
 		}
 	}
 
 	if (sf::Keyboard::Return == t_event.key.code)
 	{
 		returnKeyPressed = true;
-		m_beep.play();
+		sounds.play(SFX_MENU_BEEP);
 		switch (gameScreen)
 		{
 		case MAIN_MENU:
@@ -192,9 +415,81 @@ void Game::processKeys(sf::Event t_event)
 			break;
 		case GAME_OVER:
 			break;
+		case FREE_FOR_ALL:
+			freeForAll.confirm();
+			break;
 		}
 	}
 
+	// saves, loads and bots would each put the two machines out of step in a network match
+	if (sf::Keyboard::F5 == t_event.key.code && (gameScreen == GAMEPLAY || gameScreen == INVENTORY) && !network.isActive())
+	{
+		quickSave();
+	}
+
+	if (sf::Keyboard::F9 == t_event.key.code && gameScreen != INSTRUCTIONS && gameScreen != FREE_FOR_ALL && !network.isActive())
+	{
+		quickLoad();
+	}
+
+	if (sf::Keyboard::Add == t_event.key.code && network.isActive())
+	{
+		network.setInputDelay(network.getInputDelay() + 1);
+	}
+
+	if (sf::Keyboard::Subtract == t_event.key.code && network.isActive())
+	{
+		network.setInputDelay(std::max(network.getInputDelay() - 1, 0));
+	}
+
+	if (sf::Keyboard::Add == t_event.key.code && gameScreen == FREE_FOR_ALL)
+	{
+		freeForAll.start(freeForAll.getSeats() + 1, 0); // one more robot, from a fresh table
+	}
+
+	if (sf::Keyboard::Subtract == t_event.key.code && gameScreen == FREE_FOR_ALL)
+	{
+		freeForAll.start(freeForAll.getSeats() - 1, 0);
+	}
+
+	if (sf::Keyboard::Num0 == t_event.key.code && network.isActive())
+	{
+		network.setInputDelay(-1); // back to following the ping
+	}
+
+	if (sf::Keyboard::T == t_event.key.code)
+	{
+		screenTextures.report();
+	}
+
+	if (sf::Keyboard::L == t_event.key.code)
+	{
+		latencyReportRequested = true; // the window thread owns the numbers
+	}
+
+	if (sf::Keyboard::P == t_event.key.code && !network.isActive())
+	{
+		timers.setPaused(!timers.isPaused()); // holds the AI and item timers, handy when watching AI vs AI
+	}
+
+	if (sf::Keyboard::F == t_event.key.code && !network.isActive())
+	{
+		timers.setTimeScale(timers.getTimeScale() > 1.0 ? 1.0 : 4.0); // fast-forward
+	}
+
+	if (sf::Keyboard::A == t_event.key.code && gameScreen == MAIN_MENU && !network.isActive())
+	{
+		sounds.play(SFX_MENU_BEEP);
+		startMatch(true); // AI plays both seats
+	}
+
+	if (sf::Keyboard::R == t_event.key.code && gameScreen == MAIN_MENU && !network.isActive())
+	{
+		sounds.play(SFX_MENU_BEEP);
+		freeForAll.start(FFA_MENU_SEATS, 0); // the keyboard plays robot 1
+		gameScreen = FREE_FOR_ALL;
+	}
+
 	if (sf::Keyboard::B == t_event.key.code)
 	{
 		bKeyPressed = true;
@@ -208,6 +503,10 @@ void Game::processKeys(sf::Event t_event)
 			gameScreen = GAMEPLAY;
 			break;
 		case GAME_OVER:
+			gameScreen = MAIN_MENU;
+			leaveNetworkMatch();
+			break;
+		case FREE_FOR_ALL:
 			gameScreen = MAIN_MENU;
 			break;
 			// Add similar cases for other screens as needed.
@@ -226,6 +525,23 @@ void Game::update(sf::Time t_deltaTime)
 	if (gameScreen == MAIN_MENU)
 	{
 		restartGame();
+
+		// waiting on the other machine, the match starts as soon as the seed has been agreed
+		if (network.isActive() && !networkMatchStarted)
+		{
+			network.update();
+			if (network.isConnected())
+			{
+				matchRandom.seed(network.getSeed());
+				localSeat = network.getLocalSeat();
+				startMatch(false);
+				networkMatchStarted = true;
+			}
+			else if (network.isDisconnected())
+			{
+				leaveNetworkMatch();
+			}
+		}
 	}
 	// gameplay screen code
 	else if (gameScreen == GAMEPLAY)
@@ -233,24 +549,18 @@ void Game::update(sf::Time t_deltaTime)
 		displayPlayerHealth.setString("Player Health: " + std::to_string(myPlayer.getHealth()));
 		displayEnemyHealth.setString("Enemy Health: " + std::to_string(myEnemy.getHealth()));
 
-		//new round once taser is out of ammo
-		if (currentLoadedShots == 0)
-		{
-			roundStart = true;
-		}
+		startRoundIfNeeded();
 
-		// Actions if round has just started
-		if (roundStart == true)
-		{
-			//loads taser, gives items and round starts on player's turn
-			loadTaser();
-			giveItems();
-			playerTurn = true;
-			roundStart = false;
-		}
+		timers.update(); // fires anything due this tick, AI turns carry on from here
+		int seatToMove = playerTurn ? PLAYER : ENEMY;
 
 		// Player's turn
-		if (playerTurn == true)
+		if (network.isActive())
+		{
+			currentTurnMessage.setString((seatToMove == localSeat ? "Your Turn " : "Opponent Turn ")
+				+ std::to_string(static_cast<int>(network.getRoundTripMs())) + "ms, delay " + std::to_string(network.getInputDelay()));
+		}
+		else if (playerTurn == true)
 		{
 			currentTurnMessage.setString("Player Turn");
 		}
@@ -258,87 +568,17 @@ void Game::update(sf::Time t_deltaTime)
 		// AI's turn
 		else
 		{
-			// ai runs a timer so it doesn't all just happen in one frame.
-			aiTurnTimer++;
 			currentTurnMessage.setString("Opponent Turn");
-			
-			//USING ITEMS
-			if (aiTurnTimer > 30)
-			{
-				for (int index = 0; index < MAX_ITEMS; index++) //checks for oil drinks and uses them
-				{
-					if (myEnemy.getInventoryArray(index) == OIL_DRINK)
-					{
-						useItem(1, index);
-					}
-				}
-			}
-			if (aiTurnTimer > 60)
-			{
-				for (int index = 0; index < MAX_ITEMS; index++) //checks for rubbish bins and uses them if more live shots than blanks
-				{
-					if (myEnemy.getInventoryArray(index) == RUBBISH_BIN && liveRounds > blankRounds)
-					{
-						useItem(1, index);
-					}
-				}
-			}
-			if (aiTurnTimer > 90)
-			{
-				for (int index = 0; index < MAX_ITEMS; index++) //checks for pause remotes and uses them
-				{
-					if (myEnemy.getInventoryArray(index) == PAUSE_REMOTE)
-					{
-						useItem(1, index);
-					}
-				}
-			}
-			if (aiTurnTimer > 120)
-			{
-				for (int index = 0; index < MAX_ITEMS; index++) //checks for scanners and uses them
-				{
-					if (myEnemy.getInventoryArray(index) == SCANNER)
-					{
-						useItem(1, index);
-					}
-				}
-			}
-			if (aiTurnTimer > 150)
-			{
-				for (int index = 0; index < MAX_ITEMS; index++) //checks for overchargers and uses them if it knows it has a live shot
-				{
-					if (myEnemy.getInventoryArray(index) == OVERCHARGER && knowItsLive == true)
-					{
-						useItem(1, index);
-					}
-				}
-			}
-			if (aiTurnTimer > 180)
-			{
-				if (playerTurn == false) // wont do anything if using rubbish bin caused it to be player turn
-				{
-					if (blankRounds >= liveRounds || knowItsBlank == true) //enemy only shoots itself if it has more or equal blank shots than lives, or it knows its a blank
-					{
-						enemyShootSelf();
-					}
-					if (blankRounds < liveRounds || knowItsLive) // shoots opponent if it knows its current shot is a blank
-					{
-						enemyShootOpponent();
-						if (playerPaused == true) //pause remote item
-						{
-							playerTurn = false;
-							playerPaused = false;
-						}
-						else
-						{
-							playerTurn = true;
-						}
-					}
-					aiTurnTimer = 0;
-					knowItsBlank = false;
-					knowItsLive = false;
-				}
-			}
+		}
+
+		// seats with a policy play themselves, the keyboard drives the rest
+		if (!seatPolicy[seatToMove].isEmpty())
+		{
+			updateAiTurn(seatToMove);
+		}
+		if (network.isActive())
+		{
+			updateNetworkTurn(seatToMove);
 		}
 
 		//playing animations
@@ -357,23 +597,13 @@ void Game::update(sf::Time t_deltaTime)
 		{
 			enemyWon = true;
 			playerWon = false;
-			endTimer++;
-			if (endTimer > endGracePeriod) // couple frames before screen is displayed
-			{
-				gameScreen = GAME_OVER;
-				endTimer = 0;
-			}
+			startGameOverTimer();
 		}
 		else if (myEnemy.getHealth() <= 0) 
 		{
 			playerWon = true;
 			enemyWon = false;
-			endTimer++;
-			if (endTimer > endGracePeriod) // couple frames before screen is displayed
-			{
-				gameScreen = GAME_OVER;
-				endTimer = 0;
-			}
+			startGameOverTimer();
 		}
 
 		checkHealth();
@@ -387,18 +617,19 @@ void Game::update(sf::Time t_deltaTime)
 	//inventory screen code
 	else if (gameScreen == INVENTORY)
 	{
+		startRoundIfNeeded(); // a bin can empty the taser from here, and the other machine reloads straight away
+		timers.update();
+		if (network.isActive())
+		{
+			updateNetworkTurn(playerTurn ? PLAYER : ENEMY); // the other machine doesn't wait for us to close the inventory
+		}
 		inventorySelect();
 
 		displayItemDescription(selectedButtonIndex);
 
-		if (scannerActive == true) //scanner item
+		if (scannerActive == true) //scanner item, scannerTimer turns it off
 		{
 			displayCurrentShot();
-			scannerTimer--;
-			if (scannerTimer <= 0)
-			{
-				scannerActive = false;
-			}
 		}
 	}
 
@@ -406,18 +637,36 @@ void Game::update(sf::Time t_deltaTime)
 	{
 		
 	}
+	else if (gameScreen == FREE_FOR_ALL)
+	{
+		freeForAll.update(matchRandom);
+	}
+
+	if (!headless)
+	{
+		updateMusic();
+	}
 
+	particles.update();
+	spectators.update(spectatorFrame());
+}
+
+/// <summary>
+/// starts and stops the menu and gameplay music to suit the screen
+/// </summary>
+void Game::updateMusic()
+{
 	// Handle music for Main Menu and Instructions
 	if (gameScreen == MAIN_MENU || gameScreen == INSTRUCTIONS)
 	{
 		if (m_menuMusic.getStatus() != sf::Music::Playing)
 		{
-			std::cout << "Starting menu music." << std::endl;
+			LOG_DEBUG("Starting menu music.");
 			m_menuMusic.play();
 		}
 		if (m_gameplayMusic.getStatus() == sf::Music::Playing)
 		{
-			std::cout << "Stopping gameplay music." << std::endl;
+			LOG_DEBUG("Stopping gameplay music.");
 			m_gameplayMusic.stop();
 		}
 	}
@@ -425,12 +674,12 @@ void Game::update(sf::Time t_deltaTime)
 	{
 		if (m_gameplayMusic.getStatus() != sf::Music::Playing)
 		{
-			std::cout << "Starting gameplay music." << std::endl;
+			LOG_DEBUG("Starting gameplay music.");
 			m_gameplayMusic.play();
 		}
 		if (m_menuMusic.getStatus() == sf::Music::Playing)
 		{
-			std::cout << "Stopping menu music." << std::endl;
+			LOG_DEBUG("Stopping menu music.");
 			m_menuMusic.stop();
 		}
 	}
@@ -438,21 +687,15 @@ void Game::update(sf::Time t_deltaTime)
 	{
 		if (m_menuMusic.getStatus() == sf::Music::Playing)
 		{
-			std::cout << "Stopping menu music (other screen)." << std::endl;
+			LOG_DEBUG("Stopping menu music (other screen).");
 			m_menuMusic.stop();
 		}
 		if (m_gameplayMusic.getStatus() == sf::Music::Playing)
 		{
-			std::cout << "Stopping gameplay music (other screen)." << std::endl;
+			LOG_DEBUG("Stopping gameplay music (other screen).");
 			m_gameplayMusic.stop();
 		}
 	}
-
-	if (m_exitGame)
-	{
-		m_window.close();
-	}
-
 }
 
 /// <summary>
@@ -460,16 +703,18 @@ void Game::update(sf::Time t_deltaTime)
 /// </summary>
 void Game::render()
 {
-	m_window.clear(sf::Color::White);
+	useScreenTextures();
+	renderer->clear(sf::Color::White);
 
 	//drawing main menu elements
 	if (gameScreen == MAIN_MENU)
 	{
-		m_window.draw(menuScreenSprite);
-		m_window.draw(startButton);
-		m_window.draw(instructionsButton);
-		m_window.draw(exitButton);
-		m_window.draw(gameLogoSprite);
+		renderer->draw(menuScreenSprite);
+		renderer->draw(startButton);
+		renderer->draw(instructionsButton);
+		renderer->draw(exitButton);
+		renderer->draw(gameLogoSprite);
+		renderer->draw(watchBotsMessage);
 
 		startButton.setSize(sf::Vector2f(256, 128));
 		startButton.setPosition(500, 200);
@@ -486,21 +731,22 @@ void Game::render()
 	//drawing gameplay screen elements
 	else if (gameScreen == GAMEPLAY)
 	{
-		m_window.draw(gameplaySprite);
-		m_window.draw(upperBarSprite);
-		m_window.draw(tableSprite);
-		m_window.draw(playerHealthBarSprite);
-		m_window.draw(enemyHealthBarSprite);
+		renderer->draw(gameplaySprite);
+		renderer->draw(upperBarSprite);
+		renderer->draw(tableSprite);
+		renderer->draw(playerHealthBarSprite);
+		renderer->draw(enemyHealthBarSprite);
 
-		m_window.draw(myPlayer.getBody());
-		m_window.draw(myEnemy.getBody());
+		renderer->draw(myPlayer.getBody());
+		renderer->draw(myEnemy.getBody());
+		particles.draw(*renderer);
 
-		m_window.draw(shootSelfButton);
-		m_window.draw(shootOpponentButton);
-		m_window.draw(inventoryButton);
+		renderer->draw(shootSelfButton);
+		renderer->draw(shootOpponentButton);
+		renderer->draw(inventoryButton);
 
-		m_window.draw(liveTaserSprite);
-		m_window.draw(emptyTaserSprite);
+		renderer->draw(liveTaserSprite);
+		renderer->draw(emptyTaserSprite);
 
 		shootSelfButton.setSize(sf::Vector2f(256, 128));
 		shootSelfButton.setPosition(275, 70);
@@ -511,13 +757,13 @@ void Game::render()
 		inventoryButton.setSize(sf::Vector2f(256, 128));
 		inventoryButton.setPosition(275, 270);
 
-		m_window.draw(taserContentsMessage);
+		renderer->draw(taserContentsMessage);
 
-		m_window.draw(liveRoundsMessage);
-		m_window.draw(blankRoundsMessage);
-		m_window.draw(displayPlayerHealth);
-		m_window.draw(displayEnemyHealth);
-		m_window.draw(currentTurnMessage);
+		renderer->draw(liveRoundsMessage);
+		renderer->draw(blankRoundsMessage);
+		renderer->draw(displayPlayerHealth);
+		renderer->draw(displayEnemyHealth);
+		renderer->draw(currentTurnMessage);
 
 		sf::Vector2f playerItemPositions[MAX_ITEMS] = 
 		{
@@ -535,7 +781,7 @@ void Game::render()
 				sf::Sprite itemSprite = inventoryItemSpriteArray[i];
 				itemSprite.setScale(0.5f, 0.5f); // Scale down by half
 				itemSprite.setPosition(playerItemPositions[i]); 
-				m_window.draw(itemSprite);
+				renderer->draw(itemSprite);
 			}
 		}
 
@@ -555,7 +801,7 @@ void Game::render()
 				sf::Sprite itemSprite = enemyItemSpriteArray[i];
 				itemSprite.setScale(0.5f, 0.5f); // Scale down by half
 				itemSprite.setPosition(enemyItemPositions[i]); // Use predefined position
-				m_window.draw(itemSprite);
+				renderer->draw(itemSprite);
 			}
 		}
 	}
@@ -563,56 +809,61 @@ void Game::render()
 	//drawing instructions screen elements
 	else if (gameScreen == INSTRUCTIONS)
 	{
-		m_window.draw(instructionsSprite);
-		m_window.draw(bButtonText);
+		renderer->draw(instructionsSprite);
+		renderer->draw(bButtonText);
 	}
 
 	//drawing inventory screen elements
 	else if (gameScreen == INVENTORY)
 	{
-		m_window.draw(inventoryScreenSprite);
-		m_window.draw(upperBarSprite);
+		renderer->draw(inventoryScreenSprite);
+		renderer->draw(upperBarSprite);
 
 
-		m_window.draw(taserContentsMessage);
-		m_window.draw(liveRoundsMessage);
-		m_window.draw(blankRoundsMessage);
+		renderer->draw(taserContentsMessage);
+		renderer->draw(liveRoundsMessage);
+		renderer->draw(blankRoundsMessage);
 
-		m_window.draw(slot1);
-		m_window.draw(slot2);
-		m_window.draw(slot3);
-		m_window.draw(slot4);
+		renderer->draw(slot1);
+		renderer->draw(slot2);
+		renderer->draw(slot3);
+		renderer->draw(slot4);
 
 		// Drawing the sprites for inventory box items
 		for (int index = 0; index < MAX_ITEMS; index++)
 		{
-			m_window.draw(inventoryItemSpriteArray[index]);
+			renderer->draw(localSeat == PLAYER ? inventoryItemSpriteArray[index] : enemyItemSpriteArray[index]);
 		}
 
 		// Drawing the sprites for inventory boxes
-		m_window.draw(bButtonText);
-		m_window.draw(liveTaserSprite);
-		m_window.draw(emptyTaserSprite);
+		renderer->draw(bButtonText);
+		renderer->draw(liveTaserSprite);
+		renderer->draw(emptyTaserSprite);
 	}
 
 	else if (gameScreen == GAME_OVER) 
 	{	
-		if (playerWon) 
+		if (localSeat == PLAYER ? playerWon : enemyWon) 
 		{
-			m_window.draw(winSprite);
+			renderer->draw(winSprite);
 		}
-		else if (enemyWon) 
+		else if (playerWon || enemyWon) 
 		{
-			m_window.draw(loseSprite);
+			renderer->draw(loseSprite);
 		}
-		m_window.draw(bButtonText);
+		renderer->draw(bButtonText);
+	}
+
+	else if (gameScreen == FREE_FOR_ALL)
+	{
+		freeForAll.draw(*renderer);
 	}
 
 	if (scannerActive && gameScreen == INVENTORY) // draw sprite of currently scanned shot when on inventory screen
 	{
-		m_window.draw(scannedShotSprite);
+		renderer->draw(scannedShotSprite);
 	}
-	m_window.display();
+	renderer->display();
 }
 
 /// <summary>
@@ -627,6 +878,7 @@ void Game::setupVariables()
 	rightArrowPressed = false;
 	returnKeyPressed = false;
 	iKeyPressed = false;
+	bKeyPressed = false;
 	selectedButtonIndex = 0;
 
 	//game screens
@@ -635,12 +887,17 @@ void Game::setupVariables()
 	//gameplay variables
 	playerTurn = true;
 	roundStart = false;
+	roundNumber = 0;
 
-	playerHealth = 5;
-	enemyHealth = 5;
+	playerHealth = ClassicRules::startingHealth;
+	enemyHealth = ClassicRules::startingHealth;
 
-	currentShot = 0;
+	currentShot = -1; // empty until the first round loads it
 	currentLoadedShots = 0;
+	for (int index = 0; index < MAX_SHOTS; index++)
+	{
+		taserArray[index] = 0; // the checksums read the whole taser, loaded or not
+	}
 
 	liveRounds = 0;
 	blankRounds = 0;
@@ -652,10 +909,22 @@ void Game::setupVariables()
 
 	doubleDamage = false;
 	scannerActive = false;
-	scannerTimer = 0;
+	scannerTimer = TimerWheel::NO_TIMER;
 	enemyPaused = false;
+	playerPaused = false;
+	knowItsBlank = false;
+	knowItsLive = false;
+
+	endTimer = TimerWheel::NO_TIMER;
+
+	localSeat = PLAYER;
+	networkMatchStarted = false;
+	networkActions = 0;
+	hasPendingAction = false;
+	pendingAction = shootOpponentAction();
+	pendingActionTimer = TimerWheel::NO_TIMER;
 
-	endTimer = 0;
+	seatPolicy[ENEMY] = HeuristicPolicy();
 }
 
 /// <summary>
@@ -665,7 +934,7 @@ void Game::setupFontAndText()
 {
 	if (!m_ArialBlackfont.loadFromFile("ASSETS\\FONTS\\ariblk.ttf"))
 	{
-		std::cout << "problem loading arial black font" << std::endl;
+		LOG_ERROR("problem loading arial black font");
 	}
 
 	//current turn text
@@ -708,6 +977,14 @@ void Game::setupFontAndText()
 	bButtonText.setStyle(sf::Text::Italic | sf::Text::Bold);
 	bButtonText.setFillColor(sf::Color::Black);
 	bButtonText.setPosition(10.0f, 560.0f);
+
+	//AI vs AI hint on main menu
+	watchBotsMessage.setFont(m_ArialBlackfont);
+	watchBotsMessage.setString("Press A to watch AI vs AI, R for a free for all");
+	watchBotsMessage.setCharacterSize(20U);
+	watchBotsMessage.setStyle(sf::Text::Italic | sf::Text::Bold);
+	watchBotsMessage.setFillColor(sf::Color::White);
+	watchBotsMessage.setPosition(10.0f, 560.0f);
 }
 
 
@@ -716,12 +993,8 @@ void Game::setupFontAndText()
 /// </summary>
 void Game::setupSprite()
 {
-	if (!gameLogoTexture.loadFromFile("ASSETS\\IMAGES\\versusRouletteLogo.png"))
-	{
-		std::cout << "Failed to load game logo image!" << std::endl;
-	}
-
-	gameLogoSprite.setTexture(gameLogoTexture);
+	screenTextures.add(gameLogoTexture, "ASSETS\\IMAGES\\versusRouletteLogo.png", ScreenTextures::screenBit(MAIN_MENU));
+	screenTextures.attach(gameLogoTexture, gameLogoSprite);
 }
 
 /// <summary>
@@ -729,15 +1002,12 @@ void Game::setupSprite()
 /// </summary>
 void Game::setupMenu()
 {
-	if (!menuScreenTexture.loadFromFile("ASSETS\\IMAGES\\main screen.png"))
-	{
-		std::cout << "Failed to menu screen image!" << std::endl;
-	}
-	menuScreenSprite.setTexture(menuScreenTexture);
+	screenTextures.add(menuScreenTexture, "ASSETS\\IMAGES\\main screen.png", ScreenTextures::screenBit(MAIN_MENU));
+	screenTextures.attach(menuScreenTexture, menuScreenSprite);
 
-	if (!buttonsTexture.loadFromFile("ASSETS\\IMAGES\\Button-Sheet.png"))
+	if (!loadTextureCached(buttonsTexture, "ASSETS\\IMAGES\\Button-Sheet.png"))
 	{
-		std::cout << "Failed to load button image!" << std::endl;
+		LOG_ERROR("Failed to load button image!");
 	}
 
 	sf::IntRect playButtonRect(1408, 0, 128, 64);
@@ -756,11 +1026,8 @@ void Game::setupMenu()
 
 void Game::setupInstructions()
 {
-	if (!instructionsTexture.loadFromFile("ASSETS\\IMAGES\\instructions screen.png"))
-	{
-		std::cout << "Failed to load instructions screen!" << std::endl;
-	}
-	instructionsSprite.setTexture(instructionsTexture);
+	screenTextures.add(instructionsTexture, "ASSETS\\IMAGES\\instructions screen.png", ScreenTextures::screenBit(INSTRUCTIONS));
+	screenTextures.attach(instructionsTexture, instructionsSprite);
 }
 
 /// <summary>
@@ -768,16 +1035,8 @@ void Game::setupInstructions()
 /// </summary>
 void Game::setupGameplay()
 {
-	if (!gameplayTexture.loadFromFile("ASSETS\\IMAGES\\gameplay screen.png"))
-	{
-		std::cout << "Failed to gameplay screen image!" << std::endl;
-	}
-	gameplaySprite.setTexture(gameplayTexture);
-
-	if (!buttonsTexture.loadFromFile("ASSETS\\IMAGES\\Button-Sheet.png"))
-	{
-		std::cout << "Failed to load button image!" << std::endl;
-	}
+	screenTextures.add(gameplayTexture, "ASSETS\\IMAGES\\gameplay screen.png", ScreenTextures::screenBit(GAMEPLAY));
+	screenTextures.attach(gameplayTexture, gameplaySprite);
 
 	sf::IntRect shootSelfButtonRect(1920, 0, 128, 64);
 	sf::IntRect shootOpponentButtonRect(1536, 0, 128, 64);
@@ -805,19 +1064,14 @@ void Game::setupInventory()
 		myEnemy.setInventoryArray(index, 0);
 	}
 
-	if (!inventoryButtonTexture.loadFromFile("ASSETS\\IMAGES\\Item-Sheet.png"))
-	{
-		std::cout << "Error loading inventory buttons";
-	}
-
 	sf::IntRect OilDrinkButtonRect(0, 0, 64, 64);
 	sf::IntRect PauseRemoteButtonRect(256, 0, 64, 64);
 	sf::IntRect BatteryButtonRect(384, 0, 64, 64);
 	sf::IntRect TaserButtonRect(128, 0, 64, 64);
 
-	if (!slotTexture.loadFromFile("ASSETS\\IMAGES\\slots.png"))
+	if (!loadTextureCached(slotTexture, "ASSETS\\IMAGES\\slots.png"))
 	{
-		std::cout << "Error loading inventory slots";
+		LOG_ERROR("Error loading inventory slots");
 	}
 
 	sf::IntRect firstItemSlot(0, 0, 64, 64); // displays item in first slot
@@ -849,11 +1103,8 @@ void Game::setupInventory()
 	slot4.setPosition(620.0f, 360.0f);
 	slot4.setScale(1.5f, 1.5f);
 
-	if (!inventoryScreenTexture.loadFromFile("ASSETS\\IMAGES\\inventory screen.png"))
-	{
-		std::cout << "Error loading inventory screen";
-	}
-	inventoryScreenSprite.setTexture(inventoryScreenTexture);
+	screenTextures.add(inventoryScreenTexture, "ASSETS\\IMAGES\\inventory screen.png", ScreenTextures::screenBit(INVENTORY));
+	screenTextures.attach(inventoryScreenTexture, inventoryScreenSprite);
 
 }
 
@@ -874,12 +1125,6 @@ void Game::menuSelect()
 		downArrowPressed = false;
 	}
 
-	// Load button texture
-	if (!buttonsTexture.loadFromFile("ASSETS\\IMAGES\\Button-Sheet.png"))
-	{
-		std::cout << "Failed to load button image!" << std::endl;
-	}
-
 	// Initialize button rectangles
 	sf::IntRect originalPlayButtonRect(1280, 0, 128, 64);
 	sf::IntRect originalInstructionsButtonRect(512, 0, 128, 64);
@@ -937,8 +1182,10 @@ void Game::menuSelect()
 		switch (selectedButtonIndex)
 		{
 		case 0: // the play button
-			gameScreen = GAMEPLAY;  // will begin gameplay
-			roundStart = true;
+			if (!network.isActive()) // a network match starts itself once the other machine is there
+			{
+				startMatch(false); // will begin gameplay
+			}
 			break;
 		case 1: // the instructions button
 			gameScreen = INSTRUCTIONS;// will display image for instructions
@@ -969,11 +1216,6 @@ void Game::gameplaySelect()
 		downArrowPressed = false;
 	}
 
-	if (!buttonsTexture.loadFromFile("ASSETS\\IMAGES\\Button-Sheet.png"))
-	{
-		std::cout << "Failed to load button image!" << std::endl;
-	}
-
 	// Initialize button rectangles
 	sf::IntRect originalShootSelfButtonRect(1792, 0, 128, 64);
 	sf::IntRect originalShootOpponentButtonRect(1536, 0, 128, 64);
@@ -1025,24 +1267,21 @@ void Game::gameplaySelect()
 	}
 
 	// player selects one of their gameplay options, makes sure it's the player's turn
-	if (returnKeyPressed && playerTurn == true)
+	if (returnKeyPressed && (playerTurn ? PLAYER : ENEMY) == localSeat)
 	{
 		switch (selectedButtonIndex)
 		{
 		case 0: // the shoot self button
-			shootSelf();
-			break;
-		case 1: // the shoot opponent button
-			shootOpponent();
-			if (enemyPaused == true) //pause remote
+			if (seatPolicy[localSeat].isEmpty())
 			{
-				enemyPaused = false;
+				submitLocalAction(shootSelfAction());
 			}
-			else
+			break;
+		case 1: // the shoot opponent button
+			if (seatPolicy[localSeat].isEmpty())
 			{
-				playerTurn = false; // ends player turn
+				submitLocalAction(shootOpponentAction());
 			}
-			
 			break;
 		case 2: // the inventory button
 			gameScreen = INVENTORY;
@@ -1112,30 +1351,30 @@ void Game::inventorySelect()
 	slot3.setTextureRect(selectedButtonIndex == 2 ? sf::IntRect(0, 0, 64, 64) : sf::IntRect(65, 0, 64, 64));
 	slot4.setTextureRect(selectedButtonIndex == 3 ? sf::IntRect(0, 0, 64, 64) : sf::IntRect(65, 0, 64, 64));
 
-	// Handle action when return key is pressed
-	if (returnKeyPressed) 
+	// Handle action when return key is pressed, the AI uses the items when it controls the player
+	if (returnKeyPressed && seatPolicy[localSeat].isEmpty()) 
 	{
 		switch (selectedButtonIndex) 
 		{
 		case 0:
 			// Handle action for first item slot
-			useItem(0, 0);
+			submitLocalAction(useItemAction(0));
 			break;
 		case 1:
 			// Handle action for second item slot
-			useItem(0, 1);
+			submitLocalAction(useItemAction(1));
 			break;
 		case 2:
 			// Handle action for third item slot
-			useItem(0, 2);
+			submitLocalAction(useItemAction(2));
 			break;
 		case 3:
 			// Handle action for fourth item slot
-			useItem(0, 3);
+			submitLocalAction(useItemAction(3));
 			break;
 		}
-		returnKeyPressed = false;
 	}
+	returnKeyPressed = false;
 
 	if (bKeyPressed == true)
 	{
@@ -1156,8 +1395,9 @@ void Game::shootSelf()
 		liveRounds--;
 		liveRoundsMessage.setString(std::to_string(liveRounds));
 		myPlayer.setAnimationPlaying(true, SHOOT_SELF_LIVE);
-		robotDamageTakenSound.play();
-		zapSound.play();
+		sounds.play(SFX_ROBOT_OUCH);
+		sounds.play(SFX_ZAP);
+		emitHitEffects(PLAYER, PLAYER, doubleDamage ? 2 : 1);
 
 		if (doubleDamage == true) //overcharger item
 		{
@@ -1180,11 +1420,13 @@ void Game::shootSelf()
 		blankRounds--;
 		blankRoundsMessage.setString(std::to_string(blankRounds));
 		myPlayer.setAnimationPlaying(true, SHOOT_SELF_BLANK);
-		blankSound.play();
+		sounds.play(SFX_BLANK);
 	}
 	currentLoadedShots--;
 	currentShot--;
 	doubleDamage = false;
+	knowItsBlank = false;
+	knowItsLive = false;
 }
 
 /// <summary>
@@ -1199,8 +1441,9 @@ void Game::shootOpponent()
 		liveRoundsMessage.setString(std::to_string(liveRounds));
 		myPlayer.setAnimationPlaying(true, SHOOT_OPPONENT_LIVE);
 		myEnemy.setAnimationPlaying(true, GETTING_HIT);
-		robotDamageTakenSound.play();
-		zapSound.play();
+		sounds.play(SFX_ROBOT_OUCH);
+		sounds.play(SFX_ZAP);
+		emitHitEffects(PLAYER, ENEMY, doubleDamage ? 2 : 1);
 
 		if (doubleDamage == true) //overcharger item
 		{
@@ -1212,12 +1455,14 @@ void Game::shootOpponent()
 		blankRounds--;
 		blankRoundsMessage.setString(std::to_string(blankRounds));
 		myPlayer.setAnimationPlaying(true, SHOOT_OPPONENT_BLANK);
-		blankSound.play();
+		sounds.play(SFX_BLANK);
 	}
 
 	currentLoadedShots--;
 	currentShot--;
 	doubleDamage = false;
+	knowItsBlank = false;
+	knowItsLive = false;
 }
 
 /// <summary>
@@ -1239,8 +1484,9 @@ void Game::enemyShootSelf()
 		{
 			playerTurn = true;
 		}
-		robotDamageTakenSound.play();
-		zapSound.play();
+		sounds.play(SFX_ROBOT_OUCH);
+		sounds.play(SFX_ZAP);
+		emitHitEffects(ENEMY, ENEMY, doubleDamage ? 2 : 1);
 
 		if (doubleDamage == true) //overcharger item
 		{
@@ -1253,11 +1499,13 @@ void Game::enemyShootSelf()
 		blankRoundsMessage.setString(std::to_string(blankRounds));
 		myEnemy.setAnimationPlaying(true, SHOOT_SELF_BLANK);
 		playerTurn = false;
-		blankSound.play();
+		sounds.play(SFX_BLANK);
 	}
 	currentLoadedShots--;
 	currentShot--;
 	doubleDamage = false;
+	knowItsBlank = false;
+	knowItsLive = false;
 }
 
 /// <summary>
@@ -1273,8 +1521,9 @@ void Game::enemyShootOpponent()
 		playerTurn = true;
 		myEnemy.setAnimationPlaying(true, SHOOT_OPPONENT_LIVE);
 		myPlayer.setAnimationPlaying(true, GETTING_HIT);
-		robotDamageTakenSound.play();
-		zapSound.play();
+		sounds.play(SFX_ROBOT_OUCH);
+		sounds.play(SFX_ZAP);
+		emitHitEffects(ENEMY, PLAYER, doubleDamage ? 2 : 1);
 
 		if (doubleDamage == true) 	//overcharger item
 		{
@@ -1287,12 +1536,50 @@ void Game::enemyShootOpponent()
 		blankRoundsMessage.setString(std::to_string(blankRounds));
 		playerTurn = true;
 		myEnemy.setAnimationPlaying(true, SHOOT_OPPONENT_BLANK);
-		blankSound.play();
+		sounds.play(SFX_BLANK);
 	}
 	currentLoadedShots--;
 	currentShot--;
 
 	doubleDamage = false;
+	knowItsBlank = false;
+	knowItsLive = false;
+}
+
+/// <summary>
+/// a live shot: the arc from the shooter's taser, sparks where it lands and charge draining off the battery
+/// </summary>
+void Game::emitHitEffects(int t_shooter, int t_target, int t_damage)
+{
+	const sf::Vector2f tip = t_shooter == PLAYER ? PLAYER_TASER_TIP : ENEMY_TASER_TIP;
+	const sf::Vector2f chest = t_target == PLAYER ? PLAYER_CHEST : ENEMY_CHEST;
+	particles.emitTaserArc(tip, chest);
+	particles.emitSparks(chest, 400 * t_damage);
+	particles.emitBatteryDrain(t_target == PLAYER ? PLAYER_BATTERY_CENTRE : ENEMY_BATTERY_CENTRE, t_damage);
+}
+
+/// <summary>
+/// starts the next round once the taser is out of ammo, before anyone can act on the empty one
+/// </summary>
+void Game::startRoundIfNeeded()
+{
+	//new round once taser is out of ammo
+	if (currentLoadedShots == 0)
+	{
+		roundStart = true;
+	}
+
+	// Actions if round has just started
+	if (roundStart == true)
+	{
+		//loads taser, gives items and round starts on player's turn
+		loadTaser();
+		giveItems();
+		playerTurn = true;
+		roundStart = false;
+		aiTurn = TurnScript();
+		roundNumber++;
+	}
 }
 
 /// <summary>
@@ -1306,9 +1593,9 @@ void Game::loadTaser()
 	blankRounds = 0;
 	liveRounds = 0;
 
-	for (int index = 0; index < 6; index++)
+	for (int index = 0; index < MAX_SHOTS; index++)
 	{
-		int numberGen = (rand() % 2); //randomly generates number 0-1
+		int numberGen = matchRandom.nextInt(2); //randomly generates number 0-1
 		taserArray[index] = numberGen; //loads random blank or live into taser
 
 		if (numberGen == 0) // loaded blank
@@ -1324,8 +1611,8 @@ void Game::loadTaser()
 			liveLoaded = true;
 		}
 
-		currentLoadedShots = 6; //there are 6 shots in the taser
-		currentShot = 5; //current shot is 6th shot (goes 5,4,3,2,1,0)
+		currentLoadedShots = MAX_SHOTS; //there are 6 shots in the taser
+		currentShot = MAX_SHOTS - 1; //current shot is 6th shot (goes 5,4,3,2,1,0)
 	}
 
 	// checking if gun was loaded with at least one live and one blank shot within, reloads the code if not
@@ -1342,11 +1629,11 @@ void Game::giveItems()
 {
 	//giving player items
 	itemsGiven = 0;
-	for (int index = 0; index < 4; index++)
+	for (int index = 0; index < MAX_ITEMS; index++)
 	{
-		int numberGen = (rand() % 5 + 1); //randomly generates number 1-5
+		int numberGen = ClassicRules::drawItem(matchRandom); //randomly generates number 1-5
 
-		if (myPlayer.getInventoryArray(index) == 0 && itemsGiven < 2) //slot not currently being used and two items not been given yet
+		if (myPlayer.getInventoryArray(index) == 0 && itemsGiven < ClassicRules::itemsPerRound) //slot not currently being used and two items not been given yet
 		{
 			myPlayer.setInventoryArray(index, numberGen);
 			itemsGiven++;
@@ -1374,11 +1661,11 @@ void Game::giveItems()
 
 	//giving enemy items
 	itemsGiven = 0;
-	for (int index = 0; index < 4; index++)
+	for (int index = 0; index < MAX_ITEMS; index++)
 	{
-		int numberGen = (rand() % 5 + 1); //randomly generates number 1-5
+		int numberGen = ClassicRules::drawItem(matchRandom); //randomly generates number 1-5
 
-		if (myEnemy.getInventoryArray(index) == 0 && itemsGiven < 2) //slot not currently being used and two items not been given yet
+		if (myEnemy.getInventoryArray(index) == 0 && itemsGiven < ClassicRules::itemsPerRound) //slot not currently being used and two items not been given yet
 		{
 			myEnemy.setInventoryArray(index, numberGen);
 			itemsGiven++;
@@ -1420,24 +1707,25 @@ void Game::useItem(int t_user, int t_slot)
 		switch (itemToUse)
 		{
 		case OIL_DRINK:
-			oilDrinkSound.play();
+			sounds.play(SFX_OIL_DRINK);
 			myPlayer.setHealth(1);
 			break;
 		case SCANNER:
-			scannerSound.play();
-			scannerActive = true;
-			scannerTimer = 100;
+			sounds.play(SFX_SCANNER);
+			showScannedShot();
+			knowItsLive = taserArray[currentShot] == 1; // lets an AI controlled player act on the scan
+			knowItsBlank = !knowItsLive;
 			break;
 		case PAUSE_REMOTE:
-			pauseRemoteSound.play();
+			sounds.play(SFX_PAUSE_REMOTE);
 			enemyPaused = true;
 			break;
 		case OVERCHARGER:
-			overchargerSound.play();
+			sounds.play(SFX_OVERCHARGER);
 			doubleDamage = true;
 			break;
 		case RUBBISH_BIN:
-			rubbishBinSound.play();
+			sounds.play(SFX_RUBBISH_BIN);
 			if (taserArray[currentShot] == 1) // live shot discarded
 			{
 				liveRounds--;
@@ -1450,6 +1738,8 @@ void Game::useItem(int t_user, int t_slot)
 			}
 			currentLoadedShots--;
 			currentShot--;
+			knowItsBlank = false;
+			knowItsLive = false;
 			break;
 		}
 	}
@@ -1463,11 +1753,15 @@ void Game::useItem(int t_user, int t_slot)
 		switch (itemToUse)
 		{
 		case OIL_DRINK:
-			oilDrinkSound.play();
+			sounds.play(SFX_OIL_DRINK);
 			myEnemy.setHealth(1);
 			break;
 		case SCANNER:
-			scannerSound.play();
+			sounds.play(SFX_SCANNER);
+			if (localSeat == ENEMY) // the person playing this seat over the network gets to see it too
+			{
+				showScannedShot();
+			}
 			if (taserArray[currentShot] == 1)
 			{
 				knowItsLive = true;
@@ -1476,19 +1770,19 @@ void Game::useItem(int t_user, int t_slot)
 			else
 			{
 				knowItsBlank = true;
-				knowItsBlank = false;
+				knowItsLive = false;
 			}
 			break;
 		case PAUSE_REMOTE:
-			pauseRemoteSound.play();
+			sounds.play(SFX_PAUSE_REMOTE);
 			playerPaused = true;
 			break;
 		case OVERCHARGER:
-				overchargerSound.play();
+				sounds.play(SFX_OVERCHARGER);
 			doubleDamage = true;
 			break;
 		case RUBBISH_BIN:
-			rubbishBinSound.play();
+			sounds.play(SFX_RUBBISH_BIN);
 			if (taserArray[currentShot] == 1) // live shot discarded
 			{
 				liveRounds--;
@@ -1501,6 +1795,8 @@ void Game::useItem(int t_user, int t_slot)
 			}
 			currentLoadedShots--;
 			currentShot--;
+			knowItsBlank = false;
+			knowItsLive = false;
 			break;
 		}
 	}
@@ -1513,7 +1809,11 @@ void Game::displayCurrentShot()
 {
 	scannedShotSprite.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
 	scannedShotSprite.setScale(2, 2);
-	if (taserArray[currentShot] == 1)
+	if (currentShot < 0)
+	{
+		scannedShotSprite.setTexture(emptyTaserTexture); // scanned shot was binned as the last one
+	}
+	else if (taserArray[currentShot] == 1)
 	{
 		scannedShotSprite.setTexture(liveTaserTexture);
 	}
@@ -1529,31 +1829,23 @@ void Game::displayCurrentShot()
 /// </summary>
 void Game::setupAudio()
 {
-	if (!robotDamageTakenBuffer.loadFromFile("ASSETS\\AUDIO\\robotOuch.wav"))
-	{
-		std::cout << "robot damage taken audio not loading" << std::endl;
-	}
-	robotDamageTakenSound.setBuffer(robotDamageTakenBuffer);
-	robotDamageTakenSound.setVolume(40);
-
-	if (!zapBuffer.loadFromFile("ASSETS\\AUDIO\\zap.wav"))
-	{
-		std::cout << "zap audio not loading" << std::endl;
-	}
-	zapSound.setBuffer(zapBuffer);
-	zapSound.setVolume(20);
-
-	if (!blankBuffer.loadFromFile("ASSETS\\AUDIO\\blank.wav"))
-	{
-		std::cout << "blank round audio not loading" << std::endl;
-	}
-	blankSound.setBuffer(blankBuffer); 
-	blankSound.setVolume(50);
+	// gameplay hits outrank item sounds, which outrank menu beeps when voices run out
+	sounds.loadEffect(SFX_ROBOT_OUCH, "ASSETS\\AUDIO\\robotOuch.wav", 40, 2, 2);
+	sounds.loadEffect(SFX_ZAP, "ASSETS\\AUDIO\\zap.wav", 20, 2, 2);
+	sounds.loadEffect(SFX_BLANK, "ASSETS\\AUDIO\\blank.wav", 50, 2, 2);
+	sounds.loadEffect(SFX_OIL_DRINK, "ASSETS\\AUDIO\\oilDrink.wav", 50, 1, 2);
+	sounds.loadEffect(SFX_SCANNER, "ASSETS\\AUDIO\\scan.wav", 50, 1, 2);
+	sounds.loadEffect(SFX_PAUSE_REMOTE, "ASSETS\\AUDIO\\pauseRemote.wav", 50, 1, 2);
+	sounds.loadEffect(SFX_OVERCHARGER, "ASSETS\\AUDIO\\battery.wav", 50, 1, 2);
+	sounds.loadEffect(SFX_RUBBISH_BIN, "ASSETS\\AUDIO\\rubbishBin.wav", 50, 1, 2);
+	sounds.loadEffect(SFX_MENU_BOOP, "ASSETS\\AUDIO\\MenuChoose.wav", 10, 0, 2);
+	sounds.loadEffect(SFX_MENU_BEEP, "ASSETS\\AUDIO\\MenuSelect.wav", 10, 0, 2);
+	sounds.start();
 
 	// Loading and setting up menu music
 	if (!m_menuMusicLoad.loadFromFile("ASSETS\\AUDIO\\Black Soul.wav"))
 	{
-		std::cout << "Menu music not loading" << std::endl;
+		LOG_ERROR("Menu music not loading");
 	}
 	else
 	{
@@ -1565,7 +1857,7 @@ void Game::setupAudio()
 	// Loading and setting up gameplay music
 	if (!m_gameplayMusicLoad.loadFromFile("ASSETS\\AUDIO\\CertifiedBanger.wav"))
 	{
-		std::cout << "Gameplay music not loading" << std::endl;
+		LOG_ERROR("Gameplay music not loading");
 	}
 	else
 	{
@@ -1573,66 +1865,6 @@ void Game::setupAudio()
 		m_gameplayMusic.setLoop(true);
 		m_gameplayMusic.setVolume(10);
 	}
-
-	if (!m_menuChoose.loadFromFile("ASSETS\\AUDIO\\MenuChoose.wav"))
-	{
-		std::cout << "Menu choose sound not loading" << std::endl;
-	}
-	else
-	{
-		m_boop.setBuffer(m_menuChoose);
-		m_boop.setVolume(10);
-	}
-
-	if (!m_menuSelect.loadFromFile("ASSETS\\AUDIO\\MenuSelect.wav"))
-	{
-		std::cout << "Menu choose sound not loading" << std::endl;
-	}
-	else
-	{
-		m_beep.setBuffer(m_menuSelect);
-		m_beep.setVolume(10);
-	}
-	if (!oilDrinkBuffer.loadFromFile("ASSETS\\AUDIO\\oilDrink.wav")) {
-		std::cout << "Failed to load oil drink sound." << std::endl;
-	}
-	else {
-		oilDrinkSound.setBuffer(oilDrinkBuffer);
-		oilDrinkSound.setVolume(50);
-	}
-
-	if (!scannerBuffer.loadFromFile("ASSETS\\AUDIO\\scan.wav")) {
-		std::cout << "Failed to load scanner sound." << std::endl;
-	}
-	else {
-		scannerSound.setBuffer(scannerBuffer);
-		scannerSound.setVolume(50);
-	}
-
-	if (!pauseRemoteBuffer.loadFromFile("ASSETS\\AUDIO\\pauseRemote.wav")) {
-		std::cout << "Failed to load pause remote sound." << std::endl;
-	}
-	else {
-		pauseRemoteSound.setBuffer(pauseRemoteBuffer);
-		pauseRemoteSound.setVolume(50);
-	}
-
-	if (!overchargerBuffer.loadFromFile("ASSETS\\AUDIO\\battery.wav")) {
-		std::cout << "Failed to load overcharger sound." << std::endl;
-	}
-	else {
-		overchargerSound.setBuffer(overchargerBuffer);
-		overchargerSound.setVolume(50);
-	}
-
-	if (!rubbishBinBuffer.loadFromFile("ASSETS\\AUDIO\\rubbishBin.wav")) {
-		std::cout << "Failed to load rubbish bin sound." << std::endl;
-	}
-	else {
-		rubbishBinSound.setBuffer(rubbishBinBuffer);
-		rubbishBinSound.setVolume(50);
-	}
-
 }
 
 /// <summary>
@@ -1640,48 +1872,48 @@ void Game::setupAudio()
 /// </summary>
 void Game::setupHUD()
 {
-	if (!upperBarTexture.loadFromFile("ASSETS\\IMAGES\\upperBar.png"))
+	if (!loadTextureCached(upperBarTexture, "ASSETS\\IMAGES\\upperBar.png"))
 	{
-		std::cout << "Failed to load upper bar image!" << std::endl;
+		LOG_ERROR("Failed to load upper bar image!");
 	}
 	upperBarSprite.setTexture(upperBarTexture);
 	upperBarSprite.setPosition(0, 0);
 
-	if (!tableTexture.loadFromFile("ASSETS\\IMAGES\\table.png"))
+	if (!loadTextureCached(tableTexture, "ASSETS\\IMAGES\\table.png"))
 	{
-		std::cout << "Failed to load table image!" << std::endl;
+		LOG_ERROR("Failed to load table image!");
 	}
 	tableSprite.setTexture(tableTexture);
 	tableSprite.setPosition(0, 50);
 
-	if (!playerHealthBarTexture.loadFromFile("ASSETS\\IMAGES\\playerHealth.png"))
+	if (!loadTextureCached(playerHealthBarTexture, "ASSETS\\IMAGES\\playerHealth.png"))
 	{
-		std::cout << "Failed to load player health bar image!" << std::endl;
+		LOG_ERROR("Failed to load player health bar image!");
 	}
 	playerHealthBarSprite.setTexture(playerHealthBarTexture);
 	playerHealthBarSprite.setTextureRect(PLAYER_BATTERY_5_RECT);
 	playerHealthBarSprite.setPosition(150, 250);
 	playerHealthBarSprite.setScale(-1, 1);
 
-	if (!enemyHealthBarTexture.loadFromFile("ASSETS\\IMAGES\\enemyHealth.png"))
+	if (!loadTextureCached(enemyHealthBarTexture, "ASSETS\\IMAGES\\enemyHealth.png"))
 	{
-		std::cout << "Failed to load upper bar image!" << std::endl;
+		LOG_ERROR("Failed to load upper bar image!");
 	}
 	enemyHealthBarSprite.setTexture(enemyHealthBarTexture);
 	enemyHealthBarSprite.setTextureRect(ENEMY_BATTERY_5_RECT);
 	enemyHealthBarSprite.setPosition(720, 250);
 	enemyHealthBarSprite.setScale(-1, 1);
 
-	if (!liveTaserTexture.loadFromFile("ASSETS\\IMAGES\\liveTaserCharge.png"))
+	if (!loadTextureCached(liveTaserTexture, "ASSETS\\IMAGES\\liveTaserCharge.png"))
 	{
-		std::cout << "Failed to load upper bar image!" << std::endl;
+		LOG_ERROR("Failed to load upper bar image!");
 	}
 	liveTaserSprite.setTexture(liveTaserTexture);
 	liveTaserSprite.setPosition(500, 0);
 
-	if (!emptyTaserTexture.loadFromFile("ASSETS\\IMAGES\\emptyTaserCharge.png"))
+	if (!loadTextureCached(emptyTaserTexture, "ASSETS\\IMAGES\\emptyTaserCharge.png"))
 	{
-		std::cout << "Failed to load upper bar image!" << std::endl;
+		LOG_ERROR("Failed to load upper bar image!");
 	}
 	emptyTaserSprite.setTexture(emptyTaserTexture);
 	emptyTaserSprite.setPosition(630, 0);
@@ -1744,9 +1976,9 @@ void Game::checkHealth()
 /// </summary>
 void Game::setupItems()
 {
-	if (!itemSheetTexture.loadFromFile("ASSETS\\IMAGES\\Item-Sheet.png"))
+	if (!loadTextureCached(itemSheetTexture, "ASSETS\\IMAGES\\Item-Sheet.png"))
 	{
-		std::cout << "Failed to load item sheet image!" << std::endl;
+		LOG_ERROR("Failed to load item sheet image!");
 	}
 
 	// Inventory box sprites
@@ -1783,7 +2015,7 @@ void Game::setupItems()
 /// <param name="t_slot"></param>
 void Game::displayItemDescription(int t_slot)
 {
-	int backgroundToDisplay = myPlayer.getInventoryArray(t_slot);
+	int backgroundToDisplay = localSeat == PLAYER ? myPlayer.getInventoryArray(t_slot) : myEnemy.getInventoryArray(t_slot);
 
 	switch (backgroundToDisplay)
 	{
@@ -1812,25 +2044,11 @@ void Game::displayItemDescription(int t_slot)
 /// sets up game over screen
 /// </summary>
 void Game::setupGameOver() {
-	// Load the win image
-	if (!winTexture.loadFromFile("ASSETS\\IMAGES\\youWin.png")) {
-		std::cerr << "Failed to load win image!" << std::endl;
-	}
-	else {
-		winSprite.setTexture(winTexture);
-		winSprite.setPosition((m_window.getSize().x - winSprite.getLocalBounds().width) / 2,
-			(m_window.getSize().y - winSprite.getLocalBounds().height) / 2);
-	}
-
-	// Load the lose image
-	if (!loseTexture.loadFromFile("ASSETS\\IMAGES\\gameOver.png")) {
-		std::cerr << "Failed to load lose image!" << std::endl;
-	}
-	else {
-		loseSprite.setTexture(loseTexture);	
-		loseSprite.setPosition((m_window.getSize().x - loseSprite.getLocalBounds().width) / 2,
-			(m_window.getSize().y - loseSprite.getLocalBounds().height) / 2);
-	}
+	// win and lose images are loaded with the game over screen, useScreenTextures centres them
+	screenTextures.add(winTexture, "ASSETS\\IMAGES\\youWin.png", ScreenTextures::screenBit(GAME_OVER));
+	screenTextures.attach(winTexture, winSprite);
+	screenTextures.add(loseTexture, "ASSETS\\IMAGES\\gameOver.png", ScreenTextures::screenBit(GAME_OVER));
+	screenTextures.attach(loseTexture, loseSprite);
 }
 
 /// <summary>
@@ -1840,8 +2058,615 @@ void Game::restartGame()
 {
 	myPlayer.reset();
 	myEnemy.reset();
+	particles.clear();
 	for (int index = 0; index < MAX_ITEMS; index++)
 	{
 		inventoryItemSpriteArray[index].setTextureRect(NULL_RECT);
 	}
 }
+
+/// <summary>
+/// starts a new match, t_watchBots hands the player seat to the AI as well
+/// </summary>
+void Game::startMatch(bool t_watchBots)
+{
+	if (t_watchBots)
+	{
+		seatPolicy[PLAYER] = HeuristicPolicy();
+	}
+	else
+	{
+		seatPolicy[PLAYER] = AnyPolicy();
+	}
+	seatPolicy[ENEMY] = HeuristicPolicy();
+	if (network.isActive())
+	{
+		seatPolicy[ENEMY] = AnyPolicy(); // the other machine's keyboard
+	}
+	else
+	{
+		localSeat = PLAYER;
+	}
+
+	gameScreen = GAMEPLAY;
+	roundStart = true;
+	roundNumber = 0;
+	aiTurn = TurnScript();
+	timers.cancelAll(); // nothing from the last match is left to go off
+	scannerActive = false;
+	doubleDamage = false;
+	enemyPaused = false;
+	playerPaused = false;
+	knowItsBlank = false;
+	knowItsLive = false;
+	networkActions = 0;
+	hasPendingAction = false;
+}
+
+/// <summary>
+/// lets the policy in t_seat take its turn, a new turn script starts whenever the last one has finished
+/// and each tick only resumes it if its wait is over
+/// </summary>
+void Game::updateAiTurn(int t_seat)
+{
+	if (aiTurn.isDone() || aiTurnSeat != t_seat)
+	{
+		aiTurn = playTurnScript(*this, seatPolicy[t_seat], t_seat);
+		aiTurnSeat = t_seat;
+	}
+	aiTurn.tick();
+}
+
+/// <summary>
+/// AI shots wait for both robots to finish animating
+/// </summary>
+TurnScript::WaitUntil Game::animationsFinished()
+{
+	return TurnScript::WaitUntil{ [this]() { return !myPlayer.getAnimationPlaying() && !myEnemy.getAnimationPlaying(); } };
+}
+
+/// <summary>
+/// copies the rules side of the match into a MatchState for the policies to look at
+/// </summary>
+MatchState Game::observeMatch() const
+{
+	MatchState state;
+	state.round = roundNumber;
+	for (int index = 0; index < MAX_SHOTS; index++)
+	{
+		state.taserArray[index] = taserArray[index];
+	}
+	state.currentShot = currentShot;
+	state.currentLoadedShots = currentLoadedShots;
+	state.liveRounds = liveRounds;
+	state.blankRounds = blankRounds;
+
+	state.health[PLAYER] = myPlayer.getHealth();
+	state.health[ENEMY] = myEnemy.getHealth();
+	for (int index = 0; index < MAX_ITEMS; index++)
+	{
+		state.inventory[PLAYER][index] = myPlayer.getInventoryArray(index);
+		state.inventory[ENEMY][index] = myEnemy.getInventoryArray(index);
+	}
+	state.turn = playerTurn ? PLAYER : ENEMY;
+
+	state.doubleDamage = doubleDamage;
+	state.paused[PLAYER] = playerPaused;
+	state.paused[ENEMY] = enemyPaused;
+	state.knowItsLive = knowItsLive;
+	state.knowItsBlank = knowItsBlank;
+	return state;
+}
+
+/// <summary>
+/// carries out an action for either seat, used by both the keyboard and the AI
+/// </summary>
+void Game::applyAction(int t_seat, Action t_action)
+{
+	switch (t_action.type)
+	{
+	case SHOOT_SELF_ACTION:
+		if (t_seat == PLAYER)
+		{
+			shootSelf();
+		}
+		else
+		{
+			enemyShootSelf();
+		}
+		break;
+	case SHOOT_OPPONENT_ACTION:
+		if (t_seat == PLAYER)
+		{
+			shootOpponent();
+			if (enemyPaused == true) //pause remote
+			{
+				enemyPaused = false;
+			}
+			else
+			{
+				playerTurn = false; // ends player turn
+			}
+		}
+		else
+		{
+			enemyShootOpponent();
+			if (playerPaused == true) //pause remote item
+			{
+				playerTurn = false;
+				playerPaused = false;
+			}
+		}
+		break;
+	case USE_ITEM_ACTION:
+		useItem(t_seat, t_action.slot);
+		break;
+	}
+}
+
+/// <summary>
+/// writes the match in progress to QUICKSAVE_FILE
+/// </summary>
+void Game::quickSave()
+{
+	MatchSnapshot snapshot = makeSnapshot(observeMatch(), static_cast<std::uint64_t>(time(NULL)));
+	if (!isValidSnapshot(snapshot))
+	{
+		LOG_WARNING("not quick saving, the match can't be resumed from here");
+		return;
+	}
+	if (!saveSnapshot(QUICKSAVE_FILE, snapshot))
+	{
+		LOG_ERROR("problem writing quick save");
+	}
+}
+
+/// <summary>
+/// loads QUICKSAVE_FILE, from the main menu this starts a normal match at the saved position
+/// </summary>
+void Game::quickLoad()
+{
+	MatchSnapshot snapshot;
+	if (!loadSnapshot(QUICKSAVE_FILE, snapshot))
+	{
+		LOG_ERROR("problem loading quick save");
+		return;
+	}
+	if (gameScreen == MAIN_MENU || gameScreen == GAME_OVER)
+	{
+		startMatch(false);
+	}
+	restoreMatch(snapshot.state);
+	gameScreen = GAMEPLAY;
+}
+
+/// <summary>
+/// puts the rules side of the game (and the sprites that show it) back to t_state
+/// </summary>
+void Game::restoreMatch(const MatchState& t_state)
+{
+	for (int index = 0; index < MAX_SHOTS; index++)
+	{
+		taserArray[index] = t_state.taserArray[index];
+	}
+	currentShot = t_state.currentShot;
+	currentLoadedShots = t_state.currentLoadedShots;
+	liveRounds = t_state.liveRounds;
+	blankRounds = t_state.blankRounds;
+	liveRoundsMessage.setString(std::to_string(liveRounds));
+	blankRoundsMessage.setString(std::to_string(blankRounds));
+
+	// setHealth adds to the current health
+	myPlayer.setHealth(t_state.health[PLAYER] - myPlayer.getHealth());
+	myEnemy.setHealth(t_state.health[ENEMY] - myEnemy.getHealth());
+
+	const sf::IntRect itemRects[RUBBISH_BIN + 1] = { NULL_RECT, OIL_DRINK_RECT, SCANNER_RECT, PAUSE_REMOTE_RECT, OVERCHARGER_RECT, RUBBISH_BIN_RECT };
+	for (int index = 0; index < MAX_ITEMS; index++)
+	{
+		myPlayer.setInventoryArray(index, t_state.inventory[PLAYER][index]);
+		myEnemy.setInventoryArray(index, t_state.inventory[ENEMY][index]);
+		inventoryItemSpriteArray[index].setTextureRect(itemRects[t_state.inventory[PLAYER][index]]);
+		enemyItemSpriteArray[index].setTextureRect(itemRects[t_state.inventory[ENEMY][index]]);
+	}
+
+	playerTurn = t_state.turn == PLAYER;
+	roundNumber = t_state.round;
+	doubleDamage = t_state.doubleDamage;
+	playerPaused = t_state.paused[PLAYER];
+	enemyPaused = t_state.paused[ENEMY];
+	knowItsLive = t_state.knowItsLive;
+	knowItsBlank = t_state.knowItsBlank;
+
+	roundStart = false;
+	aiTurn = TurnScript();
+	timers.cancelAll();
+	scannerActive = false;
+	checkHealth();
+}
+
+
+/// <summary>
+/// the keyboard's action for localSeat, in a network match it's sent straight away
+/// and played here once the input delay has passed, so both screens show it together
+/// </summary>
+void Game::submitLocalAction(Action t_action)
+{
+	if (!observeMatch().isLegal(localSeat, t_action))
+	{
+		return; // an empty slot, or a key pressed before the next round loaded the taser
+	}
+	if (network.isActive() && !network.isLocalTurn(observeMatch()))
+	{
+		return; // an item from the inventory screen, the other machine's next action has this sequence number
+	}
+	if (!network.isActive())
+	{
+		applyAction(localSeat, t_action);
+		if (handlingInput && !hasUnshownAction)
+		{
+			hasUnshownAction = true;
+			unshownActionTime = handlingInputTime;
+		}
+		return;
+	}
+	if (hasPendingAction)
+	{
+		return;
+	}
+	network.sendAction(t_action, networkActions, observeMatch().checksum());
+	pendingAction = t_action;
+	hasPendingAction = true;
+	pendingActionInputTime = handlingInputTime;
+	pendingActionTimer = timers.schedule(static_cast<std::uint32_t>(network.getInputDelay()), [this]()
+	{
+		applyAction(localSeat, pendingAction);
+		networkActions++;
+		hasPendingAction = false;
+		if (!hasUnshownAction)
+		{
+			hasUnshownAction = true; // the input delay counts towards this one
+			unshownActionTime = pendingActionInputTime;
+		}
+	});
+}
+
+/// <summary>
+/// plays the delayed local action or the other machine's next action,
+/// each remote one is checked against this machine's copy of the match before it's applied
+/// </summary>
+void Game::updateNetworkTurn(int t_seatToMove)
+{
+	network.update();
+	if (network.isDisconnected())
+	{
+		LOG_WARNING("opponent disconnected");
+		leaveNetworkMatch();
+		gameScreen = MAIN_MENU;
+		return;
+	}
+
+	if (hasPendingAction)
+	{
+		return; // pendingActionTimer plays it once the input delay is up
+	}
+
+	RemoteAction remote;
+	if (t_seatToMove != localSeat && network.receiveAction(remote))
+	{
+		MatchState state = observeMatch();
+		if (!network.checkSync(remote, networkActions, state.checksum()) || !state.isLegal(t_seatToMove, remote.action))
+		{
+			LOG_WARNING("network match out of sync, leaving");
+			leaveNetworkMatch();
+			gameScreen = MAIN_MENU;
+			return;
+		}
+		applyAction(t_seatToMove, remote.action);
+		networkActions++;
+	}
+}
+
+/// <summary>
+/// hosts a network match on t_port, the window waits on the main menu until someone joins
+/// </summary>
+bool Game::hostNetworkMatch(unsigned short t_port)
+{
+	networkMatchStarted = false;
+	if (!network.host(t_port))
+	{
+		return false;
+	}
+	watchBotsMessage.setString("Waiting for an opponent on port " + std::to_string(t_port));
+	return true;
+}
+
+/// <summary>
+/// joins a network match hosted at t_address, this machine plays the enemy robot
+/// </summary>
+bool Game::joinNetworkMatch(const std::string& t_address, unsigned short t_port)
+{
+	networkMatchStarted = false;
+	if (!network.join(t_address, t_port))
+	{
+		return false;
+	}
+	watchBotsMessage.setString("Connecting to " + t_address);
+	return true;
+}
+
+/// <summary>
+/// closes the connection and goes back to local play against the AI
+/// </summary>
+void Game::leaveNetworkMatch()
+{
+	if (!network.isActive())
+	{
+		return;
+	}
+	network.close();
+	networkMatchStarted = false;
+	timers.cancel(pendingActionTimer);
+	hasPendingAction = false;
+	localSeat = PLAYER;
+	seatPolicy[ENEMY] = HeuristicPolicy();
+	matchRandom.seed(static_cast<std::uint64_t>(time(NULL)));
+	watchBotsMessage.setString("Press A to watch AI vs AI, R for a free for all");
+}
+
+/// <summary>
+/// lets spectators watch, on t_port and/or into a recording file
+/// </summary>
+bool Game::startBroadcast(unsigned short t_port, const std::string& t_recordingFile)
+{
+	return spectators.open(t_port, t_recordingFile);
+}
+
+/// <summary>
+/// what spectators see this tick: the visible match and the animation each robot is playing
+/// </summary>
+SpectatorFrame Game::spectatorFrame() const
+{
+	MatchView view;
+	view.fromState(observeMatch());
+	SpectatorFrame frame;
+	frame.setView(view);
+	frame.field[SpectatorFrame::ANIMATION + PLAYER] = static_cast<signed char>(myPlayer.getCurrentAnimation());
+	frame.field[SpectatorFrame::ANIMATION + ENEMY] = static_cast<signed char>(myEnemy.getCurrentAnimation());
+	frame.field[SpectatorFrame::ANIMATIONS_STARTED + PLAYER] = static_cast<signed char>(myPlayer.getAnimationsStarted());
+	frame.field[SpectatorFrame::ANIMATIONS_STARTED + ENEMY] = static_cast<signed char>(myEnemy.getAnimationsStarted());
+	return frame;
+}
+
+/// <summary>
+/// shows the scanned shot on the inventory screen for scannerDisplayFrames
+/// </summary>
+void Game::showScannedShot()
+{
+	scannerActive = true;
+	timers.cancel(scannerTimer);
+	scannerTimer = timers.schedule(scannerDisplayFrames, [this]() { scannerActive = false; });
+}
+
+/// <summary>
+/// someone's out of battery, the game over screen comes up after endGracePeriod
+/// </summary>
+void Game::startGameOverTimer()
+{
+	if (!timers.isPending(endTimer))
+	{
+		endTimer = timers.schedule(endGracePeriod + 1, [this]() { gameScreen = GAME_OVER; });
+	}
+}
+
+/// <summary>
+/// plays AI vs AI matches for t_frames ticks rendering every tick into t_backend,
+/// prints the draw calls and the CPU time of render() per frame. the seed is fixed so
+/// a recording backend gets the same frames every run
+/// </summary>
+void Game::runRenderBenchmark(RenderBackend& t_backend, int t_frames)
+{
+	renderer = &t_backend;
+	matchRandom.seed(1);
+	startMatch(true);
+
+	const sf::Time timePerFrame = sf::seconds(1.0f / 60.0f);
+	std::vector<long long> frameTimes;
+	frameTimes.reserve(t_frames);
+	for (int frame = 0; frame < t_frames; frame++)
+	{
+		update(timePerFrame);
+		if (gameScreen == GAME_OVER && frame % 120 == 0)
+		{
+			startMatch(true); // up to two seconds on the game over screen, then another match
+		}
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		render();
+		frameTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+	renderer = &windowRenderer;
+
+	if (frameTimes.empty())
+	{
+		return;
+	}
+	long long total = 0;
+	for (long long time : frameTimes)
+	{
+		total += time;
+	}
+	std::sort(frameTimes.begin(), frameTimes.end());
+	std::cout << t_frames << " frames, " << static_cast<double>(t_backend.getDrawCalls()) / t_frames << " draw calls per frame, render "
+		<< total / 1000.0 / t_frames << "us avg, " << frameTimes[frameTimes.size() * 99 / 100] / 1000.0 << "us p99" << std::endl;
+}
+
+/// <summary>
+/// the small textures shared between screens stay loaded and are only counted,
+/// and which screens usually follow which, for prefetching
+/// </summary>
+void Game::setupScreenTextures()
+{
+	const sf::Texture* shared[] = { &buttonsTexture, &slotTexture, &itemSheetTexture, &upperBarTexture, &tableTexture,
+		&playerHealthBarTexture, &enemyHealthBarTexture, &liveTaserTexture, &emptyTaserTexture };
+	for (const sf::Texture* texture : shared)
+	{
+		screenTextures.track(*texture);
+	}
+
+	screenTextures.setLikelyNext(MAIN_MENU, ScreenTextures::screenBit(GAMEPLAY) | ScreenTextures::screenBit(INSTRUCTIONS));
+	screenTextures.setLikelyNext(INSTRUCTIONS, ScreenTextures::screenBit(MAIN_MENU));
+	screenTextures.setLikelyNext(GAMEPLAY, ScreenTextures::screenBit(INVENTORY) | ScreenTextures::screenBit(GAME_OVER));
+	screenTextures.setLikelyNext(INVENTORY, ScreenTextures::screenBit(GAMEPLAY));
+	screenTextures.setLikelyNext(GAME_OVER, ScreenTextures::screenBit(MAIN_MENU));
+}
+
+/// <summary>
+/// loads what the current screen draws before it's drawn
+/// </summary>
+void Game::useScreenTextures()
+{
+	if (screenTextures.use(gameScreen) && gameScreen == GAME_OVER)
+	{
+		winSprite.setPosition((SCREEN_WIDTH - winSprite.getLocalBounds().width) / 2,
+			(SCREEN_HEIGHT - winSprite.getLocalBounds().height) / 2);
+		loseSprite.setPosition((SCREEN_WIDTH - loseSprite.getLocalBounds().width) / 2,
+			(SCREEN_HEIGHT - loseSprite.getLocalBounds().height) / 2);
+	}
+}
+
+/// <summary>
+/// after a frame has been displayed: how long its key press and action took to get there
+/// </summary>
+void Game::recordLatency(bool t_hasInput, std::chrono::steady_clock::time_point t_inputTime,
+	bool t_hasAction, std::chrono::steady_clock::time_point t_actionTime)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (t_hasInput)
+	{
+		inputLatency.record(now - t_inputTime);
+	}
+	if (t_hasAction)
+	{
+		actionLatency.record(now - t_actionTime);
+	}
+	if (latencyReportRequested.exchange(false))
+	{
+		printLatency();
+	}
+}
+
+void Game::printLatency()
+{
+	inputLatency.print("key to display");
+	actionLatency.print("key to action on display");
+}
+
+/// <summary>
+/// from here on every key is kept with its tick and the session is saved to t_file when run() ends.
+/// the match random gets a fresh seed that's saved with it, a replay starts from the same one
+/// </summary>
+void Game::startSessionRecording(const std::string& t_file)
+{
+	sessionFile = t_file;
+	session = SessionRecording();
+	session.seed = static_cast<std::uint64_t>(time(NULL));
+	session.keys.reserve(4096);
+	matchRandom.seed(session.seed);
+	recordingSession = true;
+}
+
+void Game::finishSessionRecording()
+{
+	if (!recordingSession)
+	{
+		return;
+	}
+	recordingSession = false;
+	if (networkMatchStarted)
+	{
+		LOG_WARNING("not saving session %s, the other machine's moves aren't in it", sessionFile.c_str());
+		return;
+	}
+	session.ticks = static_cast<std::uint64_t>(ticks);
+	session.checksum = sessionChecksum();
+	if (saveSession(sessionFile, session))
+	{
+		LOG_INFO("saved %zu keys over %llu ticks to %s", session.keys.size(), static_cast<unsigned long long>(session.ticks), sessionFile.c_str());
+	}
+	else
+	{
+		LOG_ERROR("problem saving session %s", sessionFile.c_str());
+	}
+}
+
+/// <summary>
+/// the match plus the screen and menu state around it, what a replay has to end on
+/// </summary>
+std::uint32_t Game::sessionChecksum() const
+{
+	std::uint32_t hash = observeMatch().checksum();
+	int extra[] = { gameScreen, selectedButtonIndex, playerWon ? 1 : 0, enemyWon ? 1 : 0, m_exitGame ? 1 : 0 };
+	for (int value : extra)
+	{
+		hash ^= static_cast<std::uint32_t>(value);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/// <summary>
+/// plays t_session again headless, handling each key before the update it was handled before
+/// when it was recorded. runs exactly as many updates as the session did, escape included, since
+/// the live loops can finish a tick after it. t_draws also renders every tick and checksums the draws,
+/// nullptr skips drawing. each tick is timed, update and render together
+/// </summary>
+ReplayResult Game::replaySession(const SessionRecording& t_session, RecordingRenderBackend* t_draws, long long t_tickBudgetMicroseconds)
+{
+	matchRandom.seed(t_session.seed);
+	if (t_draws != nullptr)
+	{
+		renderer = t_draws;
+	}
+
+	const sf::Time timePerFrame = sf::seconds(1.0f / 60.0f);
+	ReplayResult result;
+	std::uint32_t drawHash = 2166136261u;
+	std::size_t nextKey = 0;
+	sf::Event keyEvent;
+	keyEvent.type = sf::Event::KeyPressed;
+	ticks = 0;
+	while (static_cast<std::uint64_t>(ticks) <= t_session.ticks)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		while (nextKey < t_session.keys.size() && t_session.keys[nextKey].tick == static_cast<std::uint32_t>(ticks))
+		{
+			keyEvent.key.code = static_cast<sf::Keyboard::Key>(t_session.keys[nextKey].key);
+			handleEvent(keyEvent, start);
+			nextKey++;
+		}
+		if (static_cast<std::uint64_t>(ticks) == t_session.ticks)
+		{
+			break; // keys after the last update, the session ended here
+		}
+		update(timePerFrame);
+		ticks++;
+		if (t_draws != nullptr)
+		{
+			render();
+			drawHash = t_draws->drainChecksum(drawHash);
+		}
+
+		long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		result.totalMicroseconds += microseconds;
+		result.slowestTickMicroseconds = std::max(result.slowestTickMicroseconds, microseconds);
+		if (microseconds > t_tickBudgetMicroseconds)
+		{
+			result.ticksOverBudget++;
+		}
+	}
+	renderer = &windowRenderer;
+
+	result.ticks = static_cast<std::uint64_t>(ticks);
+	result.checksum = sessionChecksum();
+	result.drawChecksum = drawHash;
+	return result;
+}
\ No newline at end of file
@@ -18,23 +18,64 @@
 #include "Globals.h"
 #include "Player.h"
 #include "Enemy.h"
+#include "Policy.h"
+#include "Snapshot.h"
+#include "Lockstep.h"
+#include "Spectator.h"
+#include "TurnScript.h"
+#include "Random.h"
+#include "SoundMixer.h"
+#include "ParticleSystem.h"
+#include "RenderBackend.h"
+#include "ScreenTextures.h"
+#include "TextureCache.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include "LatencyHistogram.h"
+#include "SessionRecording.h"
+#include "FreeForAllScreen.h"
+#include <atomic>
+#include <mutex>
 
 class Game
 {
 public:
 	Game();
+	explicit Game(bool t_headless); // headless: no window, audio or music, for runRenderBenchmark
 	~Game();
 	/// <summary>
 	/// main method for game
 	/// </summary>
 	void run();
 
+	bool hostNetworkMatch(unsigned short t_port);
+	bool joinNetworkMatch(const std::string& t_address, unsigned short t_port);
+	bool startBroadcast(unsigned short t_port, const std::string& t_recordingFile);
+	void runRenderBenchmark(RenderBackend& t_backend, int t_frames);
+	void setTextureBudget(std::size_t t_bytes) { screenTextures.setBudget(t_bytes); }
+	void setThreadedRendering(bool t_threaded) { threadedRendering = t_threaded; }
+	void startSessionRecording(const std::string& t_file);
+	ReplayResult replaySession(const SessionRecording& t_session, RecordingRenderBackend* t_draws, long long t_tickBudgetMicroseconds);
+
 private:
 
+	void runSingleThreaded();
+	void runSimulation();
 	void processEvents();
+	void handleEvent(const sf::Event& t_event, std::chrono::steady_clock::time_point t_time);
+	bool isSelectionKey(const sf::Event& t_event) const;
+	void captureFrame();
+	void recordLatency(bool t_hasInput, std::chrono::steady_clock::time_point t_inputTime,
+		bool t_hasAction, std::chrono::steady_clock::time_point t_actionTime);
+	void printLatency();
+	void finishSessionRecording();
+	std::uint32_t sessionChecksum() const;
 	void processKeys(sf::Event t_event);
 	void update(sf::Time t_deltaTime);
 	void render();
+	void updateMusic();
+	void setupScreenTextures();
+	void useScreenTextures();
 	
 	void setupVariables();
 	void setupFontAndText();
@@ -54,7 +95,9 @@ private:
 
 	void enemyShootSelf();
 	void enemyShootOpponent();
+	void emitHitEffects(int t_shooter, int t_target, int t_damage);
 
+	void startRoundIfNeeded();
 	void loadTaser();
 	void giveItems();
 	void useItem(int t_user, int t_slot);
@@ -66,8 +109,65 @@ private:
 	void setupGameOver();
 
 	void restartGame();
+	void startMatch(bool t_watchBots);
+
+	void updateAiTurn(int t_seat);
+	MatchState observeMatch() const;
+	void applyAction(int t_seat, Action t_action);
+	TurnScript::Delay turnDelay(int t_frames) { return TurnScript::Delay{ t_frames, &timers }; }
+	TurnScript::WaitUntil animationsFinished();
+	template <typename TurnHost, typename Policy>
+	friend TurnScript playTurnScript(TurnHost& t_host, Policy& t_policy, int t_seat);
+
+	void quickSave();
+	void quickLoad();
+	void restoreMatch(const MatchState& t_state);
+
+	void submitLocalAction(Action t_action);
+	void updateNetworkTurn(int t_seatToMove);
+	void leaveNetworkMatch();
+	void showScannedShot();
+	void startGameOverTimer();
+
+	SpectatorFrame spectatorFrame() const;
 
 	sf::RenderWindow m_window; // main SFML window
+	WindowRenderBackend windowRenderer;
+	RenderBackend* renderer; // everything render() draws goes through here
+	bool headless;
+
+	// threaded run(): this thread polls the window and draws, runSimulation updates on its own thread
+	bool threadedRendering = true;
+	struct InputEvent
+	{
+		sf::Event event;
+		std::chrono::steady_clock::time_point time; // when the window thread got it
+	};
+	SpscQueue<InputEvent, 64> inputEvents; // window events for the simulation thread
+	TripleBuffer<RenderFrame> renderFrames; // latest frame for the window thread
+	CaptureRenderBackend frameCapture; // render() fills renderFrames through this
+	std::mutex textureLock; // screen textures aren't loaded or freed while a frame is being drawn
+	std::atomic<bool> simulationRunning{ false };
+	std::atomic<bool> simulationFinished{ false };
+	long long ticks = 0;
+
+	// input to display latency: key presses and the actions they cause are stamped when they
+	// arrive, the stamp rides along to the first frame showing them and is measured after display()
+	bool handlingInput = false;
+	std::chrono::steady_clock::time_point handlingInputTime; // of the key processKeys is on
+	bool hasUnshownInput = false;
+	std::chrono::steady_clock::time_point unshownInputTime;
+	bool hasUnshownAction = false;
+	std::chrono::steady_clock::time_point unshownActionTime;
+	std::chrono::steady_clock::time_point pendingActionInputTime; // the key behind the network action waiting on the input delay
+	LatencyHistogram inputLatency; // key to the frame showing it, window thread only
+	LatencyHistogram actionLatency; // key to the frame showing the move it made
+	std::atomic<bool> latencyReportRequested{ false };
+
+	// "--record-session": every key handled, stamped with ticks, saved when run() ends
+	bool recordingSession = false;
+	std::string sessionFile;
+	SessionRecording session;
 	sf::Font m_ArialBlackfont; // font used by message
 	bool m_exitGame; // control exiting game
 	bool playerWon = false; // True if the player wins, false if the player loses
@@ -91,7 +191,25 @@ private:
 	bool playerTurn; // is it currently the player's turn?
 	sf::Text currentTurnMessage; // text depicting whos turn it currently is
 
-	int aiTurnTimer = 0; // temporary variable to showcase AI "thinking" and taking its turn
+	TimerWheel timers; // match timers (AI pacing, scanner display, game over delay), only run during a match
+	TurnScript aiTurn; // the AI turn in progress, resumed once a tick
+	int aiTurnSeat = PLAYER; // seat aiTurn is playing
+
+	AnyPolicy seatPolicy[2]; // who controls PLAYER / ENEMY, empty means the keyboard
+	sf::Text watchBotsMessage; // main menu hint for AI vs AI mode
+
+	FastRandom matchRandom; // loads the taser and deals items, shared seed in network matches
+	int localSeat; // seat this machine's keyboard plays, ENEMY when joining a network match
+
+	// network match
+	LockstepSession network;
+	bool networkMatchStarted;
+	std::uint32_t networkActions; // actions applied by both seats this match, stamped on each one sent
+	bool hasPendingAction; // local action already sent, waiting out the input delay
+	Action pendingAction;
+	TimerWheel::TimerId pendingActionTimer;
+
+	SpectatorBroadcaster spectators; // only sends anything once startBroadcast has been called
 
 	// main menu buttons
 	sf::RectangleShape startButton; // button that starts the game
@@ -114,7 +232,6 @@ private:
 
 	// Buttons sprite sheet texture
 	sf::Texture buttonsTexture;
-	sf::Texture inventoryButtonTexture;
 
 	// main menu texture & sprite
 	sf::Texture menuScreenTexture;
@@ -174,16 +291,16 @@ private:
 
 	//gameplay variables
 	bool roundStart; // has a round started?
+	int roundNumber; // rounds started this match
 
 	int playerHealth;
 	int enemyHealth;
 
 	int currentShot; // the current shot loaded into the taser
-	int endTimer; //gives couple frames of leeway before endscreen is shown
+	TimerWheel::TimerId endTimer; //gives couple frames of leeway before endscreen is shown
 	const int endGracePeriod = 60;
 
 	// taser variables
-	static const int MAX_SHOTS = 6;
 	int taserArray[MAX_SHOTS];
 	int currentLoadedShots;
 
@@ -199,7 +316,8 @@ private:
 	//items
 	bool doubleDamage; 
 	bool scannerActive;
-	int scannerTimer;
+	TimerWheel::TimerId scannerTimer;
+	const int scannerDisplayFrames = 100;
 	bool enemyPaused;
 	sf::Sprite scannedShotSprite;
 
@@ -208,15 +326,7 @@ private:
 	bool knowItsLive;
 	bool playerPaused;
 
-	sf::SoundBuffer robotDamageTakenBuffer;
-	sf::Sound robotDamageTakenSound;
-	
-	sf::SoundBuffer zapBuffer;
-	sf::Sound zapSound;
-
-	sf::SoundBuffer blankBuffer;
-	sf::Sound blankSound;
-
+	ScreenTextures screenTextures; // full screen textures are only loaded while they might be needed
 	sf::Texture winTexture;
 	sf::Sprite winSprite;
 	sf::Texture loseTexture;
@@ -228,24 +338,8 @@ private:
 	sf::SoundBuffer m_gameplayMusicLoad;
 	sf::Sound m_gameplayMusic;
 
-	sf::SoundBuffer m_menuSelect;
-	sf::Sound m_beep;
-
-	sf::SoundBuffer m_menuChoose;
-	sf::Sound m_boop;
-
-	sf::SoundBuffer oilDrinkBuffer;
-	sf::Sound oilDrinkSound;
-
-	sf::SoundBuffer scannerBuffer;
-	sf::Sound scannerSound;
-
-	sf::SoundBuffer pauseRemoteBuffer;
-	sf::Sound pauseRemoteSound;
-
-	sf::SoundBuffer overchargerBuffer;
-	sf::Sound overchargerSound;
+	SoundMixer sounds; // every sound effect, the music loops on its own
+	ParticleSystem particles; // taser arcs, sparks and battery drain on a hit
 
-	sf::SoundBuffer rubbishBinBuffer;
-	sf::Sound rubbishBinSound;
+	FreeForAllTable freeForAll; // the free for all screen, dealt from matchRandom
 };
\ No newline at end of file
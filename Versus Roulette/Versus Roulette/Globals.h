@@ -6,6 +6,7 @@
 /// Contains the game globals
 /// 
 #include <SFML/Graphics.hpp>
+#include "MatchRules.h"
 
 #pragma once
 //game screens
@@ -14,6 +15,7 @@ const int static GAMEPLAY = 1;
 const int static INSTRUCTIONS = 2;
 const int static GAME_OVER = 3;
 const int static INVENTORY = 4;
+const int static FREE_FOR_ALL = 5; // FreeForAllTable, 3 to 16 robots with the keyboard on robot 1
 
 //animations
 const int static SHOOT_OPPONENT_LIVE = 1;
@@ -22,6 +24,14 @@ const int static SHOOT_SELF_LIVE = 3;
 const int static SHOOT_SELF_BLANK = 4;
 const int static GETTING_HIT = 5;
 
+//where the particle effects start: the taser tips, the robots' chests and the health batteries
+const sf::Vector2f PLAYER_TASER_TIP(335.0f, 430.0f);
+const sf::Vector2f ENEMY_TASER_TIP(465.0f, 430.0f);
+const sf::Vector2f PLAYER_CHEST(200.0f, 450.0f);
+const sf::Vector2f ENEMY_CHEST(600.0f, 450.0f);
+const sf::Vector2f PLAYER_BATTERY_CENTRE(182.0f, 282.0f);
+const sf::Vector2f ENEMY_BATTERY_CENTRE(752.0f, 282.0f);
+
 //items
 const int static OIL_DRINK = 1;
 const int static SCANNER = 2;
@@ -57,7 +67,10 @@ const sf::IntRect ENEMY_BATTERY_1_RECT(64, 0, 64, 64);
 const sf::IntRect ENEMY_BATTERY_0_RECT(0, 0, 64, 64);
 
 //inventory
-static const int MAX_ITEMS = 4;
+static const int MAX_ITEMS = ClassicRules::itemSlots;
+
+//taser
+static const int MAX_SHOTS = ClassicRules::magazineSize;
 
 // the size of the screen in pixels used in the game
 const float SCREEN_WIDTH = 800;   
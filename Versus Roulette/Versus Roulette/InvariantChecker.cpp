@@ -0,0 +1,440 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "InvariantChecker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+const long long static CHECK_BLOCK_GAMES = 4096; // matches handed to a thread at a time
+const int static MAX_REPORTED_FAILURES = 8; // the rest are only counted
+
+const char* checkMatchInvariants(const MatchState& t_state, const RuleConfig& t_rules)
+{
+	if (t_state.turn != PLAYER && t_state.turn != ENEMY)
+	{
+		return "turn is a seat";
+	}
+	if (t_state.currentLoadedShots < 0 || t_state.currentLoadedShots > t_rules.magazineSize)
+	{
+		return "0 <= currentLoadedShots <= magazineSize";
+	}
+	// -1 is the empty taser, the round ends before anything can fire or discard from it
+	if (t_state.currentShot != t_state.currentLoadedShots - 1)
+	{
+		return "currentShot == currentLoadedShots - 1";
+	}
+	if (t_state.liveRounds < 0 || t_state.blankRounds < 0)
+	{
+		return "liveRounds and blankRounds >= 0";
+	}
+	if (t_state.liveRounds + t_state.blankRounds != t_state.currentLoadedShots)
+	{
+		return "liveRounds + blankRounds == currentLoadedShots";
+	}
+	int live = 0;
+	for (int index = 0; index <= t_state.currentShot; index++)
+	{
+		if (t_state.taserArray[index] != 0 && t_state.taserArray[index] != 1)
+		{
+			return "taser shots are 0 or 1";
+		}
+		live += t_state.taserArray[index];
+	}
+	if (live != t_state.liveRounds)
+	{
+		return "liveRounds matches the shots left in the taser";
+	}
+	if (t_state.knowItsLive && t_state.knowItsBlank)
+	{
+		return "scanner doesn't say live and blank at once";
+	}
+	if ((t_state.knowItsLive || t_state.knowItsBlank)
+		&& (t_state.currentShot < 0 || t_state.taserArray[t_state.currentShot] != (t_state.knowItsLive ? 1 : 0)))
+	{
+		return "scanner result matches the next shot";
+	}
+	// the player can be: a pause that outlasts the round carries over, but every round opens on
+	// the player anyway, so the pause lands on their next turn instead
+	if (t_state.turn == ENEMY && t_state.paused[ENEMY])
+	{
+		return "the enemy never moves while paused";
+	}
+	for (int seat = 0; seat < 2; seat++)
+	{
+		for (int index = 0; index < MAX_ITEMS; index++)
+		{
+			if (t_state.inventory[seat][index] < 0 || t_state.inventory[seat][index] > ITEM_TYPES)
+			{
+				return "inventory slots hold an item id or 0";
+			}
+		}
+	}
+	return nullptr;
+}
+
+const char* checkActionInvariants(const MatchState& t_before, int t_seat, Action t_action, const MatchState& t_after)
+{
+	int other = 1 - t_seat;
+	if (t_after.round != t_before.round)
+	{
+		return "only a new round changes round";
+	}
+	if (t_action.type == USE_ITEM_ACTION)
+	{
+		int item = t_before.inventory[t_seat][t_action.slot];
+		for (int index = 0; index < MAX_ITEMS; index++)
+		{
+			int expected = index == t_action.slot ? 0 : t_before.inventory[t_seat][index];
+			if (t_after.inventory[t_seat][index] != expected || t_after.inventory[other][index] != t_before.inventory[other][index])
+			{
+				return "an item empties its own slot and nothing else";
+			}
+		}
+		int healed = item == OIL_DRINK ? 1 : 0;
+		if (t_after.health[t_seat] != t_before.health[t_seat] + healed || t_after.health[other] != t_before.health[other])
+		{
+			return "only an oil drink changes health outside a shot";
+		}
+		int discarded = item == RUBBISH_BIN ? 1 : 0;
+		if (t_after.currentLoadedShots != t_before.currentLoadedShots - discarded)
+		{
+			return "only a rubbish bin takes a shot out outside a shot";
+		}
+		if (t_after.turn != t_before.turn)
+		{
+			return "using an item keeps the turn";
+		}
+		return nullptr;
+	}
+
+	if (std::memcmp(t_after.inventory, t_before.inventory, sizeof(t_before.inventory)) != 0)
+	{
+		return "shooting doesn't change inventories";
+	}
+	if (t_after.currentLoadedShots != t_before.currentLoadedShots - 1)
+	{
+		return "a shot uses exactly one round";
+	}
+	int target = t_action.type == SHOOT_SELF_ACTION ? t_seat : other;
+	int damage = t_before.taserArray[t_before.currentShot] == 1 ? (t_before.doubleDamage ? 2 : 1) : 0;
+	if (t_after.health[target] != t_before.health[target] - damage || t_after.health[1 - target] != t_before.health[1 - target])
+	{
+		return "a shot only damages its target, by 1 or 2 when overcharged";
+	}
+	if (t_after.doubleDamage || t_after.knowItsLive || t_after.knowItsBlank)
+	{
+		return "a shot clears overcharger and scanner";
+	}
+	bool keepsTurn = t_before.paused[other] || (t_action.type == SHOOT_SELF_ACTION && damage == 0);
+	if (t_after.turn != (keepsTurn ? t_seat : other))
+	{
+		return "turn passes unless it's a blank at yourself or the opponent is paused";
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// one random rule set inside the ranges RuleConfig allows, half the time the real rules
+/// </summary>
+static RuleConfig randomRules(FastRandom& t_random)
+{
+	if (t_random.nextInt(2) == 0)
+	{
+		return DEFAULT_RULES;
+	}
+	RuleConfig rules;
+	int totalWeight = 0;
+	do
+	{
+		totalWeight = 0;
+		for (int index = 0; index < ITEM_TYPES; index++)
+		{
+			rules.itemWeights[index] = t_random.nextInt(4);
+			totalWeight += rules.itemWeights[index];
+		}
+	} while (totalWeight == 0);
+	rules.magazineSize = 2 + t_random.nextInt(MAX_SHOTS - 1);
+	rules.startingHealth = 1 + t_random.nextInt(8);
+	rules.itemsPerRound = t_random.nextInt(MAX_ITEMS + 1);
+	rules.maxRounds = 1 + t_random.nextInt(MAX_ROUNDS);
+	return rules;
+}
+
+/// <summary>
+/// any legal action, both shots and every held item equally likely
+/// </summary>
+static Action randomAction(const MatchState& t_state, FastRandom& t_random)
+{
+	Action choices[2 + MAX_ITEMS] = { shootSelfAction(), shootOpponentAction() };
+	int choiceCount = 2;
+	for (int index = 0; index < MAX_ITEMS; index++)
+	{
+		if (t_state.inventory[t_state.turn][index] != 0)
+		{
+			choices[choiceCount++] = useItemAction(index);
+		}
+	}
+	return choices[t_random.nextInt(choiceCount)];
+}
+
+/// <summary>
+/// tries every shot and every slot for both seats on a taser that needs a new round, none may be legal.
+/// hosts only apply legal actions, so this is what keeps them off taserArray[-1]
+/// </summary>
+static const char* tryEmptyTaser(const MatchState& t_state)
+{
+	Action attempts[2 + MAX_ITEMS] = { shootSelfAction(), shootOpponentAction() };
+	for (int index = 0; index < MAX_ITEMS; index++)
+	{
+		attempts[2 + index] = useItemAction(index);
+	}
+	for (int seat = 0; seat < 2; seat++)
+	{
+		for (const Action& attempt : attempts)
+		{
+			if (t_state.isLegal(seat, attempt))
+			{
+				return "nothing is legal on an empty taser";
+			}
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// plays one random match dealt by t_seed, every action goes into t_actions.
+/// returns the first invariant broken or nullptr
+/// </summary>
+static const char* playCheckedMatch(std::uint64_t t_seed, RuleConfig& t_rules, std::vector<Action>& t_actions, long long& t_actionCount)
+{
+	FastRandom deal(t_seed);
+	FastRandom choose(t_seed ^ 0x9E3779B97F4A7C15ULL); // separate so dropping an action doesn't change the deal
+	t_rules = randomRules(choose);
+	t_actions.clear();
+
+	MatchState state;
+	state.reset(t_rules);
+	while (!state.isOver() && !state.isOutOfRounds(t_rules))
+	{
+		if (state.needsNewRound())
+		{
+			if (const char* broken = tryEmptyTaser(state))
+			{
+				return broken;
+			}
+			state.startRound(deal, t_rules);
+			if (const char* broken = checkMatchInvariants(state, t_rules))
+			{
+				return broken;
+			}
+		}
+		const int seat = state.turn;
+		Action action = randomAction(state, choose);
+		t_actions.push_back(action);
+		const MatchState before = state;
+		state.apply(seat, action);
+		t_actionCount++;
+		const char* broken = checkMatchInvariants(state, t_rules);
+		if (broken == nullptr)
+		{
+			broken = checkActionInvariants(before, seat, action, state);
+		}
+		if (broken != nullptr)
+		{
+			return broken;
+		}
+	}
+	return nullptr;
+}
+
+const char* replayActions(std::uint64_t t_seed, const RuleConfig& t_rules, const std::vector<Action>& t_actions)
+{
+	FastRandom deal(t_seed);
+	MatchState state;
+	state.reset(t_rules);
+	for (const Action& action : t_actions)
+	{
+		if (state.isOver() || state.isOutOfRounds(t_rules))
+		{
+			break;
+		}
+		if (state.needsNewRound())
+		{
+			if (const char* broken = tryEmptyTaser(state))
+			{
+				return broken;
+			}
+			state.startRound(deal, t_rules);
+			if (const char* broken = checkMatchInvariants(state, t_rules))
+			{
+				return broken;
+			}
+		}
+		const int seat = state.turn;
+		if (!state.isLegal(seat, action))
+		{
+			continue; // the item it used was dropped by the shrinker
+		}
+		const MatchState before = state;
+		state.apply(seat, action);
+		const char* broken = checkMatchInvariants(state, t_rules);
+		if (broken == nullptr)
+		{
+			broken = checkActionInvariants(before, seat, action, state);
+		}
+		if (broken != nullptr)
+		{
+			return broken;
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// delta debugging: try dropping chunks of the action list, halving the chunk size until single actions.
+/// invariants are compared by name, they're string literals so the pointer is enough
+/// </summary>
+void shrinkFailure(InvariantFailure& t_failure)
+{
+	std::vector<Action> candidate;
+	for (std::size_t chunk = std::max<std::size_t>(t_failure.actions.size() / 2, 1); chunk > 0; chunk /= 2)
+	{
+		bool removed = true;
+		while (removed)
+		{
+			removed = false;
+			for (std::size_t start = 0; start < t_failure.actions.size(); start += chunk)
+			{
+				candidate.assign(t_failure.actions.begin(), t_failure.actions.begin() + start);
+				candidate.insert(candidate.end(), t_failure.actions.begin() + std::min(start + chunk, t_failure.actions.size()), t_failure.actions.end());
+				if (replayActions(t_failure.seed, t_failure.rules, candidate) == t_failure.invariant)
+				{
+					t_failure.actions = candidate;
+					removed = true;
+					break;
+				}
+			}
+		}
+	}
+}
+
+static void printFailure(const InvariantFailure& t_failure)
+{
+	const char* ITEM_NAMES[] = { "empty", "oil drink", "scanner", "pause remote", "overcharger", "rubbish bin" };
+	const RuleConfig& rules = t_failure.rules;
+	std::cout << "FAIL: " << t_failure.invariant << "\n  seed " << t_failure.seed << ", rules magazine " << rules.magazineSize
+		<< " health " << rules.startingHealth << " items " << rules.itemsPerRound << " rounds " << rules.maxRounds << " weights";
+	for (int index = 0; index < ITEM_TYPES; index++)
+	{
+		std::cout << " " << rules.itemWeights[index];
+	}
+	std::cout << "\n  " << t_failure.actions.size() << " actions:";
+
+	// replayed to name the items, illegal leftovers are shown as skipped
+	FastRandom deal(t_failure.seed);
+	MatchState state;
+	state.reset(rules);
+	for (const Action& action : t_failure.actions)
+	{
+		if (state.needsNewRound())
+		{
+			state.startRound(deal, rules);
+			std::cout << " | round " << state.round << ":";
+		}
+		const char* seat = state.turn == PLAYER ? "P" : "E";
+		if (!state.isLegal(state.turn, action))
+		{
+			std::cout << " (skipped)";
+			continue;
+		}
+		if (action.type == SHOOT_SELF_ACTION)
+		{
+			std::cout << " " << seat << " self";
+		}
+		else if (action.type == SHOOT_OPPONENT_ACTION)
+		{
+			std::cout << " " << seat << " opponent";
+		}
+		else
+		{
+			std::cout << " " << seat << " " << ITEM_NAMES[state.inventory[state.turn][action.slot]];
+		}
+		state.apply(state.turn, action);
+	}
+	std::cout << std::endl;
+}
+
+long long runInvariantCheck(long long t_matches, std::uint64_t t_seed, int t_threads)
+{
+	int threadCount = t_threads > 0 ? t_threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	const long long blockCount = (t_matches + CHECK_BLOCK_GAMES - 1) / CHECK_BLOCK_GAMES;
+	std::atomic<long long> nextBlock{ 0 };
+	std::atomic<long long> failedMatches{ 0 };
+	std::vector<long long> threadActions(threadCount);
+	std::mutex failureLock;
+	std::vector<InvariantFailure> failures;
+
+	auto worker = [&](int t_thread)
+	{
+		std::vector<Action> actions;
+		actions.reserve(1024);
+		RuleConfig rules;
+		long long actionCount = 0; // kept local, written back once at the end
+		for (long long block = nextBlock++; block < blockCount; block = nextBlock++)
+		{
+			long long lastGame = std::min((block + 1) * CHECK_BLOCK_GAMES, t_matches);
+			for (long long game = block * CHECK_BLOCK_GAMES; game < lastGame; game++)
+			{
+				std::uint64_t matchSeed = t_seed ^ (static_cast<std::uint64_t>(game) * 0xD1B54A32D192ED03ULL);
+				const char* broken = playCheckedMatch(matchSeed, rules, actions, actionCount);
+				if (broken == nullptr)
+				{
+					continue;
+				}
+				failedMatches++;
+				std::lock_guard<std::mutex> locked(failureLock);
+				if (static_cast<int>(failures.size()) < MAX_REPORTED_FAILURES)
+				{
+					failures.push_back(InvariantFailure{ matchSeed, rules, actions, broken });
+				}
+			}
+		}
+		threadActions[t_thread] = actionCount;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int thread = 1; thread < threadCount; thread++)
+	{
+		threads.emplace_back(worker, thread);
+	}
+	worker(0);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	long long actions = 0;
+	for (long long count : threadActions)
+	{
+		actions += count;
+	}
+	for (InvariantFailure& failure : failures)
+	{
+		shrinkFailure(failure);
+		printFailure(failure);
+	}
+	double perSecond = t_matches / std::max(seconds, 1e-9);
+	std::cout << t_matches << " matches, " << actions << " actions checked on " << threadCount << " threads, "
+		<< failedMatches << " failed | " << static_cast<long long>(perSecond) << " matches/s, "
+		<< perSecond * 3600.0 / 1e6 << "M matches/hour" << std::endl;
+	return failedMatches;
+}
@@ -0,0 +1,51 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Property based stress test for the MatchState rules. Plays random legal actions under random
+/// rule sets on every core and checks the match invariants after every round start and action.
+/// A failing match is replayed from its seed and shrunk to the fewest actions that still break
+/// the same invariant, then printed so it can be pasted into a bug report.
+/// Each match has its own seed, so a failure reproduces whatever the thread count.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "MatchState.h"
+
+/// <summary>
+/// name of the first invariant t_state breaks, nullptr when it's fine
+/// </summary>
+const char* checkMatchInvariants(const MatchState& t_state, const RuleConfig& t_rules);
+
+/// <summary>
+/// name of the first rule t_seat playing t_action broke going from t_before to t_after, nullptr when fine
+/// </summary>
+const char* checkActionInvariants(const MatchState& t_before, int t_seat, Action t_action, const MatchState& t_after);
+
+/// <summary>
+/// a match that broke an invariant. the deal comes from seed alone, so the actions can be
+/// replayed (or trimmed) on their own
+/// </summary>
+struct InvariantFailure
+{
+	std::uint64_t seed;
+	RuleConfig rules;
+	std::vector<Action> actions; // seat to move played each one, illegal ones are skipped on replay
+	const char* invariant;
+};
+
+/// <summary>
+/// plays t_actions from a fresh match dealt by t_seed, returns the invariant broken or nullptr
+/// </summary>
+const char* replayActions(std::uint64_t t_seed, const RuleConfig& t_rules, const std::vector<Action>& t_actions);
+
+/// <summary>
+/// removes actions while the same invariant still breaks, halves first then single actions
+/// </summary>
+void shrinkFailure(InvariantFailure& t_failure);
+
+/// <summary>
+/// entry point for "--check-invariants [matches] [seed] [threads]", returns how many matches failed
+/// </summary>
+long long runInvariantCheck(long long t_matches, std::uint64_t t_seed, int t_threads);
@@ -0,0 +1,62 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "LatencyHistogram.h"
+#include <iostream>
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration t_latency)
+{
+	long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(t_latency).count();
+	if (microseconds < 0)
+	{
+		microseconds = 0;
+	}
+	long long bucket = microseconds / BUCKET_MICROSECONDS;
+	buckets[bucket < BUCKETS ? bucket : BUCKETS - 1]++;
+	count++;
+	totalMicroseconds += microseconds;
+	if (microseconds > maxMicroseconds)
+	{
+		maxMicroseconds = microseconds;
+	}
+}
+
+void LatencyHistogram::clear()
+{
+	buckets.fill(0);
+	count = 0;
+	totalMicroseconds = 0;
+	maxMicroseconds = 0;
+}
+
+double LatencyHistogram::getPercentileMilliseconds(double t_percentile) const
+{
+	if (count == 0)
+	{
+		return 0.0;
+	}
+	long long target = static_cast<long long>(t_percentile / 100.0 * (count - 1)) + 1;
+	long long seen = 0;
+	for (int bucket = 0; bucket < BUCKETS; bucket++)
+	{
+		seen += buckets[bucket];
+		if (seen >= target)
+		{
+			return bucket == BUCKETS - 1 ? getMaxMilliseconds() : (bucket + 1) * BUCKET_MICROSECONDS / 1000.0;
+		}
+	}
+	return getMaxMilliseconds();
+}
+
+void LatencyHistogram::print(const std::string& t_label) const
+{
+	if (count == 0)
+	{
+		std::cout << t_label << ": nothing measured" << std::endl;
+		return;
+	}
+	std::cout << t_label << ": " << count << " samples, avg " << getAverageMilliseconds() << "ms, p50 " << getPercentileMilliseconds(50.0)
+		<< "ms, p95 " << getPercentileMilliseconds(95.0) << "ms, p99 " << getPercentileMilliseconds(99.0) << "ms, max " << getMaxMilliseconds() << "ms" << std::endl;
+}
@@ -0,0 +1,34 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Fixed size latency histogram, 0.25ms buckets up to 100ms plus one for anything slower.
+/// record() never allocates so it can sit on the frame path.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+
+class LatencyHistogram
+{
+public:
+	static const int BUCKET_MICROSECONDS = 250;
+	static const int BUCKETS = 400; // the last one also counts everything past 100ms
+
+	void record(std::chrono::steady_clock::duration t_latency);
+	void clear();
+
+	long long getCount() const { return count; }
+	double getMaxMilliseconds() const { return maxMicroseconds / 1000.0; }
+	double getAverageMilliseconds() const { return count == 0 ? 0.0 : totalMicroseconds / 1000.0 / count; }
+	double getPercentileMilliseconds(double t_percentile) const; // upper edge of the bucket it falls in
+
+	void print(const std::string& t_label) const;
+
+private:
+	std::array<long long, BUCKETS> buckets{};
+	long long count = 0;
+	long long totalMicroseconds = 0;
+	long long maxMicroseconds = 0;
+};
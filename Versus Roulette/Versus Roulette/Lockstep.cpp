@@ -0,0 +1,497 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Lockstep.h"
+#include "Logger.h"
+#include "Policy.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// wire format, every message is NET_MESSAGE_SIZE bytes, little endian:
+// type(1) seat(1) actionType(1) actionSlot(1) sequence(4) value(8) checksum(4)
+static const int NET_MESSAGE_SIZE = 20;
+static const std::uint64_t NET_PROTOCOL_VERSION = 1;
+
+static const int HELLO_MESSAGE = 1; // client -> host, value is the protocol version
+static const int WELCOME_MESSAGE = 2; // host -> client, value is the match seed, seat is the client's seat
+static const int ACTION_MESSAGE = 3;
+static const int PING_MESSAGE = 4; // value is the sender's clock
+static const int PONG_MESSAGE = 5; // value is the ping's clock echoed back
+static const int BYE_MESSAGE = 6;
+
+static const std::uint64_t PING_INTERVAL_MICROSECONDS = 250000;
+static const double TICK_MILLISECONDS = 1000.0 / 60.0;
+
+static void putUint(unsigned char* t_out, std::uint64_t t_value, int t_bytes)
+{
+	for (int byte = 0; byte < t_bytes; byte++)
+	{
+		t_out[byte] = static_cast<unsigned char>((t_value >> (byte * 8)) & 0xFF);
+	}
+}
+
+static std::uint64_t getUint(const unsigned char* t_in, int t_bytes)
+{
+	std::uint64_t value = 0;
+	for (int byte = 0; byte < t_bytes; byte++)
+	{
+		value |= static_cast<std::uint64_t>(t_in[byte]) << (byte * 8);
+	}
+	return value;
+}
+
+LockstepSession::LockstepSession() :
+	state{ IDLE },
+	isHost{ false },
+	localSeat{ PLAYER },
+	seed{ 0 },
+	startTime{ std::chrono::steady_clock::now() },
+	lastPingMicroseconds{ 0 },
+	smoothedRoundTripMs{ 0.0 },
+	minRoundTripMs{ 0.0 },
+	maxRoundTripMs{ 0.0 },
+	roundTripSamples{ 0 },
+	fixedInputDelay{ -1 },
+	desynced{ false }
+{
+}
+
+/// <summary>
+/// waits for one opponent on t_port, the host plays the PLAYER seat and picks the seed
+/// </summary>
+bool LockstepSession::host(unsigned short t_port)
+{
+	close();
+	if (listener.listen(t_port) != sf::Socket::Done)
+	{
+		LOG_ERROR("problem listening on port %u", static_cast<unsigned int>(t_port));
+		return false;
+	}
+	listener.setBlocking(false);
+	isHost = true;
+	localSeat = PLAYER;
+	seed = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	state = LISTENING;
+	return true;
+}
+
+/// <summary>
+/// connects to a host, the joining machine plays the ENEMY seat
+/// </summary>
+bool LockstepSession::join(const std::string& t_address, unsigned short t_port)
+{
+	close();
+	if (socket.connect(sf::IpAddress(t_address), t_port, sf::seconds(5.0f)) != sf::Socket::Done) // SFML turns Nagle off on TCP sockets
+	{
+		LOG_ERROR("problem connecting to %s:%u", t_address.c_str(), static_cast<unsigned int>(t_port));
+		return false;
+	}
+	socket.setBlocking(false);
+	isHost = false;
+	localSeat = ENEMY;
+	state = HANDSHAKING;
+	sendMessage(HELLO_MESSAGE, 0, 0, 0, 0, NET_PROTOCOL_VERSION, 0);
+	return true;
+}
+
+void LockstepSession::close()
+{
+	if (state == CONNECTED || state == HANDSHAKING)
+	{
+		sendMessage(BYE_MESSAGE, 0, 0, 0, 0, 0, 0);
+	}
+	socket.disconnect();
+	listener.close();
+	outgoing.clear();
+	incoming.clear();
+	remoteActions.clear();
+	state = IDLE;
+	desynced = false;
+	roundTripSamples = 0;
+	smoothedRoundTripMs = 0.0;
+}
+
+void LockstepSession::update()
+{
+	if (state == LISTENING)
+	{
+		if (listener.accept(socket) == sf::Socket::Done)
+		{
+			socket.setBlocking(false);
+			listener.close(); // only ever one opponent
+			state = HANDSHAKING;
+		}
+		return;
+	}
+	if (state != HANDSHAKING && state != CONNECTED)
+	{
+		return;
+	}
+
+	readIncoming();
+
+	std::uint64_t now = nowMicroseconds();
+	if (state == CONNECTED && now - lastPingMicroseconds >= PING_INTERVAL_MICROSECONDS)
+	{
+		lastPingMicroseconds = now;
+		sendMessage(PING_MESSAGE, 0, 0, 0, 0, now, 0);
+	}
+	flushOutgoing();
+}
+
+/// <summary>
+/// t_sequence is how many actions this machine has applied so far, t_checksum its state before this one
+/// </summary>
+void LockstepSession::sendAction(Action t_action, std::uint32_t t_sequence, std::uint32_t t_checksum)
+{
+	sendMessage(ACTION_MESSAGE, localSeat, t_action.type, t_action.slot, t_sequence, 0, t_checksum);
+	flushOutgoing();
+}
+
+bool LockstepSession::receiveAction(RemoteAction& t_remote)
+{
+	if (remoteActions.empty())
+	{
+		return false;
+	}
+	t_remote = remoteActions.front();
+	remoteActions.pop_front();
+	return true;
+}
+
+/// <summary>
+/// compares a remote action's stamp with this machine's state just before applying it
+/// </summary>
+bool LockstepSession::checkSync(const RemoteAction& t_remote, std::uint32_t t_localSequence, std::uint32_t t_localChecksum)
+{
+	if (t_remote.sequence != t_localSequence || t_remote.checksum != t_localChecksum)
+	{
+		if (!desynced)
+		{
+			LOG_WARNING("desync at action %u (remote %u, checksum %08x vs %08x)", t_localSequence, t_remote.sequence,
+				t_remote.checksum, t_localChecksum);
+		}
+		desynced = true;
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// ticks to hold a local action back: half the round trip (the time the other machine needs to
+/// hear about it) rounded up to whole ticks, unless a fixed delay has been set
+/// </summary>
+int LockstepSession::getInputDelay() const
+{
+	if (fixedInputDelay >= 0)
+	{
+		return fixedInputDelay;
+	}
+	int ticks = static_cast<int>(std::ceil(smoothedRoundTripMs * 0.5 / TICK_MILLISECONDS));
+	return std::min(std::max(ticks, 0), MAX_INPUT_DELAY);
+}
+
+void LockstepSession::setInputDelay(int t_ticks)
+{
+	fixedInputDelay = t_ticks < 0 ? -1 : std::min(t_ticks, MAX_INPUT_DELAY);
+}
+
+void LockstepSession::sendMessage(int t_type, int t_seat, int t_actionType, int t_actionSlot, std::uint32_t t_sequence,
+	std::uint64_t t_value, std::uint32_t t_checksum)
+{
+	unsigned char message[NET_MESSAGE_SIZE];
+	putUint(message, static_cast<std::uint64_t>(t_type), 1);
+	putUint(message + 1, static_cast<std::uint64_t>(t_seat), 1);
+	putUint(message + 2, static_cast<std::uint64_t>(t_actionType), 1);
+	putUint(message + 3, static_cast<std::uint64_t>(t_actionSlot), 1);
+	putUint(message + 4, t_sequence, 4);
+	putUint(message + 8, t_value, 8);
+	putUint(message + 16, t_checksum, 4);
+	outgoing.append(reinterpret_cast<const char*>(message), NET_MESSAGE_SIZE);
+}
+
+void LockstepSession::flushOutgoing()
+{
+	while (!outgoing.empty())
+	{
+		std::size_t sent = 0;
+		sf::Socket::Status status = socket.send(outgoing.data(), outgoing.size(), sent);
+		outgoing.erase(0, sent);
+		if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+		{
+			state = DISCONNECTED;
+			return;
+		}
+		if (status != sf::Socket::Done)
+		{
+			return; // socket buffer is full, try again next tick
+		}
+	}
+}
+
+void LockstepSession::readIncoming()
+{
+	char buffer[1024];
+	while (true)
+	{
+		std::size_t received = 0;
+		sf::Socket::Status status = socket.receive(buffer, sizeof(buffer), received);
+		if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+		{
+			state = DISCONNECTED;
+			return;
+		}
+		if (received == 0)
+		{
+			break;
+		}
+		incoming.append(buffer, received);
+	}
+
+	std::size_t offset = 0;
+	while (incoming.size() - offset >= static_cast<std::size_t>(NET_MESSAGE_SIZE))
+	{
+		handleMessage(reinterpret_cast<const unsigned char*>(incoming.data() + offset));
+		offset += NET_MESSAGE_SIZE;
+	}
+	incoming.erase(0, offset);
+}
+
+void LockstepSession::handleMessage(const unsigned char* t_message)
+{
+	int type = static_cast<int>(getUint(t_message, 1));
+	std::uint64_t value = getUint(t_message + 8, 8);
+
+	switch (type)
+	{
+	case HELLO_MESSAGE:
+		if (isHost && state == HANDSHAKING && value == NET_PROTOCOL_VERSION)
+		{
+			sendMessage(WELCOME_MESSAGE, ENEMY, 0, 0, 0, seed, 0);
+			state = CONNECTED;
+		}
+		break;
+	case WELCOME_MESSAGE:
+		if (!isHost && state == HANDSHAKING)
+		{
+			seed = value;
+			localSeat = static_cast<int>(getUint(t_message + 1, 1));
+			state = CONNECTED;
+		}
+		break;
+	case ACTION_MESSAGE:
+	{
+		RemoteAction remote;
+		remote.action.type = static_cast<int>(getUint(t_message + 2, 1));
+		remote.action.slot = static_cast<int>(getUint(t_message + 3, 1));
+		remote.sequence = static_cast<std::uint32_t>(getUint(t_message + 4, 4));
+		remote.checksum = static_cast<std::uint32_t>(getUint(t_message + 16, 4));
+		remoteActions.push_back(remote);
+		break;
+	}
+	case PING_MESSAGE:
+		sendMessage(PONG_MESSAGE, 0, 0, 0, 0, value, 0);
+		break;
+	case PONG_MESSAGE:
+	{
+		double roundTripMs = (nowMicroseconds() - value) / 1000.0;
+		if (roundTripSamples == 0)
+		{
+			smoothedRoundTripMs = roundTripMs;
+			minRoundTripMs = roundTripMs;
+			maxRoundTripMs = roundTripMs;
+		}
+		smoothedRoundTripMs = 0.875 * smoothedRoundTripMs + 0.125 * roundTripMs; // same smoothing as TCP's SRTT
+		minRoundTripMs = std::min(minRoundTripMs, roundTripMs);
+		maxRoundTripMs = std::max(maxRoundTripMs, roundTripMs);
+		roundTripSamples++;
+		break;
+	}
+	case BYE_MESSAGE:
+		state = DISCONNECTED;
+		break;
+	}
+}
+
+std::uint64_t LockstepSession::nowMicroseconds() const
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - startTime).count());
+}
+
+/// <summary>
+/// one side of the self test: its own copy of the match, the policy stands in for the keyboard
+/// </summary>
+struct SelfTestPeer
+{
+	LockstepSession session;
+	MatchState match;
+	FastRandom random;
+	HeuristicPolicy policy;
+	std::uint32_t actionsApplied = 0;
+	long long outOfTurnTries = 0; // items tried while the other machine was to move
+	long long outOfTurnSent = 0; // of those, the ones that got through, has to stay 0
+
+	void startMatch(int t_match)
+	{
+		random.seed(session.getSeed() ^ (static_cast<std::uint64_t>(t_match) * 0xD1B54A32D192ED03ULL));
+		match.reset();
+		actionsApplied = 0;
+	}
+
+	// plays one step, returns false once the match is over
+	bool step()
+	{
+		session.update();
+		if (match.isOver())
+		{
+			return false;
+		}
+		if (match.needsNewRound())
+		{
+			match.startRound(random);
+		}
+
+		RemoteAction remote;
+		if (match.turn != session.getLocalSeat())
+		{
+			tryOutOfTurnItem();
+			if (session.receiveAction(remote))
+			{
+				session.checkSync(remote, actionsApplied, match.checksum());
+				match.apply(1 - session.getLocalSeat(), remote.action);
+				actionsApplied++;
+			}
+			return true;
+		}
+
+		Action action = policy.chooseAction(Observation(match, match.turn));
+		if (!match.isLegal(match.turn, action))
+		{
+			action = shootOpponentAction();
+		}
+		submit(action);
+		return true;
+	}
+
+	// the same checks Game::submitLocalAction makes before sending, false if the action was refused
+	bool submit(Action t_action)
+	{
+		int seat = session.getLocalSeat();
+		if (!match.isLegal(seat, t_action) || !session.isLocalTurn(match))
+		{
+			return false;
+		}
+		session.sendAction(t_action, actionsApplied, match.checksum());
+		match.apply(seat, t_action);
+		actionsApplied++;
+		return true;
+	}
+
+	// a key pressed on the inventory screen during the other machine's turn, has to be refused
+	void tryOutOfTurnItem()
+	{
+		for (int slot = 0; slot < MAX_ITEMS; slot++)
+		{
+			if (match.inventory[session.getLocalSeat()][slot] != 0)
+			{
+				outOfTurnTries++;
+				outOfTurnSent += submit(useItemAction(slot)) ? 1 : 0;
+				return;
+			}
+		}
+	}
+};
+
+bool runNetworkSelfTest(unsigned short t_port, int t_matches)
+{
+	SelfTestPeer host;
+	SelfTestPeer client;
+	if (!host.session.host(t_port))
+	{
+		return false;
+	}
+	// SFML's connect blocks until the listener accepts it into the backlog, no thread needed
+	if (!client.session.join("127.0.0.1", t_port))
+	{
+		return false;
+	}
+	for (int attempt = 0; attempt < 1000 && !(host.session.isConnected() && client.session.isConnected()); attempt++)
+	{
+		host.session.update();
+		client.session.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (!host.session.isConnected() || !client.session.isConnected())
+	{
+		std::cout << "loopback handshake failed" << std::endl;
+		return false;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	long long actions = 0;
+	for (int match = 0; match < t_matches; match++)
+	{
+		host.startMatch(match);
+		client.startMatch(match);
+		bool hostPlaying = true;
+		bool clientPlaying = true;
+		while ((hostPlaying || clientPlaying) && !host.session.isDisconnected() && !client.session.isDisconnected()
+			&& !host.session.hasDesynced() && !client.session.hasDesynced())
+		{
+			hostPlaying = host.step();
+			clientPlaying = client.step();
+		}
+		if (host.session.hasDesynced() || client.session.hasDesynced())
+		{
+			std::cout << "match " << match << " desynced" << std::endl;
+			return false;
+		}
+		actions += host.actionsApplied;
+		if (host.match.checksum() != client.match.checksum())
+		{
+			std::cout << "match " << match << " ended in different states" << std::endl;
+			return false;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// let a few pings through so the round trip numbers mean something
+	for (int tick = 0; tick < 100; tick++)
+	{
+		host.session.update();
+		client.session.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	// a deliberately broken copy has to be caught on the very next action
+	host.match.reset();
+	client.match.reset();
+	client.match.health[PLAYER]++;
+	host.session.sendAction(shootOpponentAction(), host.actionsApplied, host.match.checksum());
+	RemoteAction remote;
+	for (int tick = 0; tick < 1000 && !client.session.receiveAction(remote); tick++)
+	{
+		client.session.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	bool caught = !client.session.checkSync(remote, host.actionsApplied, client.match.checksum());
+
+	long long outOfTurnTries = host.outOfTurnTries + client.outOfTurnTries;
+	long long outOfTurnSent = host.outOfTurnSent + client.outOfTurnSent;
+	bool passed = outOfTurnTries > 0 && outOfTurnSent == 0 && caught;
+	std::cout << t_matches << " matches, " << actions << " actions in " << seconds << "s"
+		<< " | rtt " << host.session.getRoundTripMs() << "ms (min " << host.session.getMinRoundTripMs()
+		<< ", max " << host.session.getMaxRoundTripMs() << ") | input delay " << host.session.getInputDelay() << " ticks"
+		<< " | out of turn items " << outOfTurnSent << " sent of " << outOfTurnTries
+		<< " | injected desync " << (caught ? "caught" : "MISSED")
+		<< " | " << (passed ? "PASSED" : "FAILED") << std::endl;
+
+	host.session.close();
+	client.session.close();
+	return passed;
+}
@@ -0,0 +1,96 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Two player network mode. Both machines run the same rules from the same seed, so only the
+/// actions are sent: each one carries the sender's action count and a MatchState checksum so
+/// a desync is caught on the very next action. Pings measure round trip time, which sets how
+/// many ticks a local action is held back so both screens play it at about the same moment.
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "MatchState.h"
+
+const unsigned short static DEFAULT_NET_PORT = 53535;
+const int static MAX_INPUT_DELAY = 12; // ticks, 200ms at 60 updates a second
+
+/// <summary>
+/// an action received from the other machine
+/// </summary>
+struct RemoteAction
+{
+	Action action;
+	std::uint32_t sequence; // actions the sender had applied before this one
+	std::uint32_t checksum; // sender's MatchState checksum before applying it
+};
+
+class LockstepSession
+{
+public:
+	LockstepSession();
+
+	bool host(unsigned short t_port);
+	bool join(const std::string& t_address, unsigned short t_port);
+	void close();
+
+	void update(); // call every tick: accepts/handshakes, reads messages, pings
+
+	bool isActive() const { return state != IDLE; }
+	bool isConnected() const { return state == CONNECTED; }
+	bool isDisconnected() const { return state == DISCONNECTED; }
+	int getLocalSeat() const { return localSeat; }
+	bool isLocalTurn(const MatchState& t_match) const { return t_match.turn == localSeat; } // only then may an action be sent
+	std::uint64_t getSeed() const { return seed; }
+
+	void sendAction(Action t_action, std::uint32_t t_sequence, std::uint32_t t_checksum);
+	bool receiveAction(RemoteAction& t_remote);
+
+	bool checkSync(const RemoteAction& t_remote, std::uint32_t t_localSequence, std::uint32_t t_localChecksum);
+	bool hasDesynced() const { return desynced; }
+
+	double getRoundTripMs() const { return smoothedRoundTripMs; }
+	double getMinRoundTripMs() const { return minRoundTripMs; }
+	double getMaxRoundTripMs() const { return maxRoundTripMs; }
+	int getInputDelay() const;
+	void setInputDelay(int t_ticks); // -1 goes back to picking it from the round trip time
+
+private:
+	enum SessionState { IDLE, LISTENING, HANDSHAKING, CONNECTED, DISCONNECTED };
+
+	void sendMessage(int t_type, int t_seat, int t_actionType, int t_actionSlot, std::uint32_t t_sequence,
+		std::uint64_t t_value, std::uint32_t t_checksum);
+	void flushOutgoing();
+	void readIncoming();
+	void handleMessage(const unsigned char* t_message);
+	std::uint64_t nowMicroseconds() const;
+
+	sf::TcpListener listener;
+	sf::TcpSocket socket;
+	SessionState state;
+	bool isHost;
+	int localSeat;
+	std::uint64_t seed;
+
+	std::string outgoing; // bytes the socket hasn't taken yet (non blocking sends can be partial)
+	std::string incoming; // bytes read that don't make a whole message yet
+	std::deque<RemoteAction> remoteActions;
+
+	std::chrono::steady_clock::time_point startTime;
+	std::uint64_t lastPingMicroseconds;
+	double smoothedRoundTripMs;
+	double minRoundTripMs;
+	double maxRoundTripMs;
+	int roundTripSamples;
+	int fixedInputDelay;
+	bool desynced;
+};
+
+/// <summary>
+/// entry point for "--net-selftest [port] [matches]": hosts and joins over loopback in one
+/// process, plays heuristic vs heuristic through the sessions and checks every checksum
+/// </summary>
+bool runNetworkSelfTest(unsigned short t_port, int t_matches);
@@ -0,0 +1,181 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Logger.h"
+#include <cstdio>
+#include <iostream>
+
+/// <summary>
+/// how long the writer sleeps when the ring is empty
+/// </summary>
+const std::chrono::milliseconds static LOG_POLL_INTERVAL{ 2 };
+
+static long long steadyMilliseconds()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+/// the first call in a new second starts the window again, a race between two threads
+/// at the edge of a window can let one extra message through, which doesn't matter
+/// </summary>
+bool LogRateLimit::allow(int& t_suppressed)
+{
+	long long now = steadyMilliseconds();
+	long long start = windowStart.load(std::memory_order_relaxed);
+	if (now - start >= 1000 && windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+	{
+		inWindow.store(0, std::memory_order_relaxed);
+	}
+	if (inWindow.fetch_add(1, std::memory_order_relaxed) < LOG_BURST)
+	{
+		t_suppressed = suppressed.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+	suppressed.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+Logger& Logger::instance()
+{
+	static Logger logger;
+	return logger;
+}
+
+Logger::Logger() :
+	ringTail(0),
+	ringHead(0),
+	written(0),
+	started(std::chrono::steady_clock::now()),
+	running(true),
+	dropped(0),
+	droppedReported(0)
+{
+	for (std::uint32_t index = 0; index < static_cast<std::uint32_t>(LOG_CAPACITY); index++)
+	{
+		entries[index].sequence.store(index, std::memory_order_relaxed);
+	}
+	thread = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger()
+{
+	running.store(false);
+	thread.join();
+}
+
+/// <summary>
+/// claims the next slot and formats into it. slot i takes tickets i, i + LOG_CAPACITY, ... in turn,
+/// so a slot the writer hasn't printed yet still has the old ticket and the ring reads as full
+/// </summary>
+bool Logger::push(int t_level, int t_suppressed, const char* t_format, va_list t_arguments)
+{
+	std::uint32_t ticket = ringTail.load(std::memory_order_relaxed);
+	Entry* entry = nullptr;
+	while (true)
+	{
+		entry = &entries[ticket & (LOG_CAPACITY - 1)];
+		std::int32_t difference = static_cast<std::int32_t>(entry->sequence.load(std::memory_order_acquire) - ticket);
+		if (difference == 0)
+		{
+			if (ringTail.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (difference < 0)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			ticket = ringTail.load(std::memory_order_relaxed); // another thread took it
+		}
+	}
+	entry->level = t_level;
+	entry->suppressed = t_suppressed;
+	entry->milliseconds = getMilliseconds();
+	std::vsnprintf(entry->text, sizeof(entry->text), t_format, t_arguments);
+	entry->sequence.store(ticket + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::flush()
+{
+	std::uint32_t target = ringTail.load(std::memory_order_acquire);
+	while (static_cast<std::int32_t>(written.load(std::memory_order_acquire) - target) < 0)
+	{
+		std::this_thread::sleep_for(LOG_POLL_INTERVAL);
+	}
+}
+
+long long Logger::getMilliseconds() const
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+}
+
+/// <summary>
+/// writer thread: prints what's waiting then sleeps a little, the ring is emptied once more on the way out
+/// </summary>
+void Logger::run()
+{
+	while (running.load(std::memory_order_relaxed))
+	{
+		if (!writeWaiting())
+		{
+			std::this_thread::sleep_for(LOG_POLL_INTERVAL);
+		}
+	}
+	while (writeWaiting())
+	{
+	}
+}
+
+bool Logger::writeWaiting()
+{
+	const char* levelNames[] = { "debug", "info", "warning", "error" };
+	bool wroteAny = false;
+	while (true)
+	{
+		Entry& entry = entries[ringHead & (LOG_CAPACITY - 1)];
+		if (entry.sequence.load(std::memory_order_acquire) != ringHead + 1)
+		{
+			break; // empty, or the next message is still being formatted
+		}
+		char stamp[32];
+		std::snprintf(stamp, sizeof(stamp), "%lld.%03lld ", entry.milliseconds / 1000, entry.milliseconds % 1000);
+		std::cout << stamp << levelNames[entry.level < 0 ? 0 : (entry.level > LOG_LEVEL_ERROR ? LOG_LEVEL_ERROR : entry.level)] << ": " << entry.text;
+		if (entry.suppressed > 0)
+		{
+			std::cout << " (" << entry.suppressed << " more like this held back)";
+		}
+		std::cout << '\n';
+		entry.sequence.store(ringHead + LOG_CAPACITY, std::memory_order_release); // free for the next lap
+		ringHead++;
+		written.store(ringHead, std::memory_order_release);
+		wroteAny = true;
+	}
+	std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+	if (droppedNow != droppedReported)
+	{
+		std::cout << "log ring full, " << droppedNow - droppedReported << " messages dropped\n";
+		droppedReported = droppedNow;
+		wroteAny = true;
+	}
+	if (wroteAny)
+	{
+		std::cout.flush();
+	}
+	return wroteAny;
+}
+
+void logMessage(int t_level, int t_suppressed, const char* t_format, ...)
+{
+	va_list arguments;
+	va_start(arguments, t_format);
+	Logger::instance().push(t_level, t_suppressed, t_format, arguments);
+	va_end(arguments);
+}
@@ -0,0 +1,119 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Leveled log for the game. A LOG_ call formats its message straight into a slot of a fixed ring that
+/// any thread can write to without waiting, and a writer thread prints the slots, flushing once per batch
+/// rather than once per line. A full ring drops the message instead of holding up the frame.
+/// Levels below LOG_COMPILED_LEVEL are taken out by the preprocessor, arguments and all, and each call
+/// site lets through LOG_BURST messages a second, the ones it holds back are counted on the next it lets through.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <thread>
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+
+#ifndef LOG_COMPILED_LEVEL
+#ifdef _DEBUG
+#define LOG_COMPILED_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_COMPILED_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+// printf style, for example LOG_WARNING("problem loading %s", file.c_str())
+#define LOG_AT(t_level, ...) \
+	do \
+	{ \
+		static LogRateLimit logRateLimit; \
+		int logSuppressed = 0; \
+		if (logRateLimit.allow(logSuppressed)) \
+		{ \
+			logMessage(t_level, logSuppressed, __VA_ARGS__); \
+		} \
+	} while (false)
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(...) LOG_AT(LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void)0)
+#endif
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+const int static LOG_BURST = 5; // messages a second from one call site
+const int static LOG_CAPACITY = 1024; // power of 2
+const int static LOG_TEXT_SIZE = 240; // longer messages are cut short
+
+/// <summary>
+/// one per call site, lets through LOG_BURST messages in each second and counts the rest.
+/// constant initialised so the static in LOG_AT needs no guard
+/// </summary>
+class LogRateLimit
+{
+public:
+	bool allow(int& t_suppressed);
+
+private:
+	std::atomic<long long> windowStart{ -1000000 }; // steady clock milliseconds, long enough ago to start a window
+	std::atomic<int> inWindow{ 0 };
+	std::atomic<int> suppressed{ 0 };
+};
+
+class Logger
+{
+public:
+	static Logger& instance(); // the writer thread starts with the first message
+
+	~Logger(); // writes whatever is still in the ring
+
+	bool push(int t_level, int t_suppressed, const char* t_format, va_list t_arguments); // any thread, never blocks
+	void flush(); // waits for the writer to print everything pushed so far
+
+	long long getMilliseconds() const;
+	std::uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+	struct Entry
+	{
+		std::atomic<std::uint32_t> sequence; // the ticket that may write it next, +1 once it's written
+		int level;
+		int suppressed;
+		long long milliseconds;
+		char text[LOG_TEXT_SIZE];
+	};
+
+	Logger();
+	void run();
+	bool writeWaiting(); // writer thread only, false if there was nothing to write
+
+	std::array<Entry, LOG_CAPACITY> entries;
+	std::atomic<std::uint32_t> ringTail; // next ticket for a writer
+	std::uint32_t ringHead; // writer thread only
+	std::atomic<std::uint32_t> written; // tickets printed, for flush
+
+	std::chrono::steady_clock::time_point started;
+	std::thread thread;
+	std::atomic<bool> running;
+	std::atomic<std::uint64_t> dropped;
+	std::uint64_t droppedReported; // writer thread only
+};
+
+void logMessage(int t_level, int t_suppressed, const char* t_format, ...);
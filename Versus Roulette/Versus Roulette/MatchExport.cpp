@@ -0,0 +1,671 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "MatchExport.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+static const char EXPORT_MAGIC[4] = { 'V', 'R', 'C', 'X' };
+static const std::uint64_t EXPORT_VERSION = 1;
+static const char EXPORT_CHUNK = 'C';
+static const char EXPORT_END = 'E';
+static const long long EXPORT_BLOCK_MATCHES = 1024; // matches a thread takes at a time
+static const int EXPORT_FILE_BUFFER = 1 << 20;
+static const std::uint64_t EXPORT_MAX_CHUNK_ROWS = 1 << 24; // anything bigger is a damaged file
+
+enum ExportEncoding
+{
+	EXPORT_PLAIN, // every value
+	EXPORT_RUNS, // (value, how many times) pairs
+	EXPORT_DELTA, // each value minus the one before, the first minus 0
+	EXPORT_PACKED, // the smallest value, a bit width, then each value minus the smallest in that many bits
+	EXPORT_ENCODINGS
+};
+
+static const char* ENCODING_NAMES[EXPORT_ENCODINGS] = { "plain", "runs", "delta", "packed" };
+
+std::string exportColumnName(int t_column)
+{
+	static const char* names[EXPORT_PLAYER_ITEM_0] = { "match", "seed", "round", "seat", "action", "item", "shot",
+		"player_health", "enemy_health", "player_health_after", "enemy_health_after" };
+	static const char* flagNames[EXPORT_COLUMNS - EXPORT_DOUBLE_DAMAGE] = { "double_damage", "player_paused", "enemy_paused",
+		"know_live", "know_blank" };
+	if (t_column < EXPORT_PLAYER_ITEM_0)
+	{
+		return names[t_column];
+	}
+	if (t_column < EXPORT_ENEMY_ITEM_0)
+	{
+		return "player_item_" + std::to_string(t_column - EXPORT_PLAYER_ITEM_0);
+	}
+	if (t_column < EXPORT_DOUBLE_DAMAGE)
+	{
+		return "enemy_item_" + std::to_string(t_column - EXPORT_ENEMY_ITEM_0);
+	}
+	return flagNames[t_column - EXPORT_DOUBLE_DAMAGE];
+}
+
+/// <summary>
+/// small negative numbers to small unsigned ones, -1 is 1, 1 is 2
+/// </summary>
+static std::uint64_t zigzag(std::int64_t t_value)
+{
+	return (static_cast<std::uint64_t>(t_value) << 1) ^ static_cast<std::uint64_t>(t_value >> 63);
+}
+
+static std::int64_t unzigzag(std::uint64_t t_value)
+{
+	return static_cast<std::int64_t>(t_value >> 1) ^ -static_cast<std::int64_t>(t_value & 1);
+}
+
+/// <summary>
+/// t_value - t_previous wrapping round like unsigned numbers do, seeds use the whole 64 bits
+/// </summary>
+static std::int64_t difference(std::int64_t t_value, std::int64_t t_previous)
+{
+	return static_cast<std::int64_t>(static_cast<std::uint64_t>(t_value) - static_cast<std::uint64_t>(t_previous));
+}
+
+static int varintSize(std::uint64_t t_value)
+{
+	int size = 1;
+	while (t_value >= 0x80)
+	{
+		t_value >>= 7;
+		size++;
+	}
+	return size;
+}
+
+/// <summary>
+/// unsigned LEB128, as in the stats export
+/// </summary>
+static void appendVarint(std::vector<char>& t_out, std::uint64_t t_value)
+{
+	while (t_value >= 0x80)
+	{
+		t_out.push_back(static_cast<char>((t_value & 0x7F) | 0x80));
+		t_value >>= 7;
+	}
+	t_out.push_back(static_cast<char>(t_value));
+}
+
+static bool readVarint(const char*& t_at, const char* t_end, std::uint64_t& t_value)
+{
+	t_value = 0;
+	for (int shift = 0; shift < 64 && t_at < t_end; shift += 7)
+	{
+		const unsigned char byte = static_cast<unsigned char>(*t_at++);
+		t_value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool readVarint(std::istream& t_in, std::uint64_t& t_value)
+{
+	t_value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		int byte = t_in.get();
+		if (byte == EOF)
+		{
+			return false;
+		}
+		t_value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static int bitWidth(std::uint64_t t_range)
+{
+	int width = 0;
+	while (t_range > 0)
+	{
+		t_range >>= 1;
+		width++;
+	}
+	return width;
+}
+
+/// <summary>
+/// sizes every encoding in one pass, then writes the smallest as encoding, byte length, bytes
+/// </summary>
+static void encodeColumn(const std::int64_t* t_values, int t_count, std::vector<char>& t_out)
+{
+	std::uint64_t sizes[EXPORT_ENCODINGS] = {};
+	std::int64_t previous = 0;
+	std::int64_t smallest = t_count > 0 ? t_values[0] : 0;
+	std::int64_t largest = smallest;
+	int run = 0;
+	for (int index = 0; index < t_count; index++)
+	{
+		smallest = std::min(smallest, t_values[index]);
+		largest = std::max(largest, t_values[index]);
+		sizes[EXPORT_PLAIN] += varintSize(zigzag(t_values[index]));
+		sizes[EXPORT_DELTA] += varintSize(zigzag(difference(t_values[index], previous)));
+		if (index > 0 && t_values[index] != previous)
+		{
+			sizes[EXPORT_RUNS] += varintSize(zigzag(previous)) + varintSize(run);
+			run = 0;
+		}
+		run++;
+		previous = t_values[index];
+	}
+	if (run > 0)
+	{
+		sizes[EXPORT_RUNS] += varintSize(zigzag(previous)) + varintSize(run);
+	}
+	const int width = bitWidth(static_cast<std::uint64_t>(largest) - static_cast<std::uint64_t>(smallest));
+	sizes[EXPORT_PACKED] = width > 56 ? std::numeric_limits<std::uint64_t>::max() // wider than the packer's 64 bit buffer can take
+		: varintSize(zigzag(smallest)) + 1 + (static_cast<std::uint64_t>(t_count) * width + 7) / 8;
+	const int encoding = static_cast<int>(std::min_element(sizes, sizes + EXPORT_ENCODINGS) - sizes);
+
+	t_out.push_back(static_cast<char>(encoding));
+	appendVarint(t_out, sizes[encoding]);
+	if (encoding == EXPORT_PACKED)
+	{
+		appendVarint(t_out, zigzag(smallest));
+		t_out.push_back(static_cast<char>(width));
+		std::uint64_t bits = 0;
+		int bitCount = 0;
+		for (int index = 0; index < t_count; index++)
+		{
+			bits |= (static_cast<std::uint64_t>(t_values[index]) - static_cast<std::uint64_t>(smallest)) << bitCount;
+			bitCount += width;
+			while (bitCount >= 8)
+			{
+				t_out.push_back(static_cast<char>(bits & 0xFF));
+				bits >>= 8;
+				bitCount -= 8;
+			}
+		}
+		if (bitCount > 0)
+		{
+			t_out.push_back(static_cast<char>(bits & 0xFF));
+		}
+		return;
+	}
+
+	previous = 0;
+	run = 0;
+	for (int index = 0; index < t_count; index++)
+	{
+		if (encoding == EXPORT_PLAIN)
+		{
+			appendVarint(t_out, zigzag(t_values[index]));
+		}
+		else if (encoding == EXPORT_DELTA)
+		{
+			appendVarint(t_out, zigzag(difference(t_values[index], previous)));
+		}
+		else if (index > 0 && t_values[index] != previous)
+		{
+			appendVarint(t_out, zigzag(previous));
+			appendVarint(t_out, static_cast<std::uint64_t>(run));
+			run = 0;
+		}
+		run++;
+		previous = t_values[index];
+	}
+	if (encoding == EXPORT_RUNS && run > 0)
+	{
+		appendVarint(t_out, zigzag(previous));
+		appendVarint(t_out, static_cast<std::uint64_t>(run));
+	}
+}
+
+/// <summary>
+/// the other way, false unless the bytes give exactly t_count values
+/// </summary>
+static bool decodeColumn(int t_encoding, const char* t_at, const char* t_end, std::int64_t* t_values, std::uint64_t t_count)
+{
+	std::uint64_t value = 0;
+	std::uint64_t index = 0;
+	std::int64_t previous = 0;
+	if (t_encoding == EXPORT_PACKED)
+	{
+		if (!readVarint(t_at, t_end, value) || t_at >= t_end)
+		{
+			return false;
+		}
+		const std::int64_t smallest = unzigzag(value);
+		const int width = static_cast<unsigned char>(*t_at++);
+		if (width > 56 || static_cast<std::uint64_t>(t_end - t_at) != (t_count * width + 7) / 8)
+		{
+			return false;
+		}
+		const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+		std::uint64_t bits = 0;
+		int bitCount = 0;
+		for (; index < t_count; index++)
+		{
+			while (bitCount < width)
+			{
+				bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(*t_at++)) << bitCount;
+				bitCount += 8;
+			}
+			t_values[index] = static_cast<std::int64_t>(static_cast<std::uint64_t>(smallest) + (bits & mask));
+			bits >>= width;
+			bitCount -= width;
+		}
+		return true;
+	}
+	while (t_at < t_end)
+	{
+		if (!readVarint(t_at, t_end, value))
+		{
+			return false;
+		}
+		if (t_encoding == EXPORT_RUNS)
+		{
+			std::uint64_t run = 0;
+			if (!readVarint(t_at, t_end, run) || run > t_count - index)
+			{
+				return false;
+			}
+			std::fill(t_values + index, t_values + index + run, unzigzag(value));
+			index += run;
+			continue;
+		}
+		if (index >= t_count)
+		{
+			return false;
+		}
+		previous = t_encoding == EXPORT_DELTA
+			? static_cast<std::int64_t>(static_cast<std::uint64_t>(previous) + static_cast<std::uint64_t>(unzigzag(value)))
+			: unzigzag(value);
+		t_values[index++] = previous;
+	}
+	return index == t_count;
+}
+
+ExportStream::ExportStream() :
+	batchRows{ 0 },
+	rows{ 0 },
+	stalls{ 0 },
+	match{ 0 },
+	seed{ 0 },
+	finished{ false }
+{
+	for (std::vector<std::int64_t>& column : columns)
+	{
+		column.resize(EXPORT_BATCH_ROWS); // the only allocation, rows are written by index
+	}
+	for (std::vector<char>& chunk : chunks)
+	{
+		freeChunks.push(&chunk);
+	}
+}
+
+void ExportStream::startMatch(std::uint64_t t_match, std::uint64_t t_seed)
+{
+	match = t_match;
+	seed = t_seed;
+}
+
+void ExportStream::finish()
+{
+	sendBatch();
+	finished.store(true, std::memory_order_release);
+}
+
+void ExportStream::onAction(const MatchState& t_before, int t_seat, Action t_action, const MatchState& t_after)
+{
+	const int row = batchRows;
+	columns[EXPORT_MATCH][row] = static_cast<std::int64_t>(match);
+	columns[EXPORT_SEED][row] = static_cast<std::int64_t>(seed);
+	columns[EXPORT_ROUND][row] = t_before.round;
+	columns[EXPORT_SEAT][row] = t_seat;
+	columns[EXPORT_ACTION][row] = t_action.type;
+	columns[EXPORT_ITEM][row] = t_action.type == USE_ITEM_ACTION ? t_before.inventory[t_seat][t_action.slot] : 0;
+	columns[EXPORT_SHOT][row] = t_after.liveRounds < t_before.liveRounds ? 1 : (t_after.blankRounds < t_before.blankRounds ? 0 : -1);
+	columns[EXPORT_PLAYER_HEALTH][row] = t_before.health[PLAYER];
+	columns[EXPORT_ENEMY_HEALTH][row] = t_before.health[ENEMY];
+	columns[EXPORT_PLAYER_HEALTH_AFTER][row] = t_after.health[PLAYER];
+	columns[EXPORT_ENEMY_HEALTH_AFTER][row] = t_after.health[ENEMY];
+	for (int slot = 0; slot < MAX_ITEMS; slot++)
+	{
+		columns[EXPORT_PLAYER_ITEM_0 + slot][row] = t_before.inventory[PLAYER][slot];
+		columns[EXPORT_ENEMY_ITEM_0 + slot][row] = t_before.inventory[ENEMY][slot];
+	}
+	columns[EXPORT_DOUBLE_DAMAGE][row] = t_before.doubleDamage;
+	columns[EXPORT_PLAYER_PAUSED][row] = t_before.paused[PLAYER];
+	columns[EXPORT_ENEMY_PAUSED][row] = t_before.paused[ENEMY];
+	columns[EXPORT_KNOW_LIVE][row] = t_before.knowItsLive;
+	columns[EXPORT_KNOW_BLANK][row] = t_before.knowItsBlank;
+
+	batchRows++;
+	rows++;
+	if (batchRows == EXPORT_BATCH_ROWS)
+	{
+		sendBatch();
+	}
+}
+
+void ExportStream::returnChunk(std::vector<char>* t_chunk)
+{
+	t_chunk->clear(); // keeps its memory for the next batch
+	freeChunks.push(t_chunk);
+}
+
+/// <summary>
+/// encodes the batch into a free chunk and queues it for the writer. every buffer is only ever in
+/// one of the two queues or held by one side, so the push to the writer can't fail
+/// </summary>
+void ExportStream::sendBatch()
+{
+	if (batchRows == 0)
+	{
+		return;
+	}
+	std::vector<char>* chunk = nullptr;
+	while (!freeChunks.pop(chunk))
+	{
+		stalls++; // the writer is a whole pool behind
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+	chunk->push_back(EXPORT_CHUNK);
+	appendVarint(*chunk, static_cast<std::uint64_t>(batchRows));
+	for (const std::vector<std::int64_t>& column : columns)
+	{
+		encodeColumn(column.data(), batchRows, *chunk);
+	}
+	filledChunks.push(chunk);
+	batchRows = 0;
+}
+
+ExportWriter::ExportWriter(const std::string& t_path, int t_streams) :
+	fileBuffer(EXPORT_FILE_BUFFER),
+	open{ false },
+	chunks{ 0 },
+	bytes{ 0 }
+{
+	file.rdbuf()->pubsetbuf(fileBuffer.data(), static_cast<std::streamsize>(fileBuffer.size()));
+	file.open(t_path, std::ios::binary);
+	open = static_cast<bool>(file);
+
+	std::vector<char> header(EXPORT_MAGIC, EXPORT_MAGIC + 4);
+	appendVarint(header, EXPORT_VERSION);
+	appendVarint(header, EXPORT_COLUMNS);
+	for (int column = 0; column < EXPORT_COLUMNS; column++)
+	{
+		const std::string name = exportColumnName(column);
+		appendVarint(header, name.size());
+		header.insert(header.end(), name.begin(), name.end());
+	}
+	file.write(header.data(), static_cast<std::streamsize>(header.size()));
+	bytes += static_cast<long long>(header.size());
+
+	for (int stream = 0; stream < t_streams; stream++)
+	{
+		streams.push_back(std::unique_ptr<ExportStream>(new ExportStream()));
+	}
+	thread = std::thread(&ExportWriter::run, this);
+}
+
+ExportWriter::~ExportWriter()
+{
+	close();
+}
+
+/// <summary>
+/// call once the simulation threads are joined, finishes any stream they didn't
+/// </summary>
+void ExportWriter::close()
+{
+	if (!thread.joinable())
+	{
+		return;
+	}
+	for (std::unique_ptr<ExportStream>& stream : streams)
+	{
+		if (!stream->isFinished())
+		{
+			stream->finish();
+		}
+	}
+	thread.join();
+
+	std::vector<char> footer(1, EXPORT_END);
+	appendVarint(footer, static_cast<std::uint64_t>(getRows()));
+	appendVarint(footer, static_cast<std::uint64_t>(chunks));
+	file.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+	bytes += static_cast<long long>(footer.size());
+	file.flush();
+	open = open && static_cast<bool>(file);
+}
+
+long long ExportWriter::getRows() const
+{
+	long long rows = 0;
+	for (const std::unique_ptr<ExportStream>& stream : streams)
+	{
+		rows += stream->getRows();
+	}
+	return rows;
+}
+
+/// <summary>
+/// writer thread body, writes chunks in the order they arrive until every stream is finished and empty
+/// </summary>
+void ExportWriter::run()
+{
+	while (true)
+	{
+		// finished is read before draining, so whatever a stream sent before finishing is drained below
+		bool allFinished = true;
+		for (const std::unique_ptr<ExportStream>& stream : streams)
+		{
+			allFinished = allFinished && stream->isFinished();
+		}
+
+		bool wrote = false;
+		for (std::unique_ptr<ExportStream>& stream : streams)
+		{
+			std::vector<char>* chunk = nullptr;
+			while (stream->popChunk(chunk))
+			{
+				file.write(chunk->data(), static_cast<std::streamsize>(chunk->size()));
+				bytes += static_cast<long long>(chunk->size());
+				chunks++;
+				stream->returnChunk(chunk);
+				wrote = true;
+			}
+		}
+		if (allFinished && !wrote)
+		{
+			return;
+		}
+		if (!wrote)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+void runMatchExport(long long t_matches, std::uint64_t t_seed, const std::string& t_path, int t_threads)
+{
+	const int threadCount = t_threads > 0 ? t_threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	ExportWriter writer(t_path, threadCount);
+	if (!writer.isOpen())
+	{
+		std::cout << "problem writing export file " << t_path << std::endl;
+		return;
+	}
+	const long long blockCount = (t_matches + EXPORT_BLOCK_MATCHES - 1) / EXPORT_BLOCK_MATCHES;
+	std::atomic<long long> nextBlock{ 0 };
+
+	auto worker = [&](int t_thread)
+	{
+		ExportStream& stream = writer.getStream(t_thread);
+		MatchState state;
+		HeuristicPolicy playerPolicy;
+		HeuristicPolicy enemyPolicy;
+		FastRandom random;
+		for (long long block = nextBlock++; block < blockCount; block = nextBlock++)
+		{
+			const long long lastMatch = std::min((block + 1) * EXPORT_BLOCK_MATCHES, t_matches);
+			for (long long match = block * EXPORT_BLOCK_MATCHES; match < lastMatch; match++)
+			{
+				// every match has its own seed so any row can be replayed on its own
+				const std::uint64_t seed = t_seed ^ (static_cast<std::uint64_t>(match) * 0xD1B54A32D192ED03ULL);
+				random.seed(seed);
+				stream.startMatch(static_cast<std::uint64_t>(match), seed);
+				playMatch(state, playerPolicy, enemyPolicy, random, DEFAULT_RULES, stream);
+			}
+		}
+		stream.finish();
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int thread = 1; thread < threadCount; thread++)
+	{
+		threads.emplace_back(worker, thread);
+	}
+	worker(0);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	writer.close();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	long long stalls = 0;
+	for (int thread = 0; thread < threadCount; thread++)
+	{
+		stalls += writer.getStream(thread).getStalls();
+	}
+	const long long rows = writer.getRows();
+	std::cout << "export: " << t_matches << " matches, " << rows << " rows in " << writer.getChunks() << " chunks, "
+		<< writer.getBytes() << " bytes (" << std::fixed << std::setprecision(2)
+		<< static_cast<double>(writer.getBytes()) / std::max(rows, 1LL) << " a row) to " << t_path << std::endl;
+	std::cout << threadCount << " threads, " << static_cast<long long>(rows / std::max(seconds, 1e-9)) << " rows/s, "
+		<< stalls << " waits for the writer" << std::endl;
+	if (!writer.isOpen())
+	{
+		std::cout << "problem writing export file " << t_path << std::endl;
+	}
+}
+
+bool runExportSummary(const std::string& t_path)
+{
+	std::ifstream in(t_path, std::ios::binary);
+	char magic[4] = {};
+	in.read(magic, 4);
+	std::uint64_t version = 0;
+	std::uint64_t columnCount = 0;
+	if (!in || !std::equal(magic, magic + 4, EXPORT_MAGIC) || !readVarint(in, version) || version != EXPORT_VERSION
+		|| !readVarint(in, columnCount) || columnCount == 0 || columnCount > 1024)
+	{
+		std::cout << t_path << " is not a match export" << std::endl;
+		return false;
+	}
+	std::vector<std::string> names(columnCount);
+	for (std::string& name : names)
+	{
+		std::uint64_t length = 0;
+		if (!readVarint(in, length) || length > 256)
+		{
+			std::cout << t_path << " has a damaged header" << std::endl;
+			return false;
+		}
+		name.resize(length);
+		in.read(&name[0], static_cast<std::streamsize>(length));
+	}
+
+	// one chunk at a time, so reading is bounded by the largest chunk too
+	std::vector<long long> columnBytes(columnCount, 0);
+	std::vector<std::int64_t> minimum(columnCount, std::numeric_limits<std::int64_t>::max());
+	std::vector<std::int64_t> maximum(columnCount, std::numeric_limits<std::int64_t>::min());
+	std::vector<std::array<long long, EXPORT_ENCODINGS>> encodings(columnCount, std::array<long long, EXPORT_ENCODINGS>{});
+	std::vector<char> bytes;
+	std::vector<std::int64_t> values;
+	std::uint64_t rows = 0;
+	std::uint64_t chunks = 0;
+	while (true)
+	{
+		const int marker = in.get();
+		if (marker == EXPORT_END)
+		{
+			break;
+		}
+		std::uint64_t chunkRows = 0;
+		if (marker != EXPORT_CHUNK || !readVarint(in, chunkRows) || chunkRows > EXPORT_MAX_CHUNK_ROWS)
+		{
+			std::cout << t_path << " is damaged or cut short after " << chunks << " chunks" << std::endl;
+			return false;
+		}
+		values.resize(chunkRows);
+		for (std::uint64_t column = 0; column < columnCount; column++)
+		{
+			const int encoding = in.get();
+			std::uint64_t length = 0;
+			if (encoding < 0 || encoding >= EXPORT_ENCODINGS || !readVarint(in, length) || length > chunkRows * 20)
+			{
+				std::cout << t_path << " has a damaged column in chunk " << chunks << std::endl;
+				return false;
+			}
+			bytes.resize(length);
+			in.read(bytes.data(), static_cast<std::streamsize>(length));
+			if (!in || !decodeColumn(encoding, bytes.data(), bytes.data() + length, values.data(), chunkRows))
+			{
+				std::cout << t_path << " has a damaged " << names[column] << " column in chunk " << chunks << std::endl;
+				return false;
+			}
+			columnBytes[column] += static_cast<long long>(length);
+			encodings[column][encoding]++;
+			for (std::int64_t value : values)
+			{
+				minimum[column] = std::min(minimum[column], value);
+				maximum[column] = std::max(maximum[column], value);
+			}
+		}
+		rows += chunkRows;
+		chunks++;
+	}
+
+	std::uint64_t footerRows = 0;
+	std::uint64_t footerChunks = 0;
+	if (!readVarint(in, footerRows) || !readVarint(in, footerChunks) || footerRows != rows || footerChunks != chunks)
+	{
+		std::cout << t_path << " footer doesn't match: " << rows << " rows in " << chunks << " chunks read" << std::endl;
+		return false;
+	}
+
+	std::cout << t_path << ": " << rows << " rows, " << chunks << " chunks, " << columnCount << " columns" << std::endl;
+	for (std::uint64_t column = 0; column < columnCount; column++)
+	{
+		std::cout << "  " << std::left << std::setw(22) << names[column] << std::right << std::setw(12) << columnBytes[column]
+			<< " bytes " << std::fixed << std::setprecision(3) << std::setw(7)
+			<< static_cast<double>(columnBytes[column]) / std::max<std::uint64_t>(rows, 1) << " a row";
+		if (rows > 0)
+		{
+			std::cout << "  " << minimum[column] << " to " << maximum[column];
+		}
+		for (int encoding = 0; encoding < EXPORT_ENCODINGS; encoding++)
+		{
+			if (encodings[column][encoding] > 0)
+			{
+				std::cout << "  " << ENCODING_NAMES[encoding] << " " << encodings[column][encoding];
+			}
+		}
+		std::cout << std::endl;
+	}
+	return true;
+}
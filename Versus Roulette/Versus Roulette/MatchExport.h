@@ -0,0 +1,138 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Per action export of simulated matches for analysis, one row per action.
+/// Each simulation thread has an ExportStream that it uses as its playMatch observer. The stream fills
+/// a batch of rows one column at a time and encodes the batch into a chunk when it's full. Full chunks
+/// go to a writer thread, which appends them to the file and hands the buffers back, so the simulation
+/// only waits when it gets ahead of the disk by a whole pool of chunks. Memory is a batch and a pool
+/// per thread, however many rows are written.
+///
+/// The file describes itself. The header is "VRCX", a version and the column names. Each chunk is
+/// 'C', its row count, and then for each column an encoding byte, a byte length and the bytes. The
+/// footer is 'E', the total rows and the number of chunks. Every value is a 64 bit integer, and
+/// each column of a chunk is written plain, as runs of (value, length), as differences
+/// from the previous value, or bit packed above its smallest value, whichever comes out smallest.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MatchState.h"
+#include "SpscQueue.h"
+
+const int static EXPORT_BATCH_ROWS = 16384; // rows per chunk
+const int static EXPORT_POOL_CHUNKS = 4; // chunk buffers per stream, a power of 2
+
+enum ExportColumn
+{
+	EXPORT_MATCH, // index of the match in the run
+	EXPORT_SEED, // FastRandom seed that replays the match
+	EXPORT_ROUND,
+	EXPORT_SEAT,
+	EXPORT_ACTION, // SHOOT_SELF_ACTION, SHOOT_OPPONENT_ACTION or USE_ITEM_ACTION
+	EXPORT_ITEM, // item used, 0 for a shot
+	EXPORT_SHOT, // 1 live, 0 blank, -1 if no shot left the taser
+	EXPORT_PLAYER_HEALTH, // before the action, the robot's choice was made from these
+	EXPORT_ENEMY_HEALTH,
+	EXPORT_PLAYER_HEALTH_AFTER,
+	EXPORT_ENEMY_HEALTH_AFTER,
+	EXPORT_PLAYER_ITEM_0, // MAX_ITEMS slots each, before the action
+	EXPORT_ENEMY_ITEM_0 = EXPORT_PLAYER_ITEM_0 + MAX_ITEMS,
+	EXPORT_DOUBLE_DAMAGE = EXPORT_ENEMY_ITEM_0 + MAX_ITEMS,
+	EXPORT_PLAYER_PAUSED,
+	EXPORT_ENEMY_PAUSED,
+	EXPORT_KNOW_LIVE,
+	EXPORT_KNOW_BLANK,
+	EXPORT_COLUMNS
+};
+
+std::string exportColumnName(int t_column);
+
+/// <summary>
+/// one simulation thread's rows, usable directly as a playMatch observer.
+/// startMatch before each match, finish once the thread has played its last one
+/// </summary>
+class ExportStream
+{
+public:
+	ExportStream();
+	ExportStream(const ExportStream&) = delete;
+	ExportStream& operator=(const ExportStream&) = delete;
+
+	void startMatch(std::uint64_t t_match, std::uint64_t t_seed);
+	void finish(); // sends the part filled batch, no rows after this
+
+	// playMatch observer hooks
+	void onRoundStart(const MatchState&) {}
+	void onAction(const MatchState& t_before, int t_seat, Action t_action, const MatchState& t_after);
+	void onMatchEnd(const MatchState&, int) {}
+
+	long long getRows() const { return rows; }
+	long long getStalls() const { return stalls; } // times a full batch had to wait for a buffer
+
+	// writer thread side
+	bool popChunk(std::vector<char>*& t_chunk) { return filledChunks.pop(t_chunk); }
+	void returnChunk(std::vector<char>* t_chunk);
+	bool isFinished() const { return finished.load(std::memory_order_acquire); }
+
+private:
+	void sendBatch();
+
+	std::vector<std::int64_t> columns[EXPORT_COLUMNS];
+	int batchRows;
+	long long rows;
+	long long stalls;
+	std::uint64_t match;
+	std::uint64_t seed;
+
+	std::vector<char> chunks[EXPORT_POOL_CHUNKS];
+	SpscQueue<std::vector<char>*, EXPORT_POOL_CHUNKS> filledChunks; // to the writer
+	SpscQueue<std::vector<char>*, EXPORT_POOL_CHUNKS> freeChunks; // back from the writer
+	std::atomic<bool> finished;
+};
+
+/// <summary>
+/// the file and its writer thread, one stream per simulation thread
+/// </summary>
+class ExportWriter
+{
+public:
+	ExportWriter(const std::string& t_path, int t_streams);
+	~ExportWriter();
+
+	bool isOpen() const { return open; }
+	ExportStream& getStream(int t_stream) { return *streams[t_stream]; }
+	void close(); // waits for every stream to finish, then writes the footer
+
+	long long getRows() const;
+	long long getChunks() const { return chunks; }
+	long long getBytes() const { return bytes; }
+
+private:
+	void run();
+
+	std::vector<char> fileBuffer; // before file, so it outlives the file's last flush
+	std::ofstream file;
+	bool open;
+	std::vector<std::unique_ptr<ExportStream>> streams;
+	std::thread thread;
+	long long chunks; // writer thread until close
+	long long bytes;
+};
+
+/// <summary>
+/// entry point for "--export [matches] [seed] [file] [threads]", heuristic vs heuristic, t_threads 0 uses every core
+/// </summary>
+void runMatchExport(long long t_matches, std::uint64_t t_seed, const std::string& t_path, int t_threads);
+
+/// <summary>
+/// entry point for "--export-read [file]": decodes every chunk, checks the row counts against the footer
+/// and prints each column's size and encodings. false if the file is damaged
+/// </summary>
+bool runExportSummary(const std::string& t_path);
@@ -0,0 +1,517 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "MatchGrid.h"
+#include "Globals.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+#include "RenderBackend.h"
+#include "TextureCache.h"
+#include "Tournament.h"
+#include "TripleBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int static GRID_WINDOW_WIDTH = 1280;
+const int static GRID_WINDOW_HEIGHT = 990;
+const int static GRID_TITLE_HEIGHT = 30;
+const int static GRID_GAP = 2; // pixels between cells
+const int static GRID_ACTION_TICKS = 20; // shortest wait after a move, up to twice this
+const int static GRID_ROUND_TICKS = 30;
+const int static GRID_OVER_TICKS = 120; // the result stays up this long before the next match
+const int static GRID_FLASH_TICKS = 20;
+const int static GRID_FRAME_WIDTH = 192; // first frame of the robot sheets
+const int static GRID_FRAME_HEIGHT = 128;
+
+enum GridLayer
+{
+	GRID_GAMEPLAY,
+	GRID_UPPER_BAR,
+	GRID_TABLE,
+	GRID_PLAYER_HEALTH,
+	GRID_ENEMY_HEALTH,
+	GRID_PLAYER_ROBOT,
+	GRID_ENEMY_ROBOT,
+	GRID_LIVE_TASER,
+	GRID_EMPTY_TASER,
+	GRID_ITEMS,
+	GRID_SHAPES, // untextured: shot pips and turn markers
+	GRID_LAYERS
+};
+
+/// <summary>
+/// one match as its worker sees it
+/// </summary>
+struct GridMatch
+{
+	MatchState state;
+	FastRandom random;
+	AnyPolicy policies[2];
+	int wait; // ticks until the next move
+	int flashTicks[2];
+	bool finished; // the result is showing
+};
+
+/// <summary>
+/// a thread playing a block of the grid's matches at 60 ticks a second
+/// </summary>
+struct GridWorker
+{
+	std::vector<GridMatch> matches;
+	TripleBuffer<GridSlice> buffer;
+	int first = 0;
+	std::thread thread;
+};
+
+/// <summary>
+/// where a cell sits in the window and how much it's shrunk
+/// </summary>
+struct GridViewport
+{
+	float x;
+	float y;
+	float scale;
+};
+
+/// <summary>
+/// one tick of a cell: waits out its pause, then starts a round, makes a move or moves on to a new match
+/// </summary>
+static void tickGridMatch(GridMatch& t_match, long long& t_games)
+{
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		if (t_match.flashTicks[seat] > 0)
+		{
+			t_match.flashTicks[seat]--;
+		}
+	}
+	if (t_match.wait > 0)
+	{
+		t_match.wait--;
+		return;
+	}
+
+	MatchState& state = t_match.state;
+	if (state.isOver() || state.isOutOfRounds())
+	{
+		if (!t_match.finished)
+		{
+			t_match.finished = true;
+			t_match.wait = GRID_OVER_TICKS;
+			t_games++;
+			return;
+		}
+		t_match.finished = false;
+		state.reset();
+	}
+	if (state.needsNewRound())
+	{
+		state.startRound(t_match.random);
+		t_match.wait = GRID_ROUND_TICKS;
+		return;
+	}
+
+	const int seat = state.turn;
+	Action action = t_match.policies[seat].chooseAction(Observation(state, seat));
+	if (!state.isLegal(seat, action))
+	{
+		action = shootOpponentAction();
+	}
+	const int health[2] = { state.health[PLAYER], state.health[ENEMY] };
+	state.apply(seat, action);
+	for (int target = PLAYER; target <= ENEMY; target++)
+	{
+		if (state.health[target] < health[target])
+		{
+			t_match.flashTicks[target] = GRID_FLASH_TICKS;
+		}
+	}
+	t_match.wait = GRID_ACTION_TICKS + t_match.random.nextInt(GRID_ACTION_TICKS);
+}
+
+/// <summary>
+/// worker thread body, ticks every match it owns then publishes them all, on a fixed 60Hz schedule
+/// </summary>
+static void runGridWorker(GridWorker& t_worker, const std::atomic<bool>& t_running)
+{
+	const std::chrono::nanoseconds tickLength(1000000000LL / 60);
+	std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now();
+	long long games = 0;
+	while (t_running.load(std::memory_order_relaxed))
+	{
+		for (GridMatch& match : t_worker.matches)
+		{
+			tickGridMatch(match, games);
+		}
+
+		GridSlice& slice = t_worker.buffer.back();
+		slice.first = t_worker.first;
+		slice.count = static_cast<int>(t_worker.matches.size());
+		slice.games = games;
+		for (int index = 0; index < slice.count; index++)
+		{
+			const GridMatch& match = t_worker.matches[index];
+			slice.cells[index].state = match.state;
+			slice.cells[index].flashTicks[PLAYER] = match.flashTicks[PLAYER];
+			slice.cells[index].flashTicks[ENEMY] = match.flashTicks[ENEMY];
+		}
+		t_worker.buffer.publish();
+
+		nextTick += tickLength;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (nextTick < now)
+		{
+			nextTick = now; // fell behind, don't try to catch up in a burst
+		}
+		std::this_thread::sleep_until(nextTick);
+	}
+}
+
+/// <summary>
+/// adds t_texture drawn over t_area of the 800x600 screen to a cell, cut at the screen's edges so
+/// nothing spills into the next cell. t_flip mirrors it left to right
+/// </summary>
+static void appendClipped(sf::VertexArray& t_vertices, const GridViewport& t_cell, const sf::FloatRect& t_area,
+	const sf::FloatRect& t_texture, const sf::Color& t_colour, bool t_flip = false)
+{
+	const float left = std::max(t_area.left, 0.0f);
+	const float top = std::max(t_area.top, 0.0f);
+	const float right = std::min(t_area.left + t_area.width, SCREEN_WIDTH);
+	const float bottom = std::min(t_area.top + t_area.height, SCREEN_HEIGHT);
+	if (right <= left || bottom <= top)
+	{
+		return;
+	}
+
+	// how far across the area each cut edge is, then the same distance across the texture
+	float leftShare = (left - t_area.left) / t_area.width;
+	float rightShare = (right - t_area.left) / t_area.width;
+	if (t_flip)
+	{
+		leftShare = 1.0f - leftShare;
+		rightShare = 1.0f - rightShare;
+	}
+	const float textureLeft = t_texture.left + t_texture.width * leftShare;
+	const float textureRight = t_texture.left + t_texture.width * rightShare;
+	const float textureTop = t_texture.top + t_texture.height * (top - t_area.top) / t_area.height;
+	const float textureBottom = t_texture.top + t_texture.height * (bottom - t_area.top) / t_area.height;
+
+	const float x0 = t_cell.x + left * t_cell.scale;
+	const float x1 = t_cell.x + right * t_cell.scale;
+	const float y0 = t_cell.y + top * t_cell.scale;
+	const float y1 = t_cell.y + bottom * t_cell.scale;
+	t_vertices.append(sf::Vertex(sf::Vector2f(x0, y0), t_colour, sf::Vector2f(textureLeft, textureTop)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(x1, y0), t_colour, sf::Vector2f(textureRight, textureTop)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(x1, y1), t_colour, sf::Vector2f(textureRight, textureBottom)));
+	t_vertices.append(sf::Vertex(sf::Vector2f(x0, y1), t_colour, sf::Vector2f(textureLeft, textureBottom)));
+}
+
+/// <summary>
+/// an untextured rectangle in a cell, for the shapes layer
+/// </summary>
+static void appendShape(sf::VertexArray& t_vertices, const GridViewport& t_cell, const sf::FloatRect& t_area, const sf::Color& t_colour)
+{
+	appendClipped(t_vertices, t_cell, t_area, sf::FloatRect(0.0f, 0.0f, 0.0f, 0.0f), t_colour);
+}
+
+static sf::FloatRect toFloatRect(const sf::IntRect& t_rect)
+{
+	return sf::FloatRect(static_cast<float>(t_rect.left), static_cast<float>(t_rect.top),
+		static_cast<float>(t_rect.width), static_cast<float>(t_rect.height));
+}
+
+/// <summary>
+/// adds every layer of one cell, the same positions as Game::render at t_cell's scale
+/// </summary>
+static void appendCell(sf::VertexArray (&t_layers)[GRID_LAYERS], const sf::Texture (&t_textures)[GRID_LAYERS],
+	const GridViewport& t_cell, const GridCell& t_grid)
+{
+	const sf::IntRect playerBatteryRects[STARTING_HEALTH + 1] = { PLAYER_BATTERY_0_RECT, PLAYER_BATTERY_1_RECT, PLAYER_BATTERY_2_RECT,
+		PLAYER_BATTERY_3_RECT, PLAYER_BATTERY_4_RECT, PLAYER_BATTERY_5_RECT };
+	const sf::IntRect enemyBatteryRects[STARTING_HEALTH + 1] = { ENEMY_BATTERY_0_RECT, ENEMY_BATTERY_1_RECT, ENEMY_BATTERY_2_RECT,
+		ENEMY_BATTERY_3_RECT, ENEMY_BATTERY_4_RECT, ENEMY_BATTERY_5_RECT };
+	const sf::IntRect itemRects[RUBBISH_BIN + 1] = { NULL_RECT, OIL_DRINK_RECT, SCANNER_RECT, PAUSE_REMOTE_RECT, OVERCHARGER_RECT, RUBBISH_BIN_RECT };
+	const sf::Vector2f itemPositions[2][MAX_ITEMS] =
+	{
+		{ {292, 470}, {280, 505}, {217, 470}, {205, 505} },
+		{ {477, 470}, {494, 505}, {552, 470}, {567, 505} }
+	};
+	const sf::Color white = sf::Color::White;
+	const MatchState& state = t_grid.state;
+	const bool over = state.isOver() || state.isOutOfRounds();
+	const int winner = over ? state.winner() : -1;
+
+	// the full screen backgrounds
+	for (int layer = GRID_GAMEPLAY; layer <= GRID_TABLE; layer++)
+	{
+		const sf::Vector2u size = t_textures[layer].getSize();
+		const float top = layer == GRID_TABLE ? 50.0f : 0.0f;
+		appendClipped(t_layers[layer], t_cell, sf::FloatRect(0.0f, top, static_cast<float>(size.x), static_cast<float>(size.y)),
+			sf::FloatRect(0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y)), white);
+	}
+
+	// batteries, both sprites are mirrored in Game so their positions are their right edges
+	appendClipped(t_layers[GRID_PLAYER_HEALTH], t_cell, sf::FloatRect(86.0f, 250.0f, 64.0f, 64.0f),
+		toFloatRect(playerBatteryRects[std::min(std::max(state.health[PLAYER], 0), STARTING_HEALTH)]), white, true);
+	appendClipped(t_layers[GRID_ENEMY_HEALTH], t_cell, sf::FloatRect(656.0f, 250.0f, 64.0f, 64.0f),
+		toFloatRect(enemyBatteryRects[std::min(std::max(state.health[ENEMY], 0), STARTING_HEALTH)]), white, true);
+
+	// robots, red while tased, blue while paused, dark once they've lost
+	const float robotLeft[2] = { -25.0f, 350.0f };
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		sf::Color tint = white;
+		if (over && winner != seat)
+		{
+			tint = sf::Color(80, 80, 80);
+		}
+		else if (t_grid.flashTicks[seat] > 0)
+		{
+			tint = sf::Color(255, 110, 110);
+		}
+		else if (state.paused[seat])
+		{
+			tint = sf::Color(140, 170, 255);
+		}
+		appendClipped(t_layers[seat == PLAYER ? GRID_PLAYER_ROBOT : GRID_ENEMY_ROBOT], t_cell,
+			sf::FloatRect(robotLeft[seat], 300.0f, GRID_FRAME_WIDTH * 2.5f, GRID_FRAME_HEIGHT * 2.5f),
+			sf::FloatRect(0.0f, 0.0f, static_cast<float>(GRID_FRAME_WIDTH), static_cast<float>(GRID_FRAME_HEIGHT)), tint);
+	}
+
+	// taser counts, a pip under each icon per shot left
+	appendClipped(t_layers[GRID_LIVE_TASER], t_cell, sf::FloatRect(500.0f, 0.0f, 64.0f, 64.0f), sf::FloatRect(0.0f, 0.0f, 64.0f, 64.0f), white);
+	appendClipped(t_layers[GRID_EMPTY_TASER], t_cell, sf::FloatRect(630.0f, 0.0f, 64.0f, 64.0f), sf::FloatRect(0.0f, 0.0f, 64.0f, 64.0f), white);
+	for (int shot = 0; shot < state.liveRounds; shot++)
+	{
+		appendShape(t_layers[GRID_SHAPES], t_cell, sf::FloatRect(500.0f + shot * 14.0f, 66.0f, 10.0f, 10.0f), sf::Color(230, 60, 60));
+	}
+	for (int shot = 0; shot < state.blankRounds; shot++)
+	{
+		appendShape(t_layers[GRID_SHAPES], t_cell, sf::FloatRect(630.0f + shot * 14.0f, 66.0f, 10.0f, 10.0f), sf::Color(200, 200, 200));
+	}
+
+	// whose turn it is, or who won
+	const int marked = over ? winner : state.turn;
+	if (marked == PLAYER || marked == ENEMY)
+	{
+		const sf::Color colour = over ? sf::Color(90, 230, 90) : sf::Color(255, 220, 60);
+		appendShape(t_layers[GRID_SHAPES], t_cell, sf::FloatRect(marked == PLAYER ? 100.0f : 500.0f, 582.0f, 200.0f, 12.0f), colour);
+	}
+
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		for (int slot = 0; slot < MAX_ITEMS; slot++)
+		{
+			const int item = state.inventory[seat][slot];
+			if (item > 0 && item <= RUBBISH_BIN)
+			{
+				appendClipped(t_layers[GRID_ITEMS], t_cell, sf::FloatRect(itemPositions[seat][slot].x, itemPositions[seat][slot].y, 32.0f, 32.0f),
+					toFloatRect(itemRects[item]), white);
+			}
+		}
+	}
+}
+
+void runMatchGrid(int t_matches, std::uint64_t t_seed, int t_threads)
+{
+	const int matches = std::min(std::max(t_matches, MIN_GRID_MATCHES), MAX_GRID_MATCHES);
+	int threads = t_threads > 0 ? t_threads : static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	threads = std::min(std::max(threads, 1), matches);
+
+	// every AI but the solver, whose table would be built once per thread
+	std::vector<TournamentEntrant> entrants = defaultEntrants(t_seed);
+	entrants.erase(std::remove_if(entrants.begin(), entrants.end(),
+		[](const TournamentEntrant& t_entrant) { return t_entrant.name == "solver"; }), entrants.end());
+	const int entrantCount = static_cast<int>(entrants.size());
+
+	// contiguous blocks, the first few one larger
+	std::vector<std::unique_ptr<GridWorker>> workers;
+	int first = 0;
+	for (int index = 0; index < threads; index++)
+	{
+		std::unique_ptr<GridWorker> worker(new GridWorker());
+		worker->first = first;
+		const int count = matches / threads + (index < matches % threads ? 1 : 0);
+		for (int cell = first; cell < first + count; cell++)
+		{
+			GridMatch match;
+			match.random.seed(t_seed + static_cast<std::uint64_t>(cell) * 0x9E3779B97F4A7C15ULL);
+			match.policies[PLAYER] = entrants[cell % entrantCount].make();
+			match.policies[ENEMY] = entrants[(cell / entrantCount + cell + 1) % entrantCount].make();
+			match.wait = match.random.nextInt(GRID_ROUND_TICKS); // so the cells don't all move together
+			match.flashTicks[PLAYER] = 0;
+			match.flashTicks[ENEMY] = 0;
+			match.finished = false;
+			match.state.reset();
+			worker->matches.push_back(std::move(match));
+		}
+		first += count;
+		workers.push_back(std::move(worker));
+	}
+
+	sf::Texture textures[GRID_LAYERS];
+	const char* files[GRID_LAYERS] =
+	{
+		"ASSETS\\IMAGES\\gameplay screen.png",
+		"ASSETS\\IMAGES\\upperBar.png",
+		"ASSETS\\IMAGES\\table.png",
+		"ASSETS\\IMAGES\\playerHealth.png",
+		"ASSETS\\IMAGES\\enemyHealth.png",
+		"ASSETS\\IMAGES\\player shoot blank sheet.png",
+		"ASSETS\\IMAGES\\enemy shoot blank sheet.png",
+		"ASSETS\\IMAGES\\liveTaserCharge.png",
+		"ASSETS\\IMAGES\\emptyTaserCharge.png",
+		"ASSETS\\IMAGES\\Item-Sheet.png",
+		nullptr
+	};
+	for (int layer = 0; layer < GRID_LAYERS; layer++)
+	{
+		if (files[layer] != nullptr && !loadTextureCached(textures[layer], files[layer]))
+		{
+			LOG_ERROR("problem loading %s", files[layer]);
+		}
+		textures[layer].setSmooth(true); // the cells are a fraction of the size the art was drawn at
+	}
+
+	// cells keep the screen's 4:3 in as square a grid as fits
+	const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(matches))));
+	const int rows = (matches + columns - 1) / columns;
+	const float cellWidth = std::min(static_cast<float>(GRID_WINDOW_WIDTH) / columns,
+		static_cast<float>(GRID_WINDOW_HEIGHT - GRID_TITLE_HEIGHT) / rows * SCREEN_WIDTH / SCREEN_HEIGHT);
+	const float cellHeight = cellWidth * SCREEN_HEIGHT / SCREEN_WIDTH;
+	std::vector<GridViewport> viewports(matches);
+	for (int cell = 0; cell < matches; cell++)
+	{
+		viewports[cell].x = (cell % columns) * cellWidth + GRID_GAP / 2.0f;
+		viewports[cell].y = GRID_TITLE_HEIGHT + (cell / columns) * cellHeight + GRID_GAP / 2.0f;
+		viewports[cell].scale = (cellWidth - GRID_GAP) / SCREEN_WIDTH;
+	}
+
+	sf::VertexArray layers[GRID_LAYERS];
+	for (int layer = 0; layer < GRID_LAYERS; layer++)
+	{
+		layers[layer].setPrimitiveType(sf::Quads);
+	}
+	std::vector<GridCell> cells(matches);
+	for (int cell = 0; cell < matches; cell++)
+	{
+		cells[cell].state.reset();
+		cells[cell].flashTicks[PLAYER] = 0;
+		cells[cell].flashTicks[ENEMY] = 0;
+	}
+	std::vector<long long> games(threads, 0);
+
+	std::atomic<bool> running{ true };
+	for (std::unique_ptr<GridWorker>& worker : workers)
+	{
+		GridWorker* owned = worker.get();
+		worker->thread = std::thread([owned, &running]() { runGridWorker(*owned, running); });
+	}
+
+	sf::RenderWindow window{ sf::VideoMode{ static_cast<unsigned int>(GRID_WINDOW_WIDTH), static_cast<unsigned int>(GRID_WINDOW_HEIGHT), 32U }, "Versus Roulette - match grid" };
+	window.setFramerateLimit(60);
+	WindowRenderBackend renderer(window);
+	sf::Font font;
+	if (!font.loadFromFile("ASSETS\\FONTS\\ariblk.ttf"))
+	{
+		LOG_ERROR("problem loading arial black font");
+	}
+	sf::Text title;
+	title.setFont(font);
+	title.setCharacterSize(16U);
+	title.setFillColor(sf::Color::White);
+	title.setPosition(10.0f, 5.0f);
+
+	LatencyHistogram frameTimes;
+	long long lateFrames = 0;
+	long long frames = 0;
+	long long totalGames = 0;
+	int frameDrawCalls = 0;
+	std::chrono::steady_clock::time_point lastFrame = std::chrono::steady_clock::now();
+	while (window.isOpen())
+	{
+		sf::Event newEvent;
+		while (window.pollEvent(newEvent))
+		{
+			if (sf::Event::Closed == newEvent.type
+				|| (sf::Event::KeyPressed == newEvent.type && sf::Keyboard::Escape == newEvent.key.code))
+			{
+				window.close();
+			}
+		}
+
+		// the latest tick from each worker, a worker that hasn't ticked since keeps its last one
+		totalGames = 0;
+		for (int index = 0; index < threads; index++)
+		{
+			TripleBuffer<GridSlice>& buffer = workers[index]->buffer;
+			if (buffer.consume())
+			{
+				const GridSlice& slice = buffer.front();
+				std::copy(slice.cells, slice.cells + slice.count, cells.begin() + slice.first);
+				games[index] = slice.games;
+			}
+			totalGames += games[index];
+		}
+
+		for (int layer = 0; layer < GRID_LAYERS; layer++)
+		{
+			layers[layer].clear(); // keeps its memory, so after the first frame this doesn't allocate
+		}
+		for (int cell = 0; cell < matches; cell++)
+		{
+			appendCell(layers, textures, viewports[cell], cells[cell]);
+		}
+		if (frames % 30 == 0)
+		{
+			title.setString(std::to_string(matches) + " matches on " + std::to_string(threads) + " threads, "
+				+ std::to_string(totalGames) + " games played, " + std::to_string(frameDrawCalls) + " draws a frame");
+		}
+
+		renderer.clear(sf::Color::Black);
+		for (int layer = 0; layer < GRID_LAYERS; layer++)
+		{
+			if (layers[layer].getVertexCount() > 0)
+			{
+				sf::RenderStates states;
+				states.texture = layer == GRID_SHAPES ? nullptr : &textures[layer];
+				renderer.draw(layers[layer], states);
+			}
+		}
+		renderer.draw(title);
+		frameDrawCalls = renderer.getFrameDrawCalls();
+		renderer.display();
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (frames > 0)
+		{
+			frameTimes.record(now - lastFrame);
+			if (now - lastFrame > std::chrono::microseconds(20000))
+			{
+				lateFrames++;
+			}
+		}
+		lastFrame = now;
+		frames++;
+	}
+
+	running.store(false, std::memory_order_relaxed);
+	for (std::unique_ptr<GridWorker>& worker : workers)
+	{
+		worker->thread.join();
+	}
+
+	std::cout << "grid: " << matches << " matches on " << threads << " threads, " << totalGames << " games played" << std::endl;
+	std::cout << "  " << frames << " frames, " << frameDrawCalls << " draw calls a frame, "
+		<< lateFrames << " frames over 20ms" << std::endl;
+	frameTimes.print("frame");
+}
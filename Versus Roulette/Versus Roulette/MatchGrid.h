@@ -0,0 +1,42 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Window showing a grid of 16 to 64 AI matches at once, each cell a small copy of the gameplay screen.
+/// The matches are played on worker threads, each with its own block of cells that it hands over
+/// through a triple buffer once a tick, so drawing never waits on a decision. Every texture is loaded
+/// once and shared by all the cells, and each frame puts every cell's copy of a texture into the same
+/// vertex array, so a frame is one draw per texture plus the title whatever the number of matches.
+#pragma once
+
+#include <cstdint>
+#include "MatchState.h"
+
+const int static MIN_GRID_MATCHES = 16;
+const int static MAX_GRID_MATCHES = 64;
+
+/// <summary>
+/// one cell as a worker last left it
+/// </summary>
+struct GridCell
+{
+	MatchState state;
+	int flashTicks[2]; // counts down after a seat was tased
+};
+
+/// <summary>
+/// a worker's block of cells, what goes through its triple buffer
+/// </summary>
+struct GridSlice
+{
+	int first; // index of cells[0] in the whole grid
+	int count;
+	long long games; // finished by this worker so far
+	GridCell cells[MAX_GRID_MATCHES];
+};
+
+/// <summary>
+/// entry point for "--grid [matches] [seed] [threads]", t_threads 0 uses every core but one,
+/// prints the frame times and draw calls when the window is closed
+/// </summary>
+void runMatchGrid(int t_matches, std::uint64_t t_seed, int t_threads);
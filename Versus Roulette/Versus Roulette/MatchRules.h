@@ -0,0 +1,40 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Rule sets fixed at compile time. The game, MatchState and the UI are built around ClassicRules,
+/// Globals.h takes MAX_SHOTS and MAX_ITEMS from it. BasicMatchState is specialised per rule set, so
+/// bigger magazines, more slots or more health get storage sized to match, and played with the
+/// rule set itself every size and count is a constant the compiler can unroll. A RuleConfig can
+/// stand in for the rules at runtime, as long as it fits the storage.
+#pragma once
+
+const int static RULE_ITEM_TYPES = 5; // OIL_DRINK to RUBBISH_BIN, the same for every variant
+
+template <int MAGAZINE, int SLOTS, int HEALTH, int ITEMS_PER_ROUND_, int ROUNDS = 100>
+struct FixedRules
+{
+	static_assert(MAGAZINE >= 2 && MAGAZINE <= 64, "the taser needs a live and a blank and is kept in 64 bits");
+	static_assert(ITEMS_PER_ROUND_ >= 0 && ITEMS_PER_ROUND_ <= SLOTS, "can't deal more items than there are slots");
+
+	// storage
+	static constexpr int SHOT_CAPACITY = MAGAZINE;
+	static constexpr int ITEM_CAPACITY = SLOTS;
+
+	// the rules themselves, read through an instance so runtime rules can stand in
+	static constexpr int magazineSize = MAGAZINE;
+	static constexpr int itemSlots = SLOTS;
+	static constexpr int startingHealth = HEALTH;
+	static constexpr int itemsPerRound = ITEMS_PER_ROUND_;
+	static constexpr int maxRounds = ROUNDS;
+
+	/// <summary>
+	/// every item equally likely, the draw the game makes
+	/// </summary>
+	template <typename Random>
+	static int drawItem(Random& t_random) { return t_random.nextInt(RULE_ITEM_TYPES) + 1; }
+	static constexpr int itemWeight(int /*t_type*/) { return 1; }
+	static constexpr int totalItemWeight() { return RULE_ITEM_TYPES; }
+};
+
+using ClassicRules = FixedRules<6, 4, 5, 2>; // what the game plays
@@ -0,0 +1,919 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "MatchServer.h"
+#include <iostream>
+
+// where each field lives in MatchView::field
+static const int VIEW_ROUND = 0;
+static const int VIEW_LOADED_SHOTS = 1;
+static const int VIEW_LIVE_ROUNDS = 2;
+static const int VIEW_BLANK_ROUNDS = 3;
+static const int VIEW_HEALTH = 4; // PLAYER, ENEMY
+static const int VIEW_INVENTORY = 6; // PLAYER slots then ENEMY slots
+static const int VIEW_TURN = VIEW_INVENTORY + 2 * MAX_ITEMS;
+static const int VIEW_DOUBLE_DAMAGE = VIEW_TURN + 1;
+static const int VIEW_PAUSED = VIEW_DOUBLE_DAMAGE + 1; // PLAYER, ENEMY
+static const int VIEW_KNOW_LIVE = VIEW_PAUSED + 2;
+static const int VIEW_KNOW_BLANK = VIEW_KNOW_LIVE + 1;
+static const int VIEW_MASK_BYTES = 3;
+
+static_assert(VIEW_KNOW_BLANK + 1 == MatchView::FIELDS, "MatchView::FIELDS is out of date");
+static_assert(MatchView::FIELDS <= VIEW_MASK_BYTES * 8, "MatchView bitmask is too small");
+
+int encodeFieldDelta(const signed char* t_fields, const signed char* t_previous, int t_count, unsigned char* t_out)
+{
+	int maskBytes = fieldMaskBytes(t_count);
+	int written = maskBytes;
+	for (int byte = 0; byte < maskBytes; byte++)
+	{
+		t_out[byte] = 0;
+	}
+	for (int index = 0; index < t_count; index++)
+	{
+		if (t_fields[index] != t_previous[index])
+		{
+			t_out[index / 8] |= static_cast<unsigned char>(1u << (index % 8));
+			t_out[written++] = static_cast<unsigned char>(t_fields[index]);
+		}
+	}
+	return written;
+}
+
+int applyFieldDelta(signed char* t_fields, int t_count, const unsigned char* t_in)
+{
+	int read = fieldMaskBytes(t_count);
+	for (int index = 0; index < t_count; index++)
+	{
+		if (t_in[index / 8] & (1u << (index % 8)))
+		{
+			t_fields[index] = static_cast<signed char>(t_in[read++]);
+		}
+	}
+	return read;
+}
+
+int fieldDeltaSize(const unsigned char* t_in, int t_count)
+{
+	int size = fieldMaskBytes(t_count);
+	for (int index = 0; index < t_count; index++)
+	{
+		if (t_in[index / 8] & (1u << (index % 8)))
+		{
+			size++;
+		}
+	}
+	return size;
+}
+
+void MatchView::fromState(const MatchState& t_state)
+{
+	field[VIEW_ROUND] = static_cast<signed char>(t_state.round);
+	field[VIEW_LOADED_SHOTS] = static_cast<signed char>(t_state.currentLoadedShots);
+	field[VIEW_LIVE_ROUNDS] = static_cast<signed char>(t_state.liveRounds);
+	field[VIEW_BLANK_ROUNDS] = static_cast<signed char>(t_state.blankRounds);
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		field[VIEW_HEALTH + seat] = static_cast<signed char>(t_state.health[seat]);
+		field[VIEW_PAUSED + seat] = t_state.paused[seat];
+		for (int slot = 0; slot < MAX_ITEMS; slot++)
+		{
+			field[VIEW_INVENTORY + seat * MAX_ITEMS + slot] = static_cast<signed char>(t_state.inventory[seat][slot]);
+		}
+	}
+	field[VIEW_TURN] = static_cast<signed char>(t_state.turn);
+	field[VIEW_DOUBLE_DAMAGE] = t_state.doubleDamage;
+	field[VIEW_KNOW_LIVE] = t_state.knowItsLive;
+	field[VIEW_KNOW_BLANK] = t_state.knowItsBlank;
+}
+
+void MatchView::toState(MatchState& t_state) const
+{
+	t_state.round = field[VIEW_ROUND];
+	for (int index = 0; index < MAX_SHOTS; index++)
+	{
+		t_state.taserArray[index] = 0;
+	}
+	t_state.currentLoadedShots = field[VIEW_LOADED_SHOTS];
+	t_state.currentShot = t_state.currentLoadedShots - 1;
+	t_state.liveRounds = field[VIEW_LIVE_ROUNDS];
+	t_state.blankRounds = field[VIEW_BLANK_ROUNDS];
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		t_state.health[seat] = field[VIEW_HEALTH + seat];
+		t_state.paused[seat] = field[VIEW_PAUSED + seat] != 0;
+		for (int slot = 0; slot < MAX_ITEMS; slot++)
+		{
+			t_state.inventory[seat][slot] = field[VIEW_INVENTORY + seat * MAX_ITEMS + slot];
+		}
+	}
+	t_state.turn = field[VIEW_TURN];
+	t_state.doubleDamage = field[VIEW_DOUBLE_DAMAGE] != 0;
+	t_state.knowItsLive = field[VIEW_KNOW_LIVE] != 0;
+	t_state.knowItsBlank = field[VIEW_KNOW_BLANK] != 0;
+}
+
+#ifdef __linux__
+
+#include "MatchStats.h"
+#include "Policy.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// wire format, little endian, the message type says how long the rest is:
+// client START  type(1) match(4) seed(8)
+// client ACTION type(1) match(4) actionType(1) slot(1)
+// server STATE  type(1) match(4) MatchView delta against the last STATE for that match
+// server END    type(1) match(4) winner(1, signed)
+// server REJECT type(1) match(4), unknown match or an action that isn't allowed right now
+static const unsigned char START_MESSAGE = 1;
+static const unsigned char ACTION_MESSAGE = 2;
+static const unsigned char STATE_MESSAGE = 3;
+static const unsigned char END_MESSAGE = 4;
+static const unsigned char REJECT_MESSAGE = 5;
+
+static const int START_MESSAGE_SIZE = 13;
+static const int ACTION_MESSAGE_SIZE = 7;
+static const int HEADER_SIZE = 5;
+static const int READ_BUFFER_SIZE = 65536;
+static const int MAX_EVENTS = 256;
+
+static void putUint32(std::string& t_out, std::uint32_t t_value)
+{
+	for (int byte = 0; byte < 4; byte++)
+	{
+		t_out.push_back(static_cast<char>((t_value >> (byte * 8)) & 0xFF));
+	}
+}
+
+static std::uint64_t getUint(const unsigned char* t_in, int t_bytes)
+{
+	std::uint64_t value = 0;
+	for (int byte = 0; byte < t_bytes; byte++)
+	{
+		value |= static_cast<std::uint64_t>(t_in[byte]) << (byte * 8);
+	}
+	return value;
+}
+
+// sends what the socket will take, false if the connection is gone
+static bool flushSocket(int t_socket, std::string& t_outgoing)
+{
+	while (!t_outgoing.empty())
+	{
+		ssize_t sent = ::send(t_socket, t_outgoing.data(), t_outgoing.size(), MSG_NOSIGNAL);
+		if (sent < 0)
+		{
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+		t_outgoing.erase(0, static_cast<std::size_t>(sent));
+	}
+	return true;
+}
+
+// reads everything waiting, false if the connection is gone
+static bool drainSocket(int t_socket, std::string& t_incoming)
+{
+	char buffer[READ_BUFFER_SIZE];
+	while (true)
+	{
+		ssize_t received = ::recv(t_socket, buffer, sizeof(buffer), 0);
+		if (received > 0)
+		{
+			t_incoming.append(buffer, static_cast<std::size_t>(received));
+			continue;
+		}
+		if (received == 0)
+		{
+			return false;
+		}
+		return errno == EAGAIN || errno == EWOULDBLOCK;
+	}
+}
+
+static void setNoDelay(int t_socket)
+{
+	int enabled = 1;
+	setsockopt(t_socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+}
+
+/// <summary>
+/// one match the server is hosting, plus what the client was last told about it
+/// </summary>
+struct ServerMatch
+{
+	MatchState state;
+	FastRandom random;
+	MatchView sent;
+};
+
+struct ServerConnection
+{
+	int socket = -1;
+	bool wantsWrite = false;
+	std::string incoming;
+	std::string outgoing;
+	std::unordered_map<std::uint32_t, int> matches; // client's match id -> index into the shard's pool
+};
+
+/// <summary>
+/// a worker thread with its own epoll loop, owns its connections and their matches outright
+/// </summary>
+class ServerShard
+{
+public:
+	ServerShard();
+	~ServerShard();
+
+	void start();
+	void addConnection(int t_socket); // called from the accept thread
+	void takeStats(QuantileSketch& t_latency, long long& t_actions, long long& t_matchesFinished);
+
+	int getConnectionCount() const { return connectionCount.load(std::memory_order_relaxed); }
+	int getActiveMatches() const { return activeMatches.load(std::memory_order_relaxed); }
+
+private:
+	void run();
+	void acceptPending();
+	void readConnection(ServerConnection& t_connection);
+	bool writeConnection(ServerConnection& t_connection); // false if the connection was closed
+	void closeConnection(int t_socket);
+
+	void startMatch(ServerConnection& t_connection, std::uint32_t t_id, std::uint64_t t_seed);
+	void playAction(ServerConnection& t_connection, std::uint32_t t_id, Action t_action);
+	void playEnemy(ServerMatch& t_match);
+	void sendState(ServerConnection& t_connection, std::uint32_t t_id, ServerMatch& t_match);
+	void sendReject(ServerConnection& t_connection, std::uint32_t t_id);
+	void freeMatch(int t_index);
+	void publishStats();
+
+	int epollFd;
+	int wakeFd; // eventfd the accept thread pokes when it hands over a connection
+	std::thread thread;
+
+	std::mutex pendingMutex;
+	std::vector<int> pendingSockets;
+
+	std::unordered_map<int, ServerConnection> connections;
+	std::vector<ServerMatch> matches;
+	std::vector<int> freeMatches;
+	HeuristicPolicy enemyPolicy;
+
+	// counted on the shard thread, handed to takeStats every so often under statsMutex
+	QuantileSketch latency; // 100ns units, from a message being read to its reply being queued
+	long long actions;
+	long long matchesFinished;
+	std::chrono::steady_clock::time_point lastPublish;
+
+	std::mutex statsMutex;
+	QuantileSketch publishedLatency;
+	long long publishedActions;
+	long long publishedMatchesFinished;
+	std::atomic<int> connectionCount;
+	std::atomic<int> activeMatches;
+};
+
+ServerShard::ServerShard() :
+	epollFd{ epoll_create1(0) },
+	wakeFd{ eventfd(0, EFD_NONBLOCK) },
+	actions{ 0 },
+	matchesFinished{ 0 },
+	lastPublish{ std::chrono::steady_clock::now() },
+	publishedActions{ 0 },
+	publishedMatchesFinished{ 0 },
+	connectionCount{ 0 },
+	activeMatches{ 0 }
+{
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = wakeFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+ServerShard::~ServerShard()
+{
+	if (thread.joinable())
+	{
+		thread.detach(); // the server only stops with the process
+	}
+}
+
+void ServerShard::start()
+{
+	thread = std::thread(&ServerShard::run, this);
+}
+
+void ServerShard::addConnection(int t_socket)
+{
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		pendingSockets.push_back(t_socket);
+	}
+	std::uint64_t one = 1;
+	ssize_t written = ::write(wakeFd, &one, sizeof(one));
+	(void)written;
+}
+
+void ServerShard::takeStats(QuantileSketch& t_latency, long long& t_actions, long long& t_matchesFinished)
+{
+	std::lock_guard<std::mutex> lock(statsMutex);
+	t_latency.merge(publishedLatency);
+	t_actions += publishedActions;
+	t_matchesFinished += publishedMatchesFinished;
+	publishedLatency = QuantileSketch();
+	publishedActions = 0;
+	publishedMatchesFinished = 0;
+}
+
+void ServerShard::run()
+{
+	epoll_event events[MAX_EVENTS];
+	while (true)
+	{
+		int ready = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+		for (int index = 0; index < ready; index++)
+		{
+			int socket = events[index].data.fd;
+			if (socket == wakeFd)
+			{
+				acceptPending();
+				continue;
+			}
+			auto found = connections.find(socket);
+			if (found == connections.end())
+			{
+				continue;
+			}
+			if (events[index].events & (EPOLLHUP | EPOLLERR))
+			{
+				closeConnection(socket);
+				continue;
+			}
+			if ((events[index].events & EPOLLOUT) && !writeConnection(found->second))
+			{
+				continue; // a reset while flushing closed it, found->second is gone
+			}
+			if (events[index].events & EPOLLIN)
+			{
+				readConnection(found->second);
+			}
+		}
+		publishStats();
+	}
+}
+
+void ServerShard::acceptPending()
+{
+	std::uint64_t count = 0;
+	ssize_t received = ::read(wakeFd, &count, sizeof(count));
+	(void)received;
+
+	std::vector<int> sockets;
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		sockets.swap(pendingSockets);
+	}
+	for (int socket : sockets)
+	{
+		ServerConnection& connection = connections[socket];
+		connection.socket = socket;
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.fd = socket;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event);
+		connectionCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void ServerShard::readConnection(ServerConnection& t_connection)
+{
+	if (!drainSocket(t_connection.socket, t_connection.incoming))
+	{
+		closeConnection(t_connection.socket);
+		return;
+	}
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(t_connection.incoming.data());
+	std::size_t size = t_connection.incoming.size();
+	std::size_t offset = 0;
+	while (offset < size)
+	{
+		auto start = std::chrono::steady_clock::now();
+		const unsigned char* message = data + offset;
+		std::size_t left = size - offset;
+		std::uint32_t id = 0;
+		if (message[0] == START_MESSAGE && left >= static_cast<std::size_t>(START_MESSAGE_SIZE))
+		{
+			id = static_cast<std::uint32_t>(getUint(message + 1, 4));
+			startMatch(t_connection, id, getUint(message + 5, 8));
+			offset += START_MESSAGE_SIZE;
+		}
+		else if (message[0] == ACTION_MESSAGE && left >= static_cast<std::size_t>(ACTION_MESSAGE_SIZE))
+		{
+			id = static_cast<std::uint32_t>(getUint(message + 1, 4));
+			playAction(t_connection, id, Action{ message[5], message[6] });
+			offset += ACTION_MESSAGE_SIZE;
+		}
+		else if (message[0] == START_MESSAGE || message[0] == ACTION_MESSAGE)
+		{
+			break; // rest of the message hasn't arrived yet
+		}
+		else
+		{
+			std::cout << "match server dropping a client that sent message type " << static_cast<int>(message[0]) << std::endl;
+			closeConnection(t_connection.socket);
+			return;
+		}
+		actions++;
+		latency.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e7);
+	}
+	t_connection.incoming.erase(0, offset);
+	writeConnection(t_connection);
+}
+
+bool ServerShard::writeConnection(ServerConnection& t_connection)
+{
+	if (!flushSocket(t_connection.socket, t_connection.outgoing))
+	{
+		closeConnection(t_connection.socket);
+		return false;
+	}
+	bool wantsWrite = !t_connection.outgoing.empty();
+	if (wantsWrite != t_connection.wantsWrite)
+	{
+		epoll_event event{};
+		event.events = wantsWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+		event.data.fd = t_connection.socket;
+		epoll_ctl(epollFd, EPOLL_CTL_MOD, t_connection.socket, &event);
+		t_connection.wantsWrite = wantsWrite;
+	}
+	return true;
+}
+
+void ServerShard::closeConnection(int t_socket)
+{
+	auto found = connections.find(t_socket);
+	if (found == connections.end())
+	{
+		return;
+	}
+	for (auto& match : found->second.matches)
+	{
+		freeMatch(match.second);
+	}
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, t_socket, nullptr);
+	::close(t_socket);
+	connections.erase(found);
+	connectionCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// starts (or restarts) match t_id for a connection, the client always plays PLAYER
+/// </summary>
+void ServerShard::startMatch(ServerConnection& t_connection, std::uint32_t t_id, std::uint64_t t_seed)
+{
+	int index;
+	auto found = t_connection.matches.find(t_id);
+	if (found != t_connection.matches.end())
+	{
+		index = found->second;
+	}
+	else if (!freeMatches.empty())
+	{
+		index = freeMatches.back();
+		freeMatches.pop_back();
+		activeMatches.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		index = static_cast<int>(matches.size());
+		matches.emplace_back();
+		activeMatches.fetch_add(1, std::memory_order_relaxed);
+	}
+	t_connection.matches[t_id] = index;
+
+	ServerMatch& match = matches[index];
+	match.state.reset();
+	match.random.seed(t_seed);
+	match.sent = MatchView{};
+	playEnemy(match); // deals the first round
+	sendState(t_connection, t_id, match);
+}
+
+void ServerShard::playAction(ServerConnection& t_connection, std::uint32_t t_id, Action t_action)
+{
+	auto found = t_connection.matches.find(t_id);
+	if (found == t_connection.matches.end())
+	{
+		sendReject(t_connection, t_id);
+		return;
+	}
+	ServerMatch& match = matches[found->second];
+	if (match.state.turn != PLAYER || !match.state.isLegal(PLAYER, t_action))
+	{
+		sendReject(t_connection, t_id);
+		return;
+	}
+
+	match.state.apply(PLAYER, t_action);
+	playEnemy(match);
+	sendState(t_connection, t_id, match);
+
+	if (match.state.isOver() || match.state.isOutOfRounds())
+	{
+		t_connection.outgoing.push_back(static_cast<char>(END_MESSAGE));
+		putUint32(t_connection.outgoing, t_id);
+		t_connection.outgoing.push_back(static_cast<char>(match.state.winner()));
+		freeMatch(found->second);
+		t_connection.matches.erase(found);
+		matchesFinished++;
+	}
+}
+
+/// <summary>
+/// deals new rounds and plays the server's seat until it's the client's move again or the match is over
+/// </summary>
+void ServerShard::playEnemy(ServerMatch& t_match)
+{
+	MatchState& state = t_match.state;
+	while (!state.isOver() && !state.isOutOfRounds())
+	{
+		if (state.needsNewRound())
+		{
+			state.startRound(t_match.random);
+		}
+		if (state.turn == PLAYER)
+		{
+			return;
+		}
+		Action action = enemyPolicy.chooseAction(Observation(state, ENEMY));
+		if (!state.isLegal(ENEMY, action))
+		{
+			action = shootOpponentAction();
+		}
+		state.apply(ENEMY, action);
+	}
+}
+
+void ServerShard::sendState(ServerConnection& t_connection, std::uint32_t t_id, ServerMatch& t_match)
+{
+	MatchView view;
+	view.fromState(t_match.state);
+	unsigned char delta[VIEW_MASK_BYTES + MatchView::FIELDS];
+	int size = view.encodeDelta(t_match.sent, delta);
+	t_match.sent = view;
+
+	t_connection.outgoing.push_back(static_cast<char>(STATE_MESSAGE));
+	putUint32(t_connection.outgoing, t_id);
+	t_connection.outgoing.append(reinterpret_cast<const char*>(delta), static_cast<std::size_t>(size));
+}
+
+void ServerShard::sendReject(ServerConnection& t_connection, std::uint32_t t_id)
+{
+	t_connection.outgoing.push_back(static_cast<char>(REJECT_MESSAGE));
+	putUint32(t_connection.outgoing, t_id);
+}
+
+void ServerShard::freeMatch(int t_index)
+{
+	freeMatches.push_back(t_index);
+	activeMatches.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ServerShard::publishStats()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (now - lastPublish < std::chrono::milliseconds(500))
+	{
+		return;
+	}
+	lastPublish = now;
+	std::lock_guard<std::mutex> lock(statsMutex);
+	publishedLatency.merge(latency);
+	publishedActions += actions;
+	publishedMatchesFinished += matchesFinished;
+	latency = QuantileSketch();
+	actions = 0;
+	matchesFinished = 0;
+}
+
+void runMatchServer(unsigned short t_port, int t_shards)
+{
+	int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	int enabled = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(t_port);
+	if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0)
+	{
+		std::cout << "match server couldn't listen on port " << t_port << std::endl;
+		::close(listener);
+		return;
+	}
+
+	t_shards = std::max(t_shards, 1);
+	std::vector<std::unique_ptr<ServerShard>> shards;
+	for (int shard = 0; shard < t_shards; shard++)
+	{
+		shards.emplace_back(new ServerShard());
+		shards.back()->start();
+	}
+	std::cout << "match server on port " << t_port << " with " << t_shards << " shards" << std::endl;
+
+	int epollFd = epoll_create1(0);
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = listener;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, listener, &event);
+
+	int nextShard = 0;
+	auto lastReport = std::chrono::steady_clock::now();
+	while (true)
+	{
+		epoll_event ready[1];
+		if (epoll_wait(epollFd, ready, 1, 1000) > 0)
+		{
+			int socket;
+			while ((socket = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0)
+			{
+				setNoDelay(socket);
+				shards[nextShard]->addConnection(socket);
+				nextShard = (nextShard + 1) % t_shards;
+			}
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(now - lastReport).count();
+		if (seconds >= 5.0)
+		{
+			lastReport = now;
+			QuantileSketch latency;
+			long long actions = 0;
+			long long finished = 0;
+			int connections = 0;
+			int active = 0;
+			for (auto& shard : shards)
+			{
+				shard->takeStats(latency, actions, finished);
+				connections += shard->getConnectionCount();
+				active += shard->getActiveMatches();
+			}
+			std::cout << connections << " connections | " << active << " live matches | " << finished << " finished | "
+				<< static_cast<long long>(actions / seconds) << " messages/s | processing us p50 " << latency.quantile(0.5) / 10.0
+				<< " p99 " << latency.quantile(0.99) / 10.0 << " max " << latency.getMax() / 10.0 << std::endl;
+		}
+	}
+}
+
+/// <summary>
+/// the load generator's copy of one match, mirrored from the server's deltas
+/// </summary>
+struct ClientMatch
+{
+	MatchView view;
+	bool waitingForEnd = false;
+	std::chrono::steady_clock::time_point sentAt;
+};
+
+struct ClientConnection
+{
+	int socket = -1;
+	bool wantsWrite = false;
+	std::string incoming;
+	std::string outgoing;
+	std::vector<ClientMatch> matches; // indexed by match id
+};
+
+void runLoadGenerator(const std::string& t_address, unsigned short t_port, int t_connections,
+	int t_matchesPerConnection, long long t_totalMatches)
+{
+	int epollFd = epoll_create1(0);
+	std::vector<ClientConnection> connections(static_cast<std::size_t>(std::max(t_connections, 1)));
+	FastRandom random;
+	random.seed(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+	HeuristicPolicy policy;
+
+	QuantileSketch roundTrip; // microseconds, from a message being sent to the reply arriving
+	long long started = 0;
+	long long finished = 0;
+	long long actions = 0;
+	long long rejects = 0;
+	long long wins[2] = { 0, 0 };
+
+	auto sendStart = [&](ClientConnection& t_connection, std::uint32_t t_id)
+	{
+		ClientMatch& match = t_connection.matches[t_id];
+		match.view = MatchView{};
+		match.waitingForEnd = false;
+		match.sentAt = std::chrono::steady_clock::now();
+		t_connection.outgoing.push_back(static_cast<char>(START_MESSAGE));
+		putUint32(t_connection.outgoing, t_id);
+		std::uint64_t seed = random.next();
+		for (int byte = 0; byte < 8; byte++)
+		{
+			t_connection.outgoing.push_back(static_cast<char>((seed >> (byte * 8)) & 0xFF));
+		}
+		started++;
+	};
+
+	for (std::size_t index = 0; index < connections.size(); index++)
+	{
+		ClientConnection& connection = connections[index];
+		connection.socket = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(t_port);
+		inet_pton(AF_INET, t_address.c_str(), &address.sin_addr);
+		if (connect(connection.socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+		{
+			std::cout << "load generator couldn't connect to " << t_address << ":" << t_port << std::endl;
+			return;
+		}
+		setNoDelay(connection.socket);
+		fcntl(connection.socket, F_SETFL, fcntl(connection.socket, F_GETFL) | O_NONBLOCK);
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.u64 = index;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, connection.socket, &event);
+
+		connection.matches.resize(static_cast<std::size_t>(std::max(t_matchesPerConnection, 1)));
+		for (std::size_t id = 0; id < connection.matches.size() && started < t_totalMatches; id++)
+		{
+			sendStart(connection, static_cast<std::uint32_t>(id));
+		}
+		flushSocket(connection.socket, connection.outgoing);
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	bool lost = false;
+	epoll_event events[MAX_EVENTS];
+	while (finished < t_totalMatches && !lost)
+	{
+		int ready = epoll_wait(epollFd, events, MAX_EVENTS, 5000);
+		if (ready <= 0)
+		{
+			std::cout << "load generator timed out waiting on the server" << std::endl;
+			break;
+		}
+		for (int index = 0; index < ready && !lost; index++)
+		{
+			ClientConnection& connection = connections[events[index].data.u64];
+			if (!drainSocket(connection.socket, connection.incoming))
+			{
+				std::cout << "server closed a load generator connection" << std::endl;
+				lost = true;
+				break;
+			}
+
+			const unsigned char* data = reinterpret_cast<const unsigned char*>(connection.incoming.data());
+			std::size_t size = connection.incoming.size();
+			std::size_t offset = 0;
+			while (size - offset >= static_cast<std::size_t>(HEADER_SIZE))
+			{
+				const unsigned char* message = data + offset;
+				std::size_t left = size - offset;
+				std::uint32_t id = static_cast<std::uint32_t>(getUint(message + 1, 4));
+				if (id >= connection.matches.size())
+				{
+					std::cout << "server replied about a match that was never started" << std::endl;
+					lost = true;
+					break;
+				}
+				ClientMatch& match = connection.matches[id];
+
+				if (message[0] == STATE_MESSAGE)
+				{
+					if (left < static_cast<std::size_t>(HEADER_SIZE + VIEW_MASK_BYTES))
+					{
+						break;
+					}
+					std::size_t needed = HEADER_SIZE + fieldDeltaSize(message + HEADER_SIZE, MatchView::FIELDS);
+					if (left < needed)
+					{
+						break;
+					}
+					match.view.applyDelta(message + HEADER_SIZE);
+					offset += needed;
+
+					auto now = std::chrono::steady_clock::now();
+					roundTrip.add(std::chrono::duration<double>(now - match.sentAt).count() * 1e6);
+
+					MatchState state;
+					match.view.toState(state);
+					if (state.isOver() || state.isOutOfRounds())
+					{
+						match.waitingForEnd = true;
+						continue;
+					}
+					Action action = policy.chooseAction(Observation(state, PLAYER));
+					if (!state.isLegal(PLAYER, action))
+					{
+						action = shootOpponentAction();
+					}
+					connection.outgoing.push_back(static_cast<char>(ACTION_MESSAGE));
+					putUint32(connection.outgoing, id);
+					connection.outgoing.push_back(static_cast<char>(action.type));
+					connection.outgoing.push_back(static_cast<char>(action.slot));
+					match.sentAt = now;
+					actions++;
+				}
+				else if (message[0] == END_MESSAGE || message[0] == REJECT_MESSAGE)
+				{
+					if (message[0] == END_MESSAGE)
+					{
+						if (left < static_cast<std::size_t>(HEADER_SIZE + 1))
+						{
+							break;
+						}
+						int winner = static_cast<signed char>(message[HEADER_SIZE]);
+						if (winner != NO_WINNER)
+						{
+							wins[winner]++;
+						}
+						offset += HEADER_SIZE + 1;
+					}
+					else
+					{
+						rejects++;
+						offset += HEADER_SIZE;
+					}
+					finished++;
+					if (started < t_totalMatches)
+					{
+						sendStart(connection, id);
+					}
+				}
+				else
+				{
+					std::cout << "server sent unknown message type " << static_cast<int>(message[0]) << std::endl;
+					lost = true;
+					break;
+				}
+			}
+			connection.incoming.erase(0, offset);
+
+			if (!flushSocket(connection.socket, connection.outgoing))
+			{
+				lost = true;
+				break;
+			}
+			bool wantsWrite = !connection.outgoing.empty();
+			if (wantsWrite != connection.wantsWrite)
+			{
+				epoll_event event{};
+				event.events = wantsWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+				event.data.u64 = events[index].data.u64;
+				epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.socket, &event);
+				connection.wantsWrite = wantsWrite;
+			}
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	for (ClientConnection& connection : connections)
+	{
+		::close(connection.socket);
+	}
+	::close(epollFd);
+
+	std::cout << finished << " matches (" << t_connections * t_matchesPerConnection << " at once) in " << seconds << "s"
+		<< " | " << static_cast<long long>(finished / seconds) << " matches/s, " << static_cast<long long>(actions / seconds) << " actions/s"
+		<< " | player " << wins[PLAYER] << " enemy " << wins[ENEMY] << " draws " << (finished - rejects - wins[PLAYER] - wins[ENEMY])
+		<< " | rejected " << rejects << std::endl;
+	std::cout << "round trip us p50 " << roundTrip.quantile(0.5) << " p99 " << roundTrip.quantile(0.99)
+		<< " p99.9 " << roundTrip.quantile(0.999) << " max " << roundTrip.getMax() << std::endl;
+}
+
+#else
+
+void runMatchServer(unsigned short t_port, int t_shards)
+{
+	std::cout << "the match server is built on epoll and only runs on Linux" << std::endl;
+}
+
+void runLoadGenerator(const std::string& t_address, unsigned short t_port, int t_connections,
+	int t_matchesPerConnection, long long t_totalMatches)
+{
+	std::cout << "the load generator is built on epoll and only runs on Linux" << std::endl;
+}
+
+#endif
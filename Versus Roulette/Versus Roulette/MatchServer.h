@@ -0,0 +1,54 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Headless match server. One process hosts thousands of matches at once: an accept thread hands
+/// connections out to worker shards, and each shard runs its own epoll loop over its connections
+/// and the MatchStates they own, so no match is ever touched by two threads.
+/// A client plays the PLAYER seat of as many matches as it likes over one connection,
+/// the server's HeuristicPolicy plays ENEMY, and every reply is a delta of what the client can see.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "MatchState.h"
+
+const unsigned short static DEFAULT_SERVER_PORT = 53600;
+
+/// <summary>
+/// delta of a row of one byte fields: a bitmask of the fields that changed, then just those bytes.
+/// encode returns the bytes written (at most maskBytes + t_count), apply and size return the bytes read
+/// </summary>
+int encodeFieldDelta(const signed char* t_fields, const signed char* t_previous, int t_count, unsigned char* t_out);
+int applyFieldDelta(signed char* t_fields, int t_count, const unsigned char* t_in);
+int fieldDeltaSize(const unsigned char* t_in, int t_count); // t_in needs the mask bytes only
+inline int fieldMaskBytes(int t_count) { return (t_count + 7) / 8; }
+
+/// <summary>
+/// the fields of a match a client is allowed to see (no taser order), one byte each
+/// so a reply only has to carry the bytes that changed plus a bitmask saying which
+/// </summary>
+struct MatchView
+{
+	static const int FIELDS = 20;
+
+	void fromState(const MatchState& t_state);
+	void toState(MatchState& t_state) const; // taser order is left blank
+
+	int encodeDelta(const MatchView& t_previous, unsigned char* t_out) const { return encodeFieldDelta(field, t_previous.field, FIELDS, t_out); }
+	int applyDelta(const unsigned char* t_in) { return applyFieldDelta(field, FIELDS, t_in); }
+
+	signed char field[FIELDS];
+};
+
+/// <summary>
+/// entry point for "--server [port] [shards]", runs until the process is killed
+/// </summary>
+void runMatchServer(unsigned short t_port, int t_shards);
+
+/// <summary>
+/// entry point for "--load [address] [port] [connections] [matches per connection] [total matches]":
+/// keeps connections * matchesPerConnection matches going at once until t_totalMatches have finished
+/// </summary>
+void runLoadGenerator(const std::string& t_address, unsigned short t_port, int t_connections,
+	int t_matchesPerConnection, long long t_totalMatches);
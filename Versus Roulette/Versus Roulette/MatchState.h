@@ -0,0 +1,770 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Compact copy of the rules side of a match (taser, health, inventories, item flags)
+/// with no sprites or sounds attached, so it can be simulated headless and copied freely.
+/// The rules here mirror Game::shootSelf, Game::shootOpponent, Game::useItem etc.
+/// BasicMatchState is the one engine for every rule set, its storage sized by the rule set (see
+/// MatchRules.h). The rule values come in as a second parameter: the rule set itself, so they
+/// are constants, or a RuleConfig read at runtime. MatchState is the ClassicRules one the game plays.
+#pragma once
+
+#include <cstdint>
+#include "Globals.h"
+#include "Random.h"
+
+//actions a robot can take on its turn
+const int static SHOOT_SELF_ACTION = 0;
+const int static SHOOT_OPPONENT_ACTION = 1;
+const int static USE_ITEM_ACTION = 2;
+
+const int static STARTING_HEALTH = ClassicRules::startingHealth;
+const int static ITEMS_PER_ROUND = ClassicRules::itemsPerRound;
+const int static ITEM_TYPES = RULE_ITEM_TYPES; // OIL_DRINK to RUBBISH_BIN
+const int static MAX_ROUNDS = ClassicRules::maxRounds; // headless matches only, oil drinks can otherwise outheal the taser forever
+const int static NO_WINNER = -1;
+
+/// <summary>
+/// rule parameters the headless code can vary (the balance tuner sweeps these).
+/// Game itself always plays DEFAULT_RULES
+/// </summary>
+struct RuleConfig
+{
+	int itemWeights[ITEM_TYPES]; // relative chance of dealing OIL_DRINK..RUBBISH_BIN
+	int magazineSize; // 2 to the state's SHOT_CAPACITY
+	int startingHealth;
+	int itemsPerRound; // 0 to the state's ITEM_CAPACITY
+	int maxRounds; // match is decided on health once this many rounds are used up
+
+	int itemWeight(int t_type) const { return itemWeights[t_type]; } // t_type 0 is OIL_DRINK
+	int totalItemWeight() const
+	{
+		int total = 0;
+		for (int index = 0; index < ITEM_TYPES; index++)
+		{
+			total += itemWeights[index];
+		}
+		return total;
+	}
+
+	/// <summary>
+	/// draws an item id using the weights, with equal weights this is the same draw as FixedRules::drawItem
+	/// </summary>
+	int drawItem(FastRandom& t_random) const
+	{
+		int roll = t_random.nextInt(totalItemWeight());
+		for (int index = 0; index < ITEM_TYPES; index++)
+		{
+			roll -= itemWeights[index];
+			if (roll < 0)
+			{
+				return index + 1;
+			}
+		}
+		return ITEM_TYPES;
+	}
+};
+
+const static RuleConfig DEFAULT_RULES = { { 1, 1, 1, 1, 1 }, MAX_SHOTS, STARTING_HEALTH, ITEMS_PER_ROUND, MAX_ROUNDS };
+
+/// <summary>
+/// one decision made by a robot, t_slot is only used for USE_ITEM_ACTION
+/// </summary>
+struct Action
+{
+	int type;
+	int slot;
+};
+
+inline Action shootSelfAction() { return Action{ SHOOT_SELF_ACTION, 0 }; }
+inline Action shootOpponentAction() { return Action{ SHOOT_OPPONENT_ACTION, 0 }; }
+inline Action useItemAction(int t_slot) { return Action{ USE_ITEM_ACTION, t_slot }; }
+
+/// <summary>
+/// what makeMove changed, enough for undoMove to put it back. plain data, lives on the caller's stack
+/// </summary>
+struct UndoRecord
+{
+	Action action;
+	int seat;
+	int health[2];
+	int turn;
+	int item; // what was in action.slot, item actions only
+	int shot; // the shot fired or binned, -1 if none left the taser
+	bool doubleDamage;
+	bool paused[2];
+	bool knowItsLive;
+	bool knowItsBlank;
+};
+
+/// <summary>
+/// what startRoundAt changed, for undoRound
+/// </summary>
+struct RoundUndo
+{
+	std::uint64_t taserBits; // taserArray as bits, shot 0 lowest
+	int currentShot;
+	int currentLoadedShots;
+	int liveRounds;
+	int blankRounds;
+	int turn;
+	int dealtSlots[2]; // bit per inventory slot filled by the deal, they were empty before
+	bool knowItsLive;
+	bool knowItsBlank;
+};
+
+// the rules every table shares, BasicMatchState's two seats and FfaMatch's free for all (FreeForAll.h).
+// State is either of them: the taser fields (taserArray, currentShot, currentLoadedShots, liveRounds,
+// blankRounds), doubleDamage, knowItsLive, knowItsBlank and health by seat
+
+/// <summary>
+/// randomly loads the taser, at least one live and one blank
+/// </summary>
+template <typename State, typename Config>
+void loadRandomTaser(State& t_state, FastRandom& t_random, const Config& t_rules)
+{
+	do
+	{
+		t_state.liveRounds = 0;
+		t_state.blankRounds = 0;
+		for (int index = 0; index < t_rules.magazineSize; index++)
+		{
+			t_state.taserArray[index] = t_random.nextInt(2);
+			if (t_state.taserArray[index] == 1)
+			{
+				t_state.liveRounds++;
+			}
+			else
+			{
+				t_state.blankRounds++;
+			}
+		}
+	} while (t_state.liveRounds == 0 || t_state.blankRounds == 0);
+
+	t_state.currentLoadedShots = t_rules.magazineSize;
+	t_state.currentShot = t_rules.magazineSize - 1;
+	t_state.knowItsLive = false;
+	t_state.knowItsBlank = false;
+}
+
+/// <summary>
+/// draws an item for one slot and puts it there if the slot is empty and the robot is still owed items.
+/// the draw is made either way, like Game::giveItems
+/// </summary>
+template <typename Slot, typename Config>
+void dealItem(Slot& t_slot, int& t_itemsGiven, FastRandom& t_random, const Config& t_rules)
+{
+	int numberGen = t_rules.drawItem(t_random);
+	if (t_slot == 0 && t_itemsGiven < t_rules.itemsPerRound)
+	{
+		t_slot = static_cast<Slot>(numberGen);
+		t_itemsGiven++;
+	}
+}
+
+/// <summary>
+/// damage the shot being fired does, spends the overcharger
+/// </summary>
+template <typename State>
+int chargeDamage(State& t_state)
+{
+	int damage = t_state.doubleDamage ? 2 : 1;
+	t_state.doubleDamage = false;
+	return damage;
+}
+
+/// <summary>
+/// takes the next shot out of the taser, returns 1 for a live and 0 for a blank. the scan was of this shot, so it's forgotten
+/// </summary>
+template <typename State>
+int fireShot(State& t_state)
+{
+	int shot = t_state.taserArray[t_state.currentShot];
+	if (shot == 1)
+	{
+		t_state.liveRounds--;
+	}
+	else
+	{
+		t_state.blankRounds--;
+	}
+	t_state.currentLoadedShots--;
+	t_state.currentShot--;
+	t_state.knowItsLive = false;
+	t_state.knowItsBlank = false;
+	return shot;
+}
+
+/// <summary>
+/// what t_item does for t_seat, except the pause remote: who that pauses is up to the table.
+/// returns the shot a rubbish bin threw out, -1 for every other item
+/// </summary>
+template <typename State>
+int applyItemEffect(State& t_state, int t_item, int t_seat)
+{
+	switch (t_item)
+	{
+	case OIL_DRINK:
+		t_state.health[t_seat]++;
+		break;
+	case SCANNER:
+		t_state.knowItsLive = t_state.taserArray[t_state.currentShot] == 1;
+		t_state.knowItsBlank = !t_state.knowItsLive;
+		break;
+	case OVERCHARGER:
+		t_state.doubleDamage = true;
+		break;
+	case RUBBISH_BIN:
+		return fireShot(t_state);
+	}
+	return -1;
+}
+
+template <typename Rules>
+struct BasicMatchState
+{
+	static constexpr int SHOT_CAPACITY = Rules::SHOT_CAPACITY;
+	static constexpr int ITEM_CAPACITY = Rules::ITEM_CAPACITY;
+
+	template <typename Config = RuleConfig> void reset(const Config& t_rules = DEFAULT_RULES);
+
+	template <typename Config = RuleConfig> void startRound(FastRandom& t_random, const Config& t_rules = DEFAULT_RULES);
+	template <typename Config = RuleConfig> void loadTaser(FastRandom& t_random, const Config& t_rules = DEFAULT_RULES);
+	template <typename Config = RuleConfig> void giveItems(FastRandom& t_random, const Config& t_rules = DEFAULT_RULES);
+
+	void shootSelf(int t_seat);
+	void shootOpponent(int t_seat);
+	void passTurn(int t_seat);
+	void useItem(int t_seat, int t_slot);
+
+	bool isLegal(int t_seat, Action t_action) const;
+	void apply(int t_seat, Action t_action);
+
+	// make / unmake for search: no copies of the state and no allocation
+	UndoRecord makeMove(int t_seat, Action t_action);
+	void undoMove(const UndoRecord& t_undo);
+
+	// the chance events of a new round, enumerated. every taser load is equally likely,
+	// a deal's chance comes from the item weights. loads are counted in 64 bits, 2^64 - 2 of them for 64 shots
+	template <typename Config = RuleConfig>
+	std::uint64_t taserLoadCount(const Config& t_rules = DEFAULT_RULES) const { return (~0ULL >> (64 - t_rules.magazineSize)) - 1; }
+	template <typename Config = RuleConfig> void loadTaserAt(std::uint64_t t_load, const Config& t_rules = DEFAULT_RULES);
+	template <typename Config = RuleConfig> int itemDealCount(const Config& t_rules = DEFAULT_RULES) const;
+	template <typename Config = RuleConfig> double dealItemsAt(int t_deal, const Config& t_rules = DEFAULT_RULES);
+	template <typename Config = RuleConfig> RoundUndo startRoundAt(std::uint64_t t_load, int t_deal, const Config& t_rules = DEFAULT_RULES);
+	void undoRound(const RoundUndo& t_undo);
+
+	bool needsNewRound() const { return currentLoadedShots <= 0; }
+	bool isOver() const { return health[PLAYER] <= 0 || health[ENEMY] <= 0; }
+	template <typename Config = RuleConfig>
+	bool isOutOfRounds(const Config& t_rules = DEFAULT_RULES) const { return needsNewRound() && round >= t_rules.maxRounds; }
+	int winner() const; // the seat left standing, or with more health if the rounds ran out
+	std::uint32_t checksum() const; // hash of every field (not the raw bytes, padding isn't stable)
+
+	int round; // rounds started so far
+
+	// taser
+	int taserArray[SHOT_CAPACITY]; // 1 is live, 0 is blank
+	int currentShot; // index of the shot that fires next (goes 5,4,3,2,1,0)
+	int currentLoadedShots;
+	int liveRounds;
+	int blankRounds;
+
+	// robots, indexed by PLAYER / ENEMY
+	int health[2];
+	int inventory[2][ITEM_CAPACITY]; // 0 is an empty slot
+	int turn; // seat whose turn it is
+
+	// items
+	bool doubleDamage; // overcharger
+	bool paused[2]; // seat misses its next turn (pause remote)
+	bool knowItsLive; // scanner result for the seat whose turn it is
+	bool knowItsBlank;
+};
+
+using MatchState = BasicMatchState<ClassicRules>;
+
+/// <summary>
+/// what a robot is allowed to see of the match, hides the taser order
+/// </summary>
+template <typename Rules>
+class BasicObservation
+{
+public:
+	static constexpr int ITEM_CAPACITY = Rules::ITEM_CAPACITY;
+
+	BasicObservation(const BasicMatchState<Rules>& t_state, int t_seat) : state(t_state), seat(t_seat) {}
+
+	int getSeat() const { return seat; }
+	int getHealth() const { return state.health[seat]; }
+	int getOpponentHealth() const { return state.health[1 - seat]; }
+	int getItem(int t_slot) const { return state.inventory[seat][t_slot]; }
+	int getOpponentItem(int t_slot) const { return state.inventory[1 - seat][t_slot]; }
+	int getLiveRounds() const { return state.liveRounds; }
+	int getBlankRounds() const { return state.blankRounds; }
+	int getLoadedShots() const { return state.currentLoadedShots; }
+	bool getDoubleDamage() const { return state.doubleDamage; }
+	bool getOpponentPaused() const { return state.paused[1 - seat]; }
+	bool getKnowItsLive() const { return state.knowItsLive; }
+	bool getKnowItsBlank() const { return state.knowItsBlank; }
+
+	// returns the first slot holding t_item or -1
+	int findItem(int t_item) const
+	{
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			if (state.inventory[seat][index] == t_item)
+			{
+				return index;
+			}
+		}
+		return -1;
+	}
+
+private:
+	const BasicMatchState<Rules>& state;
+	int seat;
+};
+
+using Observation = BasicObservation<ClassicRules>;
+
+/// <summary>
+/// empty taser, full health, no items, player to move
+/// </summary>
+template <typename Rules>
+template <typename Config>
+void BasicMatchState<Rules>::reset(const Config& t_rules)
+{
+	for (int index = 0; index < SHOT_CAPACITY; index++)
+	{
+		taserArray[index] = 0;
+	}
+	round = 0;
+	currentShot = -1; // empty, the same as after the last shot of a round
+	currentLoadedShots = 0;
+	liveRounds = 0;
+	blankRounds = 0;
+
+	for (int seat = 0; seat < 2; seat++)
+	{
+		health[seat] = t_rules.startingHealth;
+		paused[seat] = false;
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			inventory[seat][index] = 0;
+		}
+	}
+	turn = PLAYER;
+
+	doubleDamage = false;
+	knowItsLive = false;
+	knowItsBlank = false;
+}
+
+/// <summary>
+/// loads taser, gives items and round starts on player's turn
+/// </summary>
+template <typename Rules>
+template <typename Config>
+void BasicMatchState<Rules>::startRound(FastRandom& t_random, const Config& t_rules)
+{
+	loadTaser(t_random, t_rules);
+	giveItems(t_random, t_rules);
+	turn = PLAYER;
+	round++;
+}
+
+/// <summary>
+/// randomly loads taser contents, at least one live and one blank
+/// </summary>
+template <typename Rules>
+template <typename Config>
+void BasicMatchState<Rules>::loadTaser(FastRandom& t_random, const Config& t_rules)
+{
+	loadRandomTaser(*this, t_random, t_rules);
+}
+
+/// <summary>
+/// gives both robots up to itemsPerRound items in their free slots
+/// </summary>
+template <typename Rules>
+template <typename Config>
+void BasicMatchState<Rules>::giveItems(FastRandom& t_random, const Config& t_rules)
+{
+	for (int seat = 0; seat < 2; seat++)
+	{
+		int itemsGiven = 0;
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			dealItem(inventory[seat][index], itemsGiven, t_random, t_rules);
+		}
+	}
+}
+
+/// <summary>
+/// t_seat shoots themselves, a blank keeps the turn going
+/// </summary>
+template <typename Rules>
+void BasicMatchState<Rules>::shootSelf(int t_seat)
+{
+	int damage = chargeDamage(*this);
+	if (fireShot(*this) == 1)
+	{
+		health[t_seat] -= damage;
+		passTurn(t_seat);
+	}
+}
+
+/// <summary>
+/// t_seat shoots the other robot, the turn always ends unless they're paused
+/// </summary>
+template <typename Rules>
+void BasicMatchState<Rules>::shootOpponent(int t_seat)
+{
+	int damage = chargeDamage(*this);
+	if (fireShot(*this) == 1)
+	{
+		health[1 - t_seat] -= damage;
+	}
+	passTurn(t_seat);
+}
+
+/// <summary>
+/// the other robot's turn, unless the pause remote holds them up for this one
+/// </summary>
+template <typename Rules>
+void BasicMatchState<Rules>::passTurn(int t_seat)
+{
+	if (paused[1 - t_seat]) // pause remote item
+	{
+		paused[1 - t_seat] = false;
+	}
+	else
+	{
+		turn = 1 - t_seat;
+	}
+}
+
+/// <summary>
+/// uses the item in t_slot and empties the slot
+/// </summary>
+template <typename Rules>
+void BasicMatchState<Rules>::useItem(int t_seat, int t_slot)
+{
+	int itemToUse = inventory[t_seat][t_slot];
+	inventory[t_seat][t_slot] = 0;
+
+	if (itemToUse == PAUSE_REMOTE)
+	{
+		paused[1 - t_seat] = true;
+	}
+	else
+	{
+		applyItemEffect(*this, itemToUse, t_seat);
+	}
+}
+
+/// <summary>
+/// apply() that remembers what it overwrote
+/// </summary>
+template <typename Rules>
+UndoRecord BasicMatchState<Rules>::makeMove(int t_seat, Action t_action)
+{
+	UndoRecord undo;
+	undo.action = t_action;
+	undo.seat = t_seat;
+	undo.health[PLAYER] = health[PLAYER];
+	undo.health[ENEMY] = health[ENEMY];
+	undo.turn = turn;
+	undo.item = t_action.type == USE_ITEM_ACTION ? inventory[t_seat][t_action.slot] : 0;
+	bool firesShot = t_action.type != USE_ITEM_ACTION || undo.item == RUBBISH_BIN;
+	undo.shot = firesShot ? taserArray[currentShot] : -1;
+	undo.doubleDamage = doubleDamage;
+	undo.paused[PLAYER] = paused[PLAYER];
+	undo.paused[ENEMY] = paused[ENEMY];
+	undo.knowItsLive = knowItsLive;
+	undo.knowItsBlank = knowItsBlank;
+	apply(t_seat, t_action);
+	return undo;
+}
+
+template <typename Rules>
+void BasicMatchState<Rules>::undoMove(const UndoRecord& t_undo)
+{
+	if (t_undo.shot != -1)
+	{
+		currentShot++;
+		currentLoadedShots++;
+		if (t_undo.shot == 1)
+		{
+			liveRounds++;
+		}
+		else
+		{
+			blankRounds++;
+		}
+	}
+	if (t_undo.action.type == USE_ITEM_ACTION)
+	{
+		inventory[t_undo.seat][t_undo.action.slot] = t_undo.item;
+	}
+	health[PLAYER] = t_undo.health[PLAYER];
+	health[ENEMY] = t_undo.health[ENEMY];
+	turn = t_undo.turn;
+	doubleDamage = t_undo.doubleDamage;
+	paused[PLAYER] = t_undo.paused[PLAYER];
+	paused[ENEMY] = t_undo.paused[ENEMY];
+	knowItsLive = t_undo.knowItsLive;
+	knowItsBlank = t_undo.knowItsBlank;
+}
+
+/// <summary>
+/// load number t_load of taserLoadCount, the bits of t_load + 1 are the shots (0 and all live can't happen)
+/// </summary>
+template <typename Rules>
+template <typename Config>
+void BasicMatchState<Rules>::loadTaserAt(std::uint64_t t_load, const Config& t_rules)
+{
+	std::uint64_t bits = t_load + 1;
+	liveRounds = 0;
+	blankRounds = 0;
+	for (int index = 0; index < t_rules.magazineSize; index++)
+	{
+		taserArray[index] = static_cast<int>((bits >> index) & 1);
+		if (taserArray[index] == 1)
+		{
+			liveRounds++;
+		}
+		else
+		{
+			blankRounds++;
+		}
+	}
+	currentLoadedShots = t_rules.magazineSize;
+	currentShot = t_rules.magazineSize - 1;
+	knowItsLive = false;
+	knowItsBlank = false;
+}
+
+/// <summary>
+/// giveItems fills each seat's first empty slots up to itemsPerRound, each with any item type
+/// </summary>
+template <int SLOTS, typename Config>
+int slotsToDeal(const int (&t_inventory)[SLOTS], const Config& t_rules)
+{
+	int empty = 0;
+	for (int index = 0; index < SLOTS; index++)
+	{
+		if (t_inventory[index] == 0)
+		{
+			empty++;
+		}
+	}
+	return empty < t_rules.itemsPerRound ? empty : t_rules.itemsPerRound;
+}
+
+template <typename Rules>
+template <typename Config>
+int BasicMatchState<Rules>::itemDealCount(const Config& t_rules) const
+{
+	int count = 1;
+	int slots = slotsToDeal(inventory[PLAYER], t_rules) + slotsToDeal(inventory[ENEMY], t_rules);
+	for (int slot = 0; slot < slots; slot++)
+	{
+		count *= ITEM_TYPES;
+	}
+	return count;
+}
+
+/// <summary>
+/// deal number t_deal of itemDealCount, read as base ITEM_TYPES digits one per slot filled.
+/// returns how likely that deal is, 0 for one that uses an item weighted out of the rules
+/// </summary>
+template <typename Rules>
+template <typename Config>
+double BasicMatchState<Rules>::dealItemsAt(int t_deal, const Config& t_rules)
+{
+	const int totalWeight = t_rules.totalItemWeight();
+	double chance = 1.0;
+	for (int seat = 0; seat < 2; seat++)
+	{
+		int itemsGiven = 0;
+		for (int index = 0; index < ITEM_CAPACITY && itemsGiven < t_rules.itemsPerRound; index++)
+		{
+			if (inventory[seat][index] != 0)
+			{
+				continue;
+			}
+			int item = t_deal % ITEM_TYPES;
+			t_deal /= ITEM_TYPES;
+			inventory[seat][index] = item + 1;
+			chance *= static_cast<double>(t_rules.itemWeight(item)) / totalWeight;
+			itemsGiven++;
+		}
+	}
+	return chance;
+}
+
+/// <summary>
+/// startRound with the chance events picked rather than drawn
+/// </summary>
+template <typename Rules>
+template <typename Config>
+RoundUndo BasicMatchState<Rules>::startRoundAt(std::uint64_t t_load, int t_deal, const Config& t_rules)
+{
+	RoundUndo undo;
+	undo.taserBits = 0;
+	for (int index = 0; index < SHOT_CAPACITY; index++)
+	{
+		undo.taserBits |= static_cast<std::uint64_t>(taserArray[index]) << index;
+	}
+	undo.currentShot = currentShot;
+	undo.currentLoadedShots = currentLoadedShots;
+	undo.liveRounds = liveRounds;
+	undo.blankRounds = blankRounds;
+	undo.turn = turn;
+	undo.knowItsLive = knowItsLive;
+	undo.knowItsBlank = knowItsBlank;
+	for (int seat = 0; seat < 2; seat++)
+	{
+		undo.dealtSlots[seat] = 0;
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			undo.dealtSlots[seat] |= (inventory[seat][index] == 0 ? 1 : 0) << index; // trimmed below
+		}
+	}
+
+	loadTaserAt(t_load, t_rules);
+	dealItemsAt(t_deal, t_rules);
+	turn = PLAYER;
+	round++;
+
+	for (int seat = 0; seat < 2; seat++)
+	{
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			if (inventory[seat][index] == 0)
+			{
+				undo.dealtSlots[seat] &= ~(1 << index); // was empty and still is
+			}
+		}
+	}
+	return undo;
+}
+
+template <typename Rules>
+void BasicMatchState<Rules>::undoRound(const RoundUndo& t_undo)
+{
+	for (int index = 0; index < SHOT_CAPACITY; index++)
+	{
+		taserArray[index] = static_cast<int>((t_undo.taserBits >> index) & 1);
+	}
+	currentShot = t_undo.currentShot;
+	currentLoadedShots = t_undo.currentLoadedShots;
+	liveRounds = t_undo.liveRounds;
+	blankRounds = t_undo.blankRounds;
+	turn = t_undo.turn;
+	knowItsLive = t_undo.knowItsLive;
+	knowItsBlank = t_undo.knowItsBlank;
+	for (int seat = 0; seat < 2; seat++)
+	{
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			if ((t_undo.dealtSlots[seat] >> index) & 1)
+			{
+				inventory[seat][index] = 0;
+			}
+		}
+	}
+	round--;
+}
+
+template <typename Rules>
+int BasicMatchState<Rules>::winner() const
+{
+	if (health[PLAYER] == health[ENEMY])
+	{
+		return NO_WINNER;
+	}
+	return health[PLAYER] > health[ENEMY] ? PLAYER : ENEMY;
+}
+
+/// <summary>
+/// FNV-1a over each field in declaration order, two machines holding the same match get the same number
+/// </summary>
+template <typename Rules>
+std::uint32_t BasicMatchState<Rules>::checksum() const
+{
+	std::uint32_t hash = 2166136261u;
+	auto mix = [&hash](int t_value)
+	{
+		std::uint32_t value = static_cast<std::uint32_t>(t_value);
+		for (int byte = 0; byte < 4; byte++)
+		{
+			hash ^= (value >> (byte * 8)) & 0xFF;
+			hash *= 16777619u;
+		}
+	};
+
+	mix(round);
+	for (int index = 0; index < SHOT_CAPACITY; index++)
+	{
+		mix(taserArray[index]);
+	}
+	mix(currentShot);
+	mix(currentLoadedShots);
+	mix(liveRounds);
+	mix(blankRounds);
+	for (int seat = 0; seat < 2; seat++)
+	{
+		mix(health[seat]);
+		for (int index = 0; index < ITEM_CAPACITY; index++)
+		{
+			mix(inventory[seat][index]);
+		}
+		mix(paused[seat]);
+	}
+	mix(turn);
+	mix(doubleDamage);
+	mix(knowItsLive);
+	mix(knowItsBlank);
+	return hash;
+}
+
+/// <summary>
+/// nothing is legal on an empty taser, otherwise shots always are and items only from a slot that holds one
+/// </summary>
+template <typename Rules>
+bool BasicMatchState<Rules>::isLegal(int t_seat, Action t_action) const
+{
+	if (needsNewRound())
+	{
+		return false; // nothing to shoot, scan or bin until startRound
+	}
+	if (t_action.type == USE_ITEM_ACTION)
+	{
+		return t_action.slot >= 0 && t_action.slot < ITEM_CAPACITY && inventory[t_seat][t_action.slot] != 0;
+	}
+	return t_action.type == SHOOT_SELF_ACTION || t_action.type == SHOOT_OPPONENT_ACTION;
+}
+
+/// <summary>
+/// carries out t_action for t_seat
+/// </summary>
+template <typename Rules>
+void BasicMatchState<Rules>::apply(int t_seat, Action t_action)
+{
+	switch (t_action.type)
+	{
+	case SHOOT_SELF_ACTION:
+		shootSelf(t_seat);
+		break;
+	case SHOOT_OPPONENT_ACTION:
+		shootOpponent(t_seat);
+		break;
+	case USE_ITEM_ACTION:
+		useItem(t_seat, t_action.slot);
+		break;
+	}
+}
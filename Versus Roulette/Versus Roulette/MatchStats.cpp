@@ -0,0 +1,535 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "MatchStats.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const double SKETCH_ACCURACY = 0.01;
+static const double SKETCH_GAMMA = (1.0 + SKETCH_ACCURACY) / (1.0 - SKETCH_ACCURACY);
+static const double SKETCH_INVERSE_LOG_GAMMA = 1.0 / std::log(SKETCH_GAMMA);
+
+static const char STATS_MAGIC[4] = { 'V', 'R', 'S', 'T' };
+static const std::uint32_t STATS_VERSION = 1;
+
+static const char* ITEM_NAMES[ITEM_TYPES] = { "oil_drink", "scanner", "pause_remote", "overcharger", "rubbish_bin" };
+static const char* SEAT_NAMES[2] = { "player", "enemy" };
+
+static const long long STATS_BLOCK_GAMES = 4096;
+
+/// <summary>
+/// unsigned LEB128, small counts take one byte which keeps the binary export compact
+/// </summary>
+static void writeVarint(std::ostream& t_out, std::uint64_t t_value)
+{
+	while (t_value >= 0x80)
+	{
+		t_out.put(static_cast<char>((t_value & 0x7F) | 0x80));
+		t_value >>= 7;
+	}
+	t_out.put(static_cast<char>(t_value));
+}
+
+static bool readVarint(std::istream& t_in, std::uint64_t& t_value)
+{
+	t_value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		int byte = t_in.get();
+		if (byte == EOF)
+		{
+			return false;
+		}
+		t_value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static void writeDouble(std::ostream& t_out, double t_value)
+{
+	t_out.write(reinterpret_cast<const char*>(&t_value), sizeof(t_value));
+}
+
+static bool readDouble(std::istream& t_in, double& t_value)
+{
+	return static_cast<bool>(t_in.read(reinterpret_cast<char*>(&t_value), sizeof(t_value)));
+}
+
+QuantileSketch::QuantileSketch() :
+	zeroCount{ 0 },
+	count{ 0 },
+	sum{ 0.0 },
+	minValue{ 0.0 },
+	maxValue{ 0.0 }
+{
+	std::fill(buckets, buckets + BUCKETS, 0LL);
+}
+
+void QuantileSketch::add(double t_value)
+{
+	if (count == 0 || t_value < minValue)
+	{
+		minValue = t_value;
+	}
+	if (count == 0 || t_value > maxValue)
+	{
+		maxValue = t_value;
+	}
+	count++;
+	sum += t_value;
+
+	if (t_value <= 0.0)
+	{
+		zeroCount++;
+		return;
+	}
+	int bucket = static_cast<int>(std::ceil(std::log(t_value) * SKETCH_INVERSE_LOG_GAMMA));
+	buckets[std::min(std::max(bucket, 0), BUCKETS - 1)]++;
+}
+
+void QuantileSketch::merge(const QuantileSketch& t_other)
+{
+	if (t_other.count == 0)
+	{
+		return;
+	}
+	if (count == 0 || t_other.minValue < minValue)
+	{
+		minValue = t_other.minValue;
+	}
+	if (count == 0 || t_other.maxValue > maxValue)
+	{
+		maxValue = t_other.maxValue;
+	}
+	count += t_other.count;
+	sum += t_other.sum;
+	zeroCount += t_other.zeroCount;
+	for (int index = 0; index < BUCKETS; index++)
+	{
+		buckets[index] += t_other.buckets[index];
+	}
+}
+
+/// <summary>
+/// value at t_fraction (0.5 median, 0.99 for p99), within SKETCH_ACCURACY of the real one
+/// </summary>
+double QuantileSketch::quantile(double t_fraction) const
+{
+	if (count == 0)
+	{
+		return 0.0;
+	}
+	long long rank = static_cast<long long>(t_fraction * (count - 1));
+	if (rank < zeroCount)
+	{
+		return minValue; // zero or negative values, minValue is the best estimate we have
+	}
+	long long seen = zeroCount;
+	for (int index = 0; index < BUCKETS; index++)
+	{
+		seen += buckets[index];
+		if (seen > rank)
+		{
+			double estimate = 2.0 * std::pow(SKETCH_GAMMA, index) / (SKETCH_GAMMA + 1.0);
+			return std::min(maxValue, std::max(minValue, estimate));
+		}
+	}
+	return maxValue;
+}
+
+/// <summary>
+/// only non empty buckets are written, as (gap from previous bucket, count) varint pairs
+/// </summary>
+void QuantileSketch::writeBinary(std::ostream& t_out) const
+{
+	writeVarint(t_out, static_cast<std::uint64_t>(count));
+	writeVarint(t_out, static_cast<std::uint64_t>(zeroCount));
+	writeDouble(t_out, sum);
+	writeDouble(t_out, minValue);
+	writeDouble(t_out, maxValue);
+
+	int used = 0;
+	for (int index = 0; index < BUCKETS; index++)
+	{
+		if (buckets[index] != 0)
+		{
+			used++;
+		}
+	}
+	writeVarint(t_out, static_cast<std::uint64_t>(used));
+	int previous = 0;
+	for (int index = 0; index < BUCKETS; index++)
+	{
+		if (buckets[index] != 0)
+		{
+			writeVarint(t_out, static_cast<std::uint64_t>(index - previous));
+			writeVarint(t_out, static_cast<std::uint64_t>(buckets[index]));
+			previous = index;
+		}
+	}
+}
+
+bool QuantileSketch::readBinary(std::istream& t_in)
+{
+	*this = QuantileSketch();
+	std::uint64_t value = 0;
+	if (!readVarint(t_in, value))
+	{
+		return false;
+	}
+	count = static_cast<long long>(value);
+	if (!readVarint(t_in, value))
+	{
+		return false;
+	}
+	zeroCount = static_cast<long long>(value);
+	if (!readDouble(t_in, sum) || !readDouble(t_in, minValue) || !readDouble(t_in, maxValue))
+	{
+		return false;
+	}
+
+	std::uint64_t used = 0;
+	if (!readVarint(t_in, used))
+	{
+		return false;
+	}
+	int index = 0;
+	for (std::uint64_t bucket = 0; bucket < used; bucket++)
+	{
+		std::uint64_t gap = 0;
+		if (!readVarint(t_in, gap) || !readVarint(t_in, value))
+		{
+			return false;
+		}
+		index += static_cast<int>(gap);
+		if (index < 0 || index >= BUCKETS)
+		{
+			return false;
+		}
+		buckets[index] = static_cast<long long>(value);
+	}
+	return true;
+}
+
+MatchStats::MatchStats() :
+	matches{ 0 },
+	wins{ 0, 0 },
+	draws{ 0 },
+	rounds{ 0 },
+	shots{ 0 },
+	selfLiveDamage{ 0, 0 },
+	opponentDamage{ 0, 0 },
+	overchargedDamage{ 0, 0 },
+	shotsThisRound{ 0 },
+	actionsThisMatch{ 0 }
+{
+	for (int seat = 0; seat < 2; seat++)
+	{
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			itemUses[seat][item] = 0;
+		}
+	}
+}
+
+/// <summary>
+/// closes off the round that was running, if any
+/// </summary>
+void MatchStats::finishRound()
+{
+	if (shotsThisRound > 0)
+	{
+		shotsPerRound.add(shotsThisRound);
+	}
+	shotsThisRound = 0;
+}
+
+void MatchStats::onRoundStart(const MatchState&)
+{
+	finishRound();
+	rounds++;
+}
+
+void MatchStats::onAction(const MatchState& t_before, int t_seat, Action t_action, const MatchState& t_after)
+{
+	actionsThisMatch++;
+	if (t_action.type == USE_ITEM_ACTION)
+	{
+		int item = t_before.inventory[t_seat][t_action.slot];
+		if (item >= OIL_DRINK && item <= RUBBISH_BIN)
+		{
+			itemUses[t_seat][item - 1]++;
+		}
+		return;
+	}
+
+	shots++;
+	shotsThisRound++;
+	int target = t_action.type == SHOOT_SELF_ACTION ? t_seat : 1 - t_seat;
+	int damage = t_before.health[target] - t_after.health[target];
+	if (damage <= 0)
+	{
+		return;
+	}
+	if (t_action.type == SHOOT_SELF_ACTION)
+	{
+		selfLiveDamage[target] += damage;
+	}
+	else
+	{
+		opponentDamage[target] += damage;
+	}
+	if (t_before.doubleDamage)
+	{
+		overchargedDamage[target] += damage / 2;
+	}
+}
+
+void MatchStats::onMatchEnd(const MatchState& t_state, int t_winner)
+{
+	finishRound();
+	matches++;
+	if (t_winner == NO_WINNER)
+	{
+		draws++;
+	}
+	else
+	{
+		wins[t_winner]++;
+	}
+	roundsPerMatch.add(t_state.round);
+	actionsPerMatch.add(actionsThisMatch);
+	actionsThisMatch = 0;
+}
+
+void MatchStats::merge(const MatchStats& t_other)
+{
+	matches += t_other.matches;
+	draws += t_other.draws;
+	rounds += t_other.rounds;
+	shots += t_other.shots;
+	for (int seat = 0; seat < 2; seat++)
+	{
+		wins[seat] += t_other.wins[seat];
+		selfLiveDamage[seat] += t_other.selfLiveDamage[seat];
+		opponentDamage[seat] += t_other.opponentDamage[seat];
+		overchargedDamage[seat] += t_other.overchargedDamage[seat];
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			itemUses[seat][item] += t_other.itemUses[seat][item];
+		}
+	}
+	roundsPerMatch.merge(t_other.roundsPerMatch);
+	shotsPerRound.merge(t_other.shotsPerRound);
+	actionsPerMatch.merge(t_other.actionsPerMatch);
+}
+
+/// <summary>
+/// one "metric,value" row per number
+/// </summary>
+void MatchStats::writeCsv(std::ostream& t_out) const
+{
+	t_out << "metric,value\n";
+	t_out << "matches," << matches << "\n";
+	t_out << "draws," << draws << "\n";
+	for (int seat = 0; seat < 2; seat++)
+	{
+		t_out << SEAT_NAMES[seat] << "_wins," << wins[seat] << "\n";
+		t_out << SEAT_NAMES[seat] << "_win_rate," << getWinRate(seat) << "\n";
+	}
+	t_out << "rounds," << rounds << "\n";
+	t_out << "shots," << shots << "\n";
+
+	const QuantileSketch* sketches[3] = { &roundsPerMatch, &shotsPerRound, &actionsPerMatch };
+	const char* sketchNames[3] = { "rounds_per_match", "shots_per_round", "actions_per_match" };
+	for (int index = 0; index < 3; index++)
+	{
+		t_out << sketchNames[index] << "_mean," << sketches[index]->getMean() << "\n";
+		t_out << sketchNames[index] << "_min," << sketches[index]->getMin() << "\n";
+		t_out << sketchNames[index] << "_p50," << sketches[index]->quantile(0.5) << "\n";
+		t_out << sketchNames[index] << "_p90," << sketches[index]->quantile(0.9) << "\n";
+		t_out << sketchNames[index] << "_p99," << sketches[index]->quantile(0.99) << "\n";
+		t_out << sketchNames[index] << "_max," << sketches[index]->getMax() << "\n";
+	}
+
+	for (int seat = 0; seat < 2; seat++)
+	{
+		t_out << SEAT_NAMES[seat] << "_damage_self_live," << selfLiveDamage[seat] << "\n";
+		t_out << SEAT_NAMES[seat] << "_damage_from_opponent," << opponentDamage[seat] << "\n";
+		t_out << SEAT_NAMES[seat] << "_damage_overcharged," << overchargedDamage[seat] << "\n";
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			t_out << SEAT_NAMES[seat] << "_used_" << ITEM_NAMES[item] << "," << itemUses[seat][item] << "\n";
+		}
+	}
+}
+
+/// <summary>
+/// magic, version, then every counter as a varint followed by the three sketches
+/// </summary>
+void MatchStats::writeBinary(std::ostream& t_out) const
+{
+	t_out.write(STATS_MAGIC, sizeof(STATS_MAGIC));
+	writeVarint(t_out, STATS_VERSION);
+
+	writeVarint(t_out, static_cast<std::uint64_t>(matches));
+	writeVarint(t_out, static_cast<std::uint64_t>(draws));
+	writeVarint(t_out, static_cast<std::uint64_t>(rounds));
+	writeVarint(t_out, static_cast<std::uint64_t>(shots));
+	for (int seat = 0; seat < 2; seat++)
+	{
+		writeVarint(t_out, static_cast<std::uint64_t>(wins[seat]));
+		writeVarint(t_out, static_cast<std::uint64_t>(selfLiveDamage[seat]));
+		writeVarint(t_out, static_cast<std::uint64_t>(opponentDamage[seat]));
+		writeVarint(t_out, static_cast<std::uint64_t>(overchargedDamage[seat]));
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			writeVarint(t_out, static_cast<std::uint64_t>(itemUses[seat][item]));
+		}
+	}
+	roundsPerMatch.writeBinary(t_out);
+	shotsPerRound.writeBinary(t_out);
+	actionsPerMatch.writeBinary(t_out);
+}
+
+bool MatchStats::readBinary(std::istream& t_in)
+{
+	*this = MatchStats();
+	char magic[4];
+	std::uint64_t version = 0;
+	if (!t_in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, STATS_MAGIC)
+		|| !readVarint(t_in, version) || version != STATS_VERSION)
+	{
+		return false;
+	}
+
+	long long* counters[4] = { &matches, &draws, &rounds, &shots };
+	std::uint64_t value = 0;
+	for (long long* counter : counters)
+	{
+		if (!readVarint(t_in, value))
+		{
+			return false;
+		}
+		*counter = static_cast<long long>(value);
+	}
+	for (int seat = 0; seat < 2; seat++)
+	{
+		long long* seatCounters[4] = { &wins[seat], &selfLiveDamage[seat], &opponentDamage[seat], &overchargedDamage[seat] };
+		for (long long* counter : seatCounters)
+		{
+			if (!readVarint(t_in, value))
+			{
+				return false;
+			}
+			*counter = static_cast<long long>(value);
+		}
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			if (!readVarint(t_in, value))
+			{
+				return false;
+			}
+			itemUses[seat][item] = static_cast<long long>(value);
+		}
+	}
+	return roundsPerMatch.readBinary(t_in) && shotsPerRound.readBinary(t_in) && actionsPerMatch.readBinary(t_in);
+}
+
+void MatchStats::printSummary(std::ostream& t_out) const
+{
+	t_out << matches << " matches | player wins " << 100.0 * getWinRate(PLAYER) << "% | enemy wins "
+		<< 100.0 * getWinRate(ENEMY) << "% | draws " << draws << std::endl;
+	t_out << "rounds per match p50 " << roundsPerMatch.quantile(0.5) << " p99 " << roundsPerMatch.quantile(0.99)
+		<< " | shots per round p50 " << shotsPerRound.quantile(0.5) << " mean " << shotsPerRound.getMean() << std::endl;
+	for (int seat = 0; seat < 2; seat++)
+	{
+		t_out << SEAT_NAMES[seat] << " damage: self " << selfLiveDamage[seat] << ", opponent " << opponentDamage[seat]
+			<< ", overcharged " << overchargedDamage[seat] << " | items used:";
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			t_out << " " << ITEM_NAMES[item] << " " << itemUses[seat][item];
+		}
+		t_out << std::endl;
+	}
+}
+
+void runStatisticsCollection(long long t_matches, std::uint64_t t_seed, const std::string& t_csvPath, const std::string& t_binaryPath)
+{
+	int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	const long long blockCount = (t_matches + STATS_BLOCK_GAMES - 1) / STATS_BLOCK_GAMES;
+	std::atomic<long long> nextBlock{ 0 };
+	std::vector<MatchStats> threadStats(threadCount);
+
+	auto worker = [&](int t_thread)
+	{
+		MatchStats stats; // thread local until the end, merged once after join
+		MatchState state;
+		HeuristicPolicy playerPolicy;
+		HeuristicPolicy enemyPolicy;
+		for (long long block = nextBlock++; block < blockCount; block = nextBlock++)
+		{
+			FastRandom random(t_seed ^ (static_cast<std::uint64_t>(block) * 0xD1B54A32D192ED03ULL));
+			long long lastGame = std::min((block + 1) * STATS_BLOCK_GAMES, t_matches);
+			for (long long game = block * STATS_BLOCK_GAMES; game < lastGame; game++)
+			{
+				playMatch(state, playerPolicy, enemyPolicy, random, DEFAULT_RULES, stats);
+			}
+		}
+		threadStats[t_thread] = stats;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int thread = 1; thread < threadCount; thread++)
+	{
+		threads.emplace_back(worker, thread);
+	}
+	worker(0);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	MatchStats total;
+	for (const MatchStats& stats : threadStats)
+	{
+		total.merge(stats);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	total.printSummary(std::cout);
+	std::cout << threadCount << " threads, " << static_cast<long long>(t_matches / std::max(seconds, 1e-9)) << " matches/s" << std::endl;
+
+	if (!t_csvPath.empty())
+	{
+		std::ofstream csv(t_csvPath);
+		if (!csv)
+		{
+			std::cout << "problem writing stats csv " << t_csvPath << std::endl;
+		}
+		total.writeCsv(csv);
+	}
+	if (!t_binaryPath.empty())
+	{
+		std::ofstream binary(t_binaryPath, std::ios::binary);
+		if (!binary)
+		{
+			std::cout << "problem writing stats file " << t_binaryPath << std::endl;
+		}
+		total.writeBinary(binary);
+	}
+}
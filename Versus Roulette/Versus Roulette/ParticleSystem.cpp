@@ -0,0 +1,408 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "ParticleSystem.h"
+#include "Globals.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+const float static PARTICLE_TICK_SECONDS = 1.0f / 60.0f;
+const int static GLOW_TEXTURE_SIZE = 16;
+
+ParticlePool::ParticlePool() :
+	count(0),
+	x(PARTICLE_CAPACITY, 0.0f),
+	y(PARTICLE_CAPACITY, 0.0f),
+	velocityX(PARTICLE_CAPACITY, 0.0f),
+	velocityY(PARTICLE_CAPACITY, 0.0f),
+	life(PARTICLE_CAPACITY, 0.0f),
+	fade(PARTICLE_CAPACITY, 0.0f),
+	size(PARTICLE_CAPACITY, 0.0f),
+	colour(PARTICLE_CAPACITY, 0u)
+{
+}
+
+/// <summary>
+/// adds a particle at the end of the live ones, false when the pool is full
+/// </summary>
+bool ParticlePool::spawn(float t_x, float t_y, float t_velocityX, float t_velocityY, float t_lifespan, float t_size, sf::Color t_colour)
+{
+	if (count >= PARTICLE_CAPACITY)
+	{
+		return false;
+	}
+	x[count] = t_x;
+	y[count] = t_y;
+	velocityX[count] = t_velocityX;
+	velocityY[count] = t_velocityY;
+	life[count] = 1.0f;
+	fade[count] = 1.0f / std::max(t_lifespan, 0.001f);
+	size[count] = t_size;
+	colour[count] = (static_cast<std::uint32_t>(t_colour.r) << 24) | (static_cast<std::uint32_t>(t_colour.g) << 16)
+		| (static_cast<std::uint32_t>(t_colour.b) << 8) | t_colour.a;
+	count++;
+	return true;
+}
+
+/// <summary>
+/// four particles at a time. the capacity is a multiple of 4 so the last group can run past count
+/// into spare slots, anything it writes there is never read as a live particle
+/// </summary>
+void ParticlePool::update(float t_seconds, const ParticleMotion& t_motion)
+{
+#ifdef PARTICLES_USE_SSE
+	const __m128 seconds = _mm_set1_ps(t_seconds);
+	const __m128 drag = _mm_set1_ps(t_motion.drag);
+	const __m128 fall = _mm_set1_ps(t_motion.gravity * t_seconds);
+	const __m128 left = _mm_set1_ps(t_motion.bounds.left);
+	const __m128 right = _mm_set1_ps(t_motion.bounds.left + t_motion.bounds.width);
+	const __m128 top = _mm_set1_ps(t_motion.bounds.top);
+	const __m128 bottom = _mm_set1_ps(t_motion.bounds.top + t_motion.bounds.height);
+	const __m128 zero = _mm_setzero_ps();
+	int anyDead = 0;
+	for (int index = 0; index < count; index += 4)
+	{
+		__m128 speedX = _mm_mul_ps(_mm_loadu_ps(&velocityX[index]), drag);
+		__m128 speedY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&velocityY[index]), drag), fall);
+		__m128 positionX = _mm_add_ps(_mm_loadu_ps(&x[index]), _mm_mul_ps(speedX, seconds));
+		__m128 positionY = _mm_add_ps(_mm_loadu_ps(&y[index]), _mm_mul_ps(speedY, seconds));
+		__m128 remaining = _mm_sub_ps(_mm_loadu_ps(&life[index]), _mm_mul_ps(_mm_loadu_ps(&fade[index]), seconds));
+		__m128 keep = _mm_and_ps(_mm_cmpgt_ps(remaining, zero),
+			_mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(positionX, left), _mm_cmplt_ps(positionX, right)),
+				_mm_and_ps(_mm_cmpgt_ps(positionY, top), _mm_cmplt_ps(positionY, bottom))));
+		_mm_storeu_ps(&velocityX[index], speedX);
+		_mm_storeu_ps(&velocityY[index], speedY);
+		_mm_storeu_ps(&x[index], positionX);
+		_mm_storeu_ps(&y[index], positionY);
+		_mm_storeu_ps(&life[index], _mm_and_ps(remaining, keep)); // culled ones read as dead
+		anyDead |= (_mm_movemask_ps(keep) ^ 0xF) & ((1 << std::min(4, count - index)) - 1); // padding lanes past count always read dead
+	}
+	if (anyDead != 0)
+	{
+		removeDead();
+	}
+#else
+	updateScalar(t_seconds, t_motion);
+#endif
+}
+
+void ParticlePool::updateScalar(float t_seconds, const ParticleMotion& t_motion)
+{
+	const float fall = t_motion.gravity * t_seconds;
+	const float right = t_motion.bounds.left + t_motion.bounds.width;
+	const float bottom = t_motion.bounds.top + t_motion.bounds.height;
+	bool anyDead = false;
+	for (int index = 0; index < count; index++)
+	{
+		velocityX[index] = velocityX[index] * t_motion.drag;
+		velocityY[index] = velocityY[index] * t_motion.drag + fall;
+		x[index] += velocityX[index] * t_seconds;
+		y[index] += velocityY[index] * t_seconds;
+		life[index] -= fade[index] * t_seconds;
+		bool inside = x[index] > t_motion.bounds.left && x[index] < right && y[index] > t_motion.bounds.top && y[index] < bottom;
+		if (life[index] <= 0.0f || !inside)
+		{
+			life[index] = 0.0f;
+			anyDead = true;
+		}
+	}
+	if (anyDead)
+	{
+		removeDead();
+	}
+}
+
+/// <summary>
+/// fills the last live particle into each dead one's place
+/// </summary>
+void ParticlePool::removeDead()
+{
+	int index = 0;
+	while (index < count)
+	{
+		if (life[index] > 0.0f)
+		{
+			index++;
+			continue;
+		}
+		count--;
+		x[index] = x[count];
+		y[index] = y[count];
+		velocityX[index] = velocityX[count];
+		velocityY[index] = velocityY[count];
+		life[index] = life[count];
+		fade[index] = fade[count];
+		size[index] = size[count];
+		colour[index] = colour[count];
+	}
+}
+
+/// <summary>
+/// a quad per particle over the whole texture, fading and shrinking as its life runs out.
+/// t_vertices only grows the first time it's asked for more, after that it's rewritten in place
+/// </summary>
+void ParticlePool::buildVertices(sf::VertexArray& t_vertices, const sf::Vector2u& t_textureSize) const
+{
+	const float width = static_cast<float>(t_textureSize.x);
+	const float height = static_cast<float>(t_textureSize.y);
+	t_vertices.resize(static_cast<std::size_t>(count) * 4);
+	for (int index = 0; index < count; index++)
+	{
+		const std::uint32_t rgba = colour[index];
+		const float remaining = life[index];
+		const sf::Color tint(static_cast<sf::Uint8>(rgba >> 24), static_cast<sf::Uint8>(rgba >> 16), static_cast<sf::Uint8>(rgba >> 8),
+			static_cast<sf::Uint8>((rgba & 0xFF) * remaining));
+		const float half = size[index] * (0.5f + 0.5f * remaining);
+		const float left = x[index] - half;
+		const float right = x[index] + half;
+		const float top = y[index] - half;
+		const float bottom = y[index] + half;
+		sf::Vertex* quad = &t_vertices[static_cast<std::size_t>(index) * 4];
+		quad[0] = sf::Vertex(sf::Vector2f(left, top), tint, sf::Vector2f(0.0f, 0.0f));
+		quad[1] = sf::Vertex(sf::Vector2f(right, top), tint, sf::Vector2f(width, 0.0f));
+		quad[2] = sf::Vertex(sf::Vector2f(right, bottom), tint, sf::Vector2f(width, height));
+		quad[3] = sf::Vertex(sf::Vector2f(left, bottom), tint, sf::Vector2f(0.0f, height));
+	}
+}
+
+ParticleSystem::ParticleSystem() :
+	random(0x5041525449434C45ULL)
+{
+	const sf::FloatRect screen(-32.0f, -32.0f, SCREEN_WIDTH + 64.0f, SCREEN_HEIGHT + 64.0f);
+	motions[PARTICLE_GLOW] = ParticleMotion{ -40.0f, 0.94f, screen };
+	motions[PARTICLE_CHUNK] = ParticleMotion{ 900.0f, 0.985f, screen };
+	for (int layer = 0; layer < PARTICLE_LAYERS; layer++)
+	{
+		// room for a full pool now, so drawing never has to grow it
+		vertices[layer].setPrimitiveType(sf::Quads);
+		vertices[layer].resize(static_cast<std::size_t>(PARTICLE_CAPACITY) * 4);
+		vertices[layer].clear();
+	}
+}
+
+/// <summary>
+/// a soft round dot for the glow layer and a plain white speck for the chunks, made rather than loaded
+/// </summary>
+void ParticleSystem::setup()
+{
+	std::vector<sf::Uint8> pixels(GLOW_TEXTURE_SIZE * GLOW_TEXTURE_SIZE * 4);
+	const float centre = (GLOW_TEXTURE_SIZE - 1) / 2.0f;
+	for (int row = 0; row < GLOW_TEXTURE_SIZE; row++)
+	{
+		for (int column = 0; column < GLOW_TEXTURE_SIZE; column++)
+		{
+			float distance = std::sqrt((row - centre) * (row - centre) + (column - centre) * (column - centre)) / (centre + 0.5f);
+			float strength = std::max(0.0f, 1.0f - distance);
+			sf::Uint8* pixel = &pixels[(row * GLOW_TEXTURE_SIZE + column) * 4];
+			pixel[0] = 255;
+			pixel[1] = 255;
+			pixel[2] = 255;
+			pixel[3] = static_cast<sf::Uint8>(255.0f * strength * strength);
+		}
+	}
+	sf::Image glow;
+	glow.create(GLOW_TEXTURE_SIZE, GLOW_TEXTURE_SIZE, pixels.data());
+	if (!textures[PARTICLE_GLOW].loadFromImage(glow))
+	{
+		LOG_ERROR("problem making the particle glow texture");
+	}
+	textures[PARTICLE_GLOW].setSmooth(true);
+
+	const sf::Uint8 white[2 * 2 * 4] = { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 };
+	sf::Image chunk;
+	chunk.create(2, 2, white);
+	if (!textures[PARTICLE_CHUNK].loadFromImage(chunk))
+	{
+		LOG_ERROR("problem making the particle chunk texture");
+	}
+}
+
+/// <summary>
+/// a jagged bolt from the taser to whoever it hit, built from a random walk either side of the straight line
+/// </summary>
+void ParticleSystem::emitTaserArc(sf::Vector2f t_from, sf::Vector2f t_to)
+{
+	const int segments = 24;
+	const float lengthX = t_to.x - t_from.x;
+	const float lengthY = t_to.y - t_from.y;
+	const float length = std::max(std::sqrt(lengthX * lengthX + lengthY * lengthY), 1.0f);
+	const float normalX = -lengthY / length;
+	const float normalY = lengthX / length;
+	float offset = 0.0f;
+	for (int segment = 0; segment <= segments; segment++)
+	{
+		float along = static_cast<float>(segment) / segments;
+		offset += static_cast<float>(random.nextDouble() - 0.5) * 14.0f;
+		offset *= 1.0f - along * along; // pinned at both ends
+		float pointX = t_from.x + lengthX * along + normalX * offset;
+		float pointY = t_from.y + lengthY * along + normalY * offset;
+		for (int spark = 0; spark < 12; spark++)
+		{
+			pools[PARTICLE_GLOW].spawn(pointX, pointY,
+				static_cast<float>(random.nextDouble() - 0.5) * 80.0f, static_cast<float>(random.nextDouble() - 0.5) * 80.0f,
+				0.12f + static_cast<float>(random.nextDouble()) * 0.18f, 3.0f + static_cast<float>(random.nextDouble()) * 2.0f,
+				sf::Color(170, 210, 255));
+		}
+	}
+}
+
+/// <summary>
+/// specks thrown up and out from a hit that fall away
+/// </summary>
+void ParticleSystem::emitSparks(sf::Vector2f t_at, int t_count)
+{
+	for (int spark = 0; spark < t_count; spark++)
+	{
+		float angle = static_cast<float>(random.nextDouble()) * 3.1415927f + 3.1415927f; // the upper half
+		float speed = 120.0f + static_cast<float>(random.nextDouble()) * 360.0f;
+		sf::Color tint = random.nextInt(3) == 0 ? sf::Color(255, 140, 40) : sf::Color(255, 230, 120);
+		pools[PARTICLE_CHUNK].spawn(t_at.x, t_at.y, std::cos(angle) * speed, std::sin(angle) * speed,
+			0.35f + static_cast<float>(random.nextDouble()) * 0.55f, 1.5f + static_cast<float>(random.nextDouble()), tint);
+	}
+}
+
+/// <summary>
+/// green motes drifting up off a battery, more for each charge lost
+/// </summary>
+void ParticleSystem::emitBatteryDrain(sf::Vector2f t_at, int t_charges)
+{
+	for (int mote = 0; mote < 60 * t_charges; mote++)
+	{
+		pools[PARTICLE_GLOW].spawn(t_at.x + static_cast<float>(random.nextDouble() - 0.5) * 40.0f, t_at.y + static_cast<float>(random.nextDouble() - 0.5) * 40.0f,
+			static_cast<float>(random.nextDouble() - 0.5) * 40.0f, -30.0f - static_cast<float>(random.nextDouble()) * 60.0f,
+			0.6f + static_cast<float>(random.nextDouble()) * 0.6f, 3.0f + static_cast<float>(random.nextDouble()), sf::Color(90, 230, 110));
+	}
+}
+
+void ParticleSystem::update()
+{
+	for (int layer = 0; layer < PARTICLE_LAYERS; layer++)
+	{
+		pools[layer].update(PARTICLE_TICK_SECONDS, motions[layer]);
+	}
+}
+
+void ParticleSystem::draw(RenderBackend& t_renderer)
+{
+	for (int layer = 0; layer < PARTICLE_LAYERS; layer++)
+	{
+		if (pools[layer].getCount() == 0)
+		{
+			continue;
+		}
+		pools[layer].buildVertices(vertices[layer], textures[layer].getSize());
+		sf::RenderStates states(&textures[layer]);
+		states.blendMode = layer == PARTICLE_GLOW ? sf::BlendAdd : sf::BlendAlpha;
+		t_renderer.draw(vertices[layer], states);
+	}
+}
+
+void ParticleSystem::clear()
+{
+	for (int layer = 0; layer < PARTICLE_LAYERS; layer++)
+	{
+		pools[layer].clear();
+	}
+}
+
+int ParticleSystem::getCount() const
+{
+	int total = 0;
+	for (int layer = 0; layer < PARTICLE_LAYERS; layer++)
+	{
+		total += pools[layer].getCount();
+	}
+	return total;
+}
+
+/// <summary>
+/// one run of the benchmark, t_simd picks the update. the pool is topped back up to t_particles
+/// before every frame from the same seed, so both runs see the same particles
+/// </summary>
+static void timeParticles(int t_particles, int t_frames, bool t_simd, double& t_updateMs, double& t_verticesMs, int& t_moves, int& t_finalCount)
+{
+	ParticlePool pool;
+	ParticleMotion motion{ 300.0f, 0.99f, sf::FloatRect(-32.0f, -32.0f, SCREEN_WIDTH + 64.0f, SCREEN_HEIGHT + 64.0f) };
+	FastRandom random(1);
+	sf::VertexArray vertices(sf::Quads);
+	vertices.resize(static_cast<std::size_t>(PARTICLE_CAPACITY) * 4);
+	vertices.clear();
+	const sf::Vertex* storage = nullptr;
+	t_updateMs = 0.0;
+	t_verticesMs = 0.0;
+	t_moves = 0;
+	for (int frame = 0; frame < t_frames; frame++)
+	{
+		while (pool.getCount() < t_particles)
+		{
+			pool.spawn(static_cast<float>(random.nextDouble()) * SCREEN_WIDTH, static_cast<float>(random.nextDouble()) * SCREEN_HEIGHT,
+				static_cast<float>(random.nextDouble() - 0.5) * 200.0f, static_cast<float>(random.nextDouble() - 0.5) * 200.0f,
+				0.5f + static_cast<float>(random.nextDouble()) * 1.5f, 2.0f, sf::Color(255, 220, 120));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		if (t_simd)
+		{
+			pool.update(PARTICLE_TICK_SECONDS, motion);
+		}
+		else
+		{
+			pool.updateScalar(PARTICLE_TICK_SECONDS, motion);
+		}
+		auto updated = std::chrono::steady_clock::now();
+		pool.buildVertices(vertices, sf::Vector2u(2, 2));
+		auto built = std::chrono::steady_clock::now();
+		t_updateMs += std::chrono::duration<double, std::milli>(updated - start).count();
+		t_verticesMs += std::chrono::duration<double, std::milli>(built - updated).count();
+
+		if (vertices.getVertexCount() > 0)
+		{
+			if (storage != nullptr && storage != &vertices[0])
+			{
+				t_moves++; // the vertex array had to grow, which would be an allocation mid game
+			}
+			storage = &vertices[0];
+		}
+	}
+	t_finalCount = pool.getCount();
+}
+
+void runParticleBenchmark(int t_particles, int t_frames)
+{
+	const int particles = std::clamp(t_particles, 1, PARTICLE_CAPACITY);
+	const int frames = std::max(t_frames, 1);
+	double simdUpdateMs = 0.0;
+	double scalarUpdateMs = 0.0;
+	double simdVerticesMs = 0.0;
+	double scalarVerticesMs = 0.0;
+	int simdMoves = 0;
+	int scalarMoves = 0;
+	int simdCount = 0;
+	int scalarCount = 0;
+	timeParticles(particles, frames, true, simdUpdateMs, simdVerticesMs, simdMoves, simdCount);
+	timeParticles(particles, frames, false, scalarUpdateMs, scalarVerticesMs, scalarMoves, scalarCount);
+
+	const double frameMs = 1000.0 / 60.0;
+	double simdFrame = (simdUpdateMs + simdVerticesMs) / frames;
+#ifdef PARTICLES_USE_SSE
+	const char* simdName = "SSE";
+#else
+	const char* simdName = "scalar (no SSE in this build)";
+#endif
+	std::cout << particles << " particles for " << frames << " frames, per frame:" << std::endl;
+	std::cout << "  update " << simdName << " " << simdUpdateMs * 1000.0 / frames << "us, one at a time " << scalarUpdateMs * 1000.0 / frames
+		<< "us (" << scalarUpdateMs / std::max(simdUpdateMs, 1e-9) << "x)" << std::endl;
+	std::cout << "  vertices " << simdVerticesMs * 1000.0 / frames << "us" << std::endl;
+	std::cout << "  total " << simdFrame * 1000.0 << "us, " << 100.0 * simdFrame / frameMs << "% of a 60Hz frame" << std::endl;
+	std::cout << "  vertex storage moved " << simdMoves + scalarMoves << " times, particles left " << simdCount << " / " << scalarCount << std::endl;
+}
@@ -0,0 +1,95 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Particles for taser arcs, sparks and battery drain. Each pool is a fixed number of particles kept
+/// as one array per field, sized once when it's made, so spawning and updating never allocate and a full
+/// pool drops the new particle. update() moves four particles per SSE instruction and kills any that have
+/// faded or left the screen, the dead are swapped out for the last live one so the live ones stay packed.
+/// Every pool has one texture and blend mode, so drawing a pool is one vertex array draw however many
+/// particles it has.
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Random.h"
+#include "RenderBackend.h"
+
+const int static PARTICLE_CAPACITY = 32768; // per pool, a multiple of 4
+
+/// <summary>
+/// how one pool's particles move, shared by every particle in it
+/// </summary>
+struct ParticleMotion
+{
+	float gravity; // pixels per second per second, down is positive
+	float drag; // velocity kept each tick
+	sf::FloatRect bounds; // particles outside it are culled
+};
+
+class ParticlePool
+{
+public:
+	ParticlePool();
+
+	bool spawn(float t_x, float t_y, float t_velocityX, float t_velocityY, float t_lifespan, float t_size, sf::Color t_colour);
+	void update(float t_seconds, const ParticleMotion& t_motion); // SSE where the compiler has it
+	void updateScalar(float t_seconds, const ParticleMotion& t_motion); // the same maths one particle at a time
+	void buildVertices(sf::VertexArray& t_vertices, const sf::Vector2u& t_textureSize) const; // a quad per particle, fading out
+	void clear() { count = 0; }
+
+	int getCount() const { return count; }
+
+private:
+	void removeDead();
+
+	int count;
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> life; // 1 when spawned, dead at 0
+	std::vector<float> fade; // life lost per second, 1 / lifespan
+	std::vector<float> size; // half the width of the quad
+	std::vector<std::uint32_t> colour; // rgba
+};
+
+enum ParticleLayer
+{
+	PARTICLE_GLOW, // additive soft dots: taser arcs and battery drain
+	PARTICLE_CHUNK, // solid specks that fall: sparks
+	PARTICLE_LAYERS
+};
+
+/// <summary>
+/// the game's effects, one pool per layer
+/// </summary>
+class ParticleSystem
+{
+public:
+	ParticleSystem();
+
+	void setup(); // makes the layer textures, needs SFML's graphics context
+	void emitTaserArc(sf::Vector2f t_from, sf::Vector2f t_to);
+	void emitSparks(sf::Vector2f t_at, int t_count);
+	void emitBatteryDrain(sf::Vector2f t_at, int t_charges);
+	void update(); // one 60th of a second
+	void draw(RenderBackend& t_renderer); // one draw per layer that has particles
+	void clear();
+
+	int getCount() const;
+
+private:
+	ParticlePool pools[PARTICLE_LAYERS];
+	ParticleMotion motions[PARTICLE_LAYERS];
+	sf::Texture textures[PARTICLE_LAYERS];
+	sf::VertexArray vertices[PARTICLE_LAYERS];
+	FastRandom random; // its own, so effects never move the match's dice
+};
+
+/// <summary>
+/// entry point for "--particle-bench [particles] [frames]": keeps t_particles alive for t_frames
+/// and times the SSE update, the scalar update and building the vertices against a 60Hz frame
+/// </summary>
+void runParticleBenchmark(int t_particles, int t_frames);
@@ -6,6 +6,8 @@
 #include "Player.h"   
 #include <SFML/Graphics/Transformable.hpp>
 #include "Game.h"
+#include "TextureCache.h"
+#include "Logger.h"
 #include "Globals.h"
 
 Player::Player() //default constructor
@@ -15,12 +17,13 @@ Player::Player() //default constructor
 
 	animationPlaying = false;
 	currentAnimation = 0;
+	animationsStarted = 0;
 	playerFrame = -1;
 	frameCounter = 0.0f;
 	frameIncrement = 0.2f;
 
 	itemsHeld = 0;
-	health = 5;
+	health = ClassicRules::startingHealth;
 }
 
 /// <summary>
@@ -29,29 +32,29 @@ Player::Player() //default constructor
 void Player::setupSprite()
 {
 	//loads blank and live spritesheet textures
-	if (!textureBlank.loadFromFile("ASSETS\\IMAGES\\player shoot blank sheet.png"))
+	if (!loadTextureCached(textureBlank, "ASSETS\\IMAGES\\player shoot blank sheet.png"))
 	{
-		std::cout << "problem loading player shoot blank texture" << std::endl;
+		LOG_ERROR("problem loading player shoot blank texture");
 	}
 
-	if (!textureLive.loadFromFile("ASSETS\\IMAGES\\player shoot live sheet.png"))
+	if (!loadTextureCached(textureLive, "ASSETS\\IMAGES\\player shoot live sheet.png"))
 	{
-		std::cout << "problem loading player shoot live texture" << std::endl;
+		LOG_ERROR("problem loading player shoot live texture");
 	}
 
-	if (!textureLiveSelf.loadFromFile("ASSETS\\IMAGES\\player shoot self live-Sheet.png"))
+	if (!loadTextureCached(textureLiveSelf, "ASSETS\\IMAGES\\player shoot self live-Sheet.png"))
 	{
-		std::cout << "problem loading player shoot self live texture" << std::endl;
+		LOG_ERROR("problem loading player shoot self live texture");
 	}
 
-	if (!textureBlankSelf.loadFromFile("ASSETS\\IMAGES\\player shoot self blank-Sheet.png"))
+	if (!loadTextureCached(textureBlankSelf, "ASSETS\\IMAGES\\player shoot self blank-Sheet.png"))
 	{
-		std::cout << "problem loading player shoot self blank texture" << std::endl;
+		LOG_ERROR("problem loading player shoot self blank texture");
 	}
 
-	if (!textureHit.loadFromFile("ASSETS\\IMAGES\\player tased-Sheet.png"))
+	if (!loadTextureCached(textureHit, "ASSETS\\IMAGES\\player tased-Sheet.png"))
 	{
-		std::cout << "problem loading player tased texture" << std::endl;
+		LOG_ERROR("problem loading player tased texture");
 	}
 
 	sprite.setTexture(textureLive);
@@ -76,6 +79,10 @@ void Player::setAnimationPlaying(bool t_AnimationPlaying, int t_animationToPlay)
 {
 	animationPlaying = t_AnimationPlaying;
 	currentAnimation = t_animationToPlay;
+	if (t_AnimationPlaying)
+	{
+		animationsStarted++;
+	}
 }
 
 bool Player::getAnimationPlaying() // returns whether animation playing or not
@@ -83,6 +90,16 @@ bool Player::getAnimationPlaying() // returns whether animation playing or not
 	return animationPlaying;
 }
 
+int Player::getCurrentAnimation() const // returns the animation playing, 0 for none
+{
+	return animationPlaying ? currentAnimation : 0;
+}
+
+int Player::getAnimationsStarted() const // returns how many animations have been started
+{
+	return animationsStarted;
+}
+
 void Player::playAnimation() // calls currently selected animation to play
 {
 	switch (currentAnimation)
@@ -234,7 +251,7 @@ void Player::initializeInventoryArray()
 }
 
 // returns invetory item from space specified
-int Player::getInventoryArray(int t_index)
+int Player::getInventoryArray(int t_index) const
 {
 	return inventoryArray[t_index];
 }
@@ -272,7 +289,7 @@ int Player::getHealth() const
 // resets variables to default
 void Player::reset()
 {
-	health = 5;
+	health = ClassicRules::startingHealth;
 	itemsHeld = 0;
 	animationPlaying = false;
 	currentAnimation = 0;
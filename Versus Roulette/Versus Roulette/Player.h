@@ -23,6 +23,8 @@ public:
 
 	void setAnimationPlaying(bool t_AnimationPlaying, int t_animationToPlay);
 	bool getAnimationPlaying();
+	int getCurrentAnimation() const; // 0 when nothing is playing
+	int getAnimationsStarted() const;
 
 	void playAnimation(); // is updated every frame
 
@@ -34,7 +36,7 @@ public:
 
 	//inventory
 	void initializeInventoryArray();
-	int getInventoryArray(int t_index);
+	int getInventoryArray(int t_index) const;
 	void setInventoryArray(int t_index, int t_item);
 	void setItemsHeld(int t_itemsHeld);
 	int getItemsHeld();
@@ -56,6 +58,7 @@ private:
 
 	bool animationPlaying; // is the animation playing?
 	int currentAnimation; // what animation is being played?
+	int animationsStarted; // counts up every time one starts, so a spectator can tell a repeat from the last one still playing
 
 	int playerFrame;
 	const int PLAYER_FRAMES = 11;
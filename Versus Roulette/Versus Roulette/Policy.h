@@ -0,0 +1,202 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Robot "brains". A policy is any type with
+///     Action chooseAction(const Observation& t_view);
+/// The simulator takes policies as template parameters so every decision is a direct call,
+/// Game holds them in an AnyPolicy so either seat can be swapped at runtime. The policies here take
+/// a BasicObservation of any rule set, so the same code plays every variant in MatchRules.h.
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "MatchState.h"
+
+/// <summary>
+/// the enemy AI that used to live in Game::update, uses items in a fixed order and then
+/// shoots itself when blanks are at least as likely as lives
+/// </summary>
+class HeuristicPolicy
+{
+public:
+	const char* getName() const { return "heuristic"; }
+
+	template <typename Rules>
+	Action chooseAction(const BasicObservation<Rules>& t_view)
+	{
+		int slot = t_view.findItem(OIL_DRINK); // uses oil drinks straight away
+		if (slot != -1)
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(RUBBISH_BIN); // throws a shot away if more live shots than blanks
+		if (slot != -1 && t_view.getLiveRounds() > t_view.getBlankRounds())
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(PAUSE_REMOTE);
+		if (slot != -1)
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(SCANNER);
+		if (slot != -1)
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(OVERCHARGER); // only worth it if it knows it has a live shot
+		if (slot != -1 && t_view.getKnowItsLive())
+		{
+			return useItemAction(slot);
+		}
+
+		if (t_view.getKnowItsBlank())
+		{
+			return shootSelfAction();
+		}
+		if (t_view.getKnowItsLive())
+		{
+			return shootOpponentAction();
+		}
+		// shoots itself if it has more or equal blank shots than lives
+		if (t_view.getBlankRounds() >= t_view.getLiveRounds())
+		{
+			return shootSelfAction();
+		}
+		return shootOpponentAction();
+	}
+};
+
+/// <summary>
+/// HeuristicPolicy with its thresholds pulled out, for trying variants against each other.
+/// it also acts on what the scanner said (bins a known live, never a known blank) and
+/// doesn't waste a second scan, pause or overcharge
+/// </summary>
+struct HeuristicParameters
+{
+	int selfShotMargin = 0; // shoots itself when blanks - lives is at least this
+	int rubbishBinMargin = 1; // bins the shot when lives - blanks is at least this
+	bool overchargeOnOdds = false; // also overcharges when lives outnumber blanks, not only when it's scanned live
+};
+
+class HeuristicVariantPolicy
+{
+public:
+	HeuristicVariantPolicy(HeuristicParameters t_parameters, const char* t_name) : parameters(t_parameters), name(t_name) {}
+
+	const char* getName() const { return name; }
+
+	template <typename Rules>
+	Action chooseAction(const BasicObservation<Rules>& t_view)
+	{
+		int lead = t_view.getLiveRounds() - t_view.getBlankRounds();
+		int slot = t_view.findItem(OIL_DRINK);
+		if (slot != -1)
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(RUBBISH_BIN);
+		if (slot != -1 && !t_view.getKnowItsBlank() && (t_view.getKnowItsLive() || lead >= parameters.rubbishBinMargin))
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(PAUSE_REMOTE);
+		if (slot != -1 && !t_view.getOpponentPaused())
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(SCANNER);
+		if (slot != -1 && !t_view.getKnowItsLive() && !t_view.getKnowItsBlank())
+		{
+			return useItemAction(slot);
+		}
+		slot = t_view.findItem(OVERCHARGER);
+		if (slot != -1 && !t_view.getDoubleDamage() && (t_view.getKnowItsLive() || (parameters.overchargeOnOdds && lead > 0 && !t_view.getKnowItsBlank())))
+		{
+			return useItemAction(slot);
+		}
+
+		if (t_view.getKnowItsBlank())
+		{
+			return shootSelfAction();
+		}
+		if (t_view.getKnowItsLive())
+		{
+			return shootOpponentAction();
+		}
+		return -lead >= parameters.selfShotMargin ? shootSelfAction() : shootOpponentAction();
+	}
+
+private:
+	HeuristicParameters parameters;
+	const char* name;
+};
+
+/// <summary>
+/// picks uniformly between both shots and every held item, baseline for benchmarks
+/// </summary>
+class RandomPolicy
+{
+public:
+	explicit RandomPolicy(std::uint64_t t_seed = 1) : random(t_seed) {}
+
+	const char* getName() const { return "random"; }
+
+	template <typename Rules>
+	Action chooseAction(const BasicObservation<Rules>& t_view)
+	{
+		Action choices[2 + Rules::ITEM_CAPACITY] = { shootSelfAction(), shootOpponentAction() };
+		int choiceCount = 2;
+		for (int index = 0; index < Rules::ITEM_CAPACITY; index++)
+		{
+			if (t_view.getItem(index) != 0)
+			{
+				choices[choiceCount++] = useItemAction(index);
+			}
+		}
+		return choices[random.nextInt(choiceCount)];
+	}
+
+private:
+	FastRandom random;
+};
+
+/// <summary>
+/// type erased policy for the UI side, an empty AnyPolicy means the seat is keyboard controlled.
+/// Only Game goes through this, the simulator is given the real policy types.
+/// </summary>
+class AnyPolicy
+{
+public:
+	AnyPolicy() = default;
+
+	template <typename PolicyType, typename = std::enable_if_t<!std::is_same<PolicyType, AnyPolicy>::value>>
+	AnyPolicy(PolicyType t_policy) : policy(new Model<PolicyType>(std::move(t_policy)))
+	{
+	}
+
+	bool isEmpty() const { return policy == nullptr; }
+	const char* getName() const { return policy ? policy->getName() : "keyboard"; }
+	Action chooseAction(const Observation& t_view) { return policy->chooseAction(t_view); }
+
+private:
+	struct Concept
+	{
+		virtual ~Concept() = default;
+		virtual const char* getName() const = 0;
+		virtual Action chooseAction(const Observation& t_view) = 0;
+	};
+
+	template <typename PolicyType>
+	struct Model : Concept
+	{
+		explicit Model(PolicyType t_policy) : wrapped(std::move(t_policy)) {}
+		const char* getName() const override { return wrapped.getName(); }
+		Action chooseAction(const Observation& t_view) override { return wrapped.chooseAction(t_view); }
+		PolicyType wrapped;
+	};
+
+	std::unique_ptr<Concept> policy;
+};
@@ -0,0 +1,71 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Small seeded random number generator used by the headless match code.
+/// rand() is shared global state, so simulations running side by side
+/// (or replaying a seed) each carry their own FastRandom instead.
+#pragma once
+
+#include <cstdint>
+
+class FastRandom
+{
+public:
+	explicit FastRandom(std::uint64_t t_seed = 0x9E3779B97F4A7C15ULL)
+	{
+		seed(t_seed);
+	}
+
+	/// <summary>
+	/// restarts the sequence, the same seed always gives the same numbers
+	/// </summary>
+	void seed(std::uint64_t t_seed)
+	{
+		// splitmix64 spreads the seed so that seeds 1, 2, 3... aren't correlated
+		for (int index = 0; index < 2; index++)
+		{
+			t_seed += 0x9E3779B97F4A7C15ULL;
+			std::uint64_t mixed = t_seed;
+			mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+			state[index] = mixed ^ (mixed >> 31);
+		}
+		if (state[0] == 0 && state[1] == 0)
+		{
+			state[0] = 1; // xorshift can never leave the all zero state
+		}
+	}
+
+	/// <summary>
+	/// next raw 64 bit number (xorshift128+)
+	/// </summary>
+	std::uint64_t next()
+	{
+		std::uint64_t s1 = state[0];
+		const std::uint64_t s0 = state[1];
+		state[0] = s0;
+		s1 ^= s1 << 23;
+		state[1] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+		return state[1] + s0;
+	}
+
+	/// <summary>
+	/// number in the range 0 to t_bound - 1, same as rand() % t_bound without the bias
+	/// </summary>
+	int nextInt(int t_bound)
+	{
+		return static_cast<int>(((next() >> 32) * static_cast<std::uint64_t>(t_bound)) >> 32);
+	}
+
+	/// <summary>
+	/// number in the range 0 to 1
+	/// </summary>
+	double nextDouble()
+	{
+		return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+private:
+	std::uint64_t state[2];
+};
@@ -0,0 +1,240 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "RenderBackend.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+bool RecordingRenderBackend::save(const std::string& t_file) const
+{
+	std::ofstream file(t_file);
+	if (!file)
+	{
+		std::cout << "can't write render recording " << t_file << std::endl;
+		return false;
+	}
+	for (const std::string& line : lines)
+	{
+		file << line << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+/// <summary>
+/// compares this recording with a saved one line by line, the first difference is printed
+/// </summary>
+int RecordingRenderBackend::compare(const std::string& t_file) const
+{
+	std::ifstream file(t_file);
+	if (!file)
+	{
+		std::cout << "can't read render recording " << t_file << std::endl;
+		return -1;
+	}
+	std::vector<std::string> golden;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		golden.push_back(line);
+	}
+
+	int differences = 0;
+	size_t count = golden.size() > lines.size() ? golden.size() : lines.size();
+	for (size_t i = 0; i < count; i++)
+	{
+		const std::string& expected = i < golden.size() ? golden[i] : std::string("(missing)");
+		const std::string& actual = i < lines.size() ? lines[i] : std::string("(missing)");
+		if (expected != actual)
+		{
+			if (differences == 0)
+			{
+				std::cout << "first difference at line " << i + 1 << "\n  expected: " << expected << "\n  got:      " << actual << std::endl;
+			}
+			differences++;
+		}
+	}
+	return differences;
+}
+
+/// <summary>
+/// FNV-1a over the lines so far, textures keep their numbers so later frames still match a full recording
+/// </summary>
+std::uint32_t RecordingRenderBackend::drainChecksum(std::uint32_t t_hash)
+{
+	for (const std::string& line : lines)
+	{
+		for (char character : line)
+		{
+			t_hash ^= static_cast<unsigned char>(character);
+			t_hash *= 16777619u;
+		}
+		t_hash ^= '\n';
+		t_hash *= 16777619u;
+	}
+	lines.clear();
+	return t_hash;
+}
+
+void RecordingRenderBackend::onClear(const sf::Color& t_colour)
+{
+	char line[64];
+	std::snprintf(line, sizeof(line), "frame %lld clear %d %d %d", getFrames(), t_colour.r, t_colour.g, t_colour.b);
+	lines.push_back(line);
+}
+
+void RecordingRenderBackend::onDraw(const sf::Sprite& t_sprite)
+{
+	record("sprite", t_sprite.getTexture(), t_sprite.getTextureRect(), t_sprite.getTransform(), t_sprite.getColor(), "");
+}
+
+void RecordingRenderBackend::onDraw(const sf::Text& t_text)
+{
+	record("text", nullptr, sf::IntRect(), t_text.getTransform(), t_text.getFillColor(), t_text.getString().toAnsiString());
+}
+
+void RecordingRenderBackend::onDraw(const sf::RectangleShape& t_shape)
+{
+	sf::Transform transform = t_shape.getTransform();
+	transform.scale(t_shape.getSize().x, t_shape.getSize().y); // so the size shows up in the line
+	record("rect", t_shape.getTexture(), t_shape.getTextureRect(), transform, t_shape.getFillColor(), "");
+}
+
+/// <summary>
+/// a vertex array is summed up rather than listed, particle counts run into the thousands
+/// </summary>
+void RecordingRenderBackend::onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states)
+{
+	sf::FloatRect bounds = t_vertices.getBounds();
+	char line[160];
+	std::snprintf(line, sizeof(line), "verts tex %d %s count %d bounds %.1f %.1f %.1f %.1f", textureNumber(t_states.texture),
+		t_states.blendMode == sf::BlendAdd ? "add" : "alpha", static_cast<int>(t_vertices.getVertexCount()),
+		bounds.left, bounds.top, bounds.width, bounds.height);
+	lines.push_back(line);
+}
+
+/// <summary>
+/// texture number, texture rect, the 2d part of the transform, colour, then any text
+/// </summary>
+void RecordingRenderBackend::record(const char* t_kind, const sf::Texture* t_texture, const sf::IntRect& t_rect,
+	const sf::Transform& t_transform, const sf::Color& t_colour, const std::string& t_text)
+{
+	const float* m = t_transform.getMatrix(); // 4x4 column major
+	char line[256];
+	std::snprintf(line, sizeof(line), "%s tex %d rect %d %d %d %d xf %.2f %.2f %.2f %.2f %.2f %.2f rgba %d %d %d %d",
+		t_kind, textureNumber(t_texture), t_rect.left, t_rect.top, t_rect.width, t_rect.height,
+		m[0], m[4], m[12], m[1], m[5], m[13], t_colour.r, t_colour.g, t_colour.b, t_colour.a);
+	std::string entry = line;
+	if (!t_text.empty())
+	{
+		entry += " \"";
+		for (char character : t_text)
+		{
+			entry += character == '\n' ? '|' : character; // one draw per line
+		}
+		entry += '"';
+	}
+	lines.push_back(entry);
+}
+
+int RecordingRenderBackend::textureNumber(const sf::Texture* t_texture)
+{
+	if (t_texture == nullptr)
+	{
+		return -1;
+	}
+	for (size_t i = 0; i < textures.size(); i++)
+	{
+		if (textures[i] == t_texture)
+		{
+			return static_cast<int>(i);
+		}
+	}
+	textures.push_back(t_texture);
+	return static_cast<int>(textures.size()) - 1;
+}
+
+/// <summary>
+/// empties the frame without giving back memory, old copies are overwritten in place
+/// </summary>
+void RenderFrame::clear(const sf::Color& t_colour)
+{
+	clearColour = t_colour;
+	items.clear();
+	spriteCount = 0;
+	textCount = 0;
+	shapeCount = 0;
+	vertexArrayCount = 0;
+}
+
+void RenderFrame::drawTo(RenderBackend& t_backend) const
+{
+	t_backend.clear(clearColour);
+	for (const Item& item : items)
+	{
+		switch (item.kind)
+		{
+		case SPRITE:
+			t_backend.draw(sprites[item.index]);
+			break;
+		case TEXT:
+			t_backend.draw(texts[item.index]);
+			break;
+		case SHAPE:
+			t_backend.draw(shapes[item.index]);
+			break;
+		case VERTICES:
+			t_backend.draw(vertexArrays[item.index], vertexStates[item.index]);
+			break;
+		}
+	}
+}
+
+/// <summary>
+/// puts t_drawable in the next slot of t_slots, reusing an old copy when there is one
+/// </summary>
+template <typename T>
+static int storeDraw(std::vector<T>& t_slots, int& t_count, const T& t_drawable)
+{
+	if (t_count < static_cast<int>(t_slots.size()))
+	{
+		t_slots[t_count] = t_drawable;
+	}
+	else
+	{
+		t_slots.push_back(t_drawable);
+	}
+	return t_count++;
+}
+
+void CaptureRenderBackend::onDraw(const sf::Sprite& t_sprite)
+{
+	frame->items.push_back({ RenderFrame::SPRITE, storeDraw(frame->sprites, frame->spriteCount, t_sprite) });
+}
+
+void CaptureRenderBackend::onDraw(const sf::Text& t_text)
+{
+	frame->items.push_back({ RenderFrame::TEXT, storeDraw(frame->texts, frame->textCount, t_text) });
+}
+
+void CaptureRenderBackend::onDraw(const sf::RectangleShape& t_shape)
+{
+	frame->items.push_back({ RenderFrame::SHAPE, storeDraw(frame->shapes, frame->shapeCount, t_shape) });
+}
+
+void CaptureRenderBackend::onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states)
+{
+	int index = frame->vertexArrayCount;
+	storeDraw(frame->vertexArrays, frame->vertexArrayCount, t_vertices); // copying into an old array reuses its memory
+	if (index < static_cast<int>(frame->vertexStates.size()))
+	{
+		frame->vertexStates[index] = t_states;
+	}
+	else
+	{
+		frame->vertexStates.push_back(t_states);
+	}
+	frame->items.push_back({ RenderFrame::VERTICES, index });
+}
@@ -0,0 +1,169 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Where Game::render sends its draws. The window backend passes them to SFML, the null backend
+/// throws them away so render() can be timed on its own, and the recording backend keeps every
+/// draw as (texture, texture rect, transform, colour, text) so frames can be compared with a golden file,
+/// vertex arrays as their texture, blend, vertex count and bounds.
+/// The capture backend copies the draws into a RenderFrame that another thread can draw later.
+/// Every backend counts its draw calls.
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	void clear(const sf::Color& t_colour) { frameDrawCalls = 0; onClear(t_colour); }
+	void draw(const sf::Sprite& t_sprite) { countDraw(); onDraw(t_sprite); }
+	void draw(const sf::Text& t_text) { countDraw(); onDraw(t_text); }
+	void draw(const sf::RectangleShape& t_shape) { countDraw(); onDraw(t_shape); }
+	void draw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states) { countDraw(); onDraw(t_vertices, t_states); }
+	void display() { frames++; onDisplay(); }
+
+	long long getFrames() const { return frames; }
+	long long getDrawCalls() const { return drawCalls; }
+	int getFrameDrawCalls() const { return frameDrawCalls; } // draws since the last clear
+
+protected:
+	virtual void onClear(const sf::Color& t_colour) = 0;
+	virtual void onDraw(const sf::Sprite& t_sprite) = 0;
+	virtual void onDraw(const sf::Text& t_text) = 0;
+	virtual void onDraw(const sf::RectangleShape& t_shape) = 0;
+	virtual void onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states) = 0;
+	virtual void onDisplay() = 0;
+
+private:
+	void countDraw() { drawCalls++; frameDrawCalls++; }
+
+	long long frames = 0;
+	long long drawCalls = 0;
+	int frameDrawCalls = 0;
+};
+
+/// <summary>
+/// draws to an SFML window
+/// </summary>
+class WindowRenderBackend : public RenderBackend
+{
+public:
+	explicit WindowRenderBackend(sf::RenderWindow& t_window) : window(t_window) {}
+
+protected:
+	void onClear(const sf::Color& t_colour) override { window.clear(t_colour); }
+	void onDraw(const sf::Sprite& t_sprite) override { window.draw(t_sprite); }
+	void onDraw(const sf::Text& t_text) override { window.draw(t_text); }
+	void onDraw(const sf::RectangleShape& t_shape) override { window.draw(t_shape); }
+	void onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states) override { window.draw(t_vertices, t_states); }
+	void onDisplay() override { window.display(); }
+
+private:
+	sf::RenderWindow& window;
+};
+
+/// <summary>
+/// draws nothing, only counts
+/// </summary>
+class NullRenderBackend : public RenderBackend
+{
+protected:
+	void onClear(const sf::Color&) override {}
+	void onDraw(const sf::Sprite&) override {}
+	void onDraw(const sf::Text&) override {}
+	void onDraw(const sf::RectangleShape&) override {}
+	void onDraw(const sf::VertexArray&, const sf::RenderStates&) override {}
+	void onDisplay() override {}
+};
+
+/// <summary>
+/// keeps the draw list of every frame, one line per draw.
+/// textures are numbered in the order they're first drawn so the lines don't depend on addresses
+/// </summary>
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+	const std::vector<std::string>& getLines() const { return lines; }
+
+	bool save(const std::string& t_file) const;
+	int compare(const std::string& t_file) const; // lines that differ from a saved recording, -1 if it can't be read
+	std::uint32_t drainChecksum(std::uint32_t t_hash); // folds the lines into t_hash and forgets them, for long runs
+
+protected:
+	void onClear(const sf::Color& t_colour) override;
+	void onDraw(const sf::Sprite& t_sprite) override;
+	void onDraw(const sf::Text& t_text) override;
+	void onDraw(const sf::RectangleShape& t_shape) override;
+	void onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states) override;
+	void onDisplay() override {}
+
+private:
+	void record(const char* t_kind, const sf::Texture* t_texture, const sf::IntRect& t_rect,
+		const sf::Transform& t_transform, const sf::Color& t_colour, const std::string& t_text);
+	int textureNumber(const sf::Texture* t_texture);
+
+	std::vector<std::string> lines;
+	std::vector<const sf::Texture*> textures;
+};
+
+/// <summary>
+/// a whole frame of draws, copied so it can be drawn on another thread after the game has moved on.
+/// the vectors keep their capacity from frame to frame
+/// </summary>
+struct RenderFrame
+{
+	enum Kind { SPRITE, TEXT, SHAPE, VERTICES };
+	struct Item
+	{
+		Kind kind;
+		int index; // into the vector for its kind
+	};
+
+	void clear(const sf::Color& t_colour);
+	void drawTo(RenderBackend& t_backend) const; // clear then the draws in order, display is left to the caller
+
+	sf::Color clearColour;
+	std::vector<sf::Sprite> sprites;
+	std::vector<sf::Text> texts;
+	std::vector<sf::RectangleShape> shapes;
+	std::vector<sf::VertexArray> vertexArrays;
+	std::vector<sf::RenderStates> vertexStates; // same index as vertexArrays
+	std::vector<Item> items;
+	int spriteCount = 0;
+	int textCount = 0;
+	int shapeCount = 0;
+	int vertexArrayCount = 0;
+	long long tick = 0; // update tick the frame was captured after
+	long long screenFrame = 0; // ScreenTextures::getFrame() when captured, evictions wait until it's drawn
+	// the oldest key press and the oldest player action first shown by this frame, for latency
+	bool hasInput = false;
+	std::chrono::steady_clock::time_point inputTime;
+	bool hasAction = false;
+	std::chrono::steady_clock::time_point actionTime;
+};
+
+/// <summary>
+/// copies every draw into a RenderFrame instead of drawing it
+/// </summary>
+class CaptureRenderBackend : public RenderBackend
+{
+public:
+	void setTarget(RenderFrame* t_frame) { frame = t_frame; }
+
+protected:
+	void onClear(const sf::Color& t_colour) override { frame->clear(t_colour); }
+	void onDraw(const sf::Sprite& t_sprite) override;
+	void onDraw(const sf::Text& t_text) override;
+	void onDraw(const sf::RectangleShape& t_shape) override;
+	void onDraw(const sf::VertexArray& t_vertices, const sf::RenderStates& t_states) override;
+	void onDisplay() override {}
+
+private:
+	RenderFrame* frame = nullptr;
+};
@@ -0,0 +1,256 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "ScreenTextures.h"
+#include "TextureCache.h"
+#include "Logger.h"
+#include <iostream>
+
+static std::size_t textureBytes(const sf::Texture& t_texture)
+{
+	return static_cast<std::size_t>(t_texture.getSize().x) * t_texture.getSize().y * 4; // RGBA8
+}
+
+void ScreenTextures::add(sf::Texture& t_texture, const std::string& t_file, unsigned t_screens)
+{
+	Entry entry;
+	entry.texture = &t_texture;
+	entry.file = t_file;
+	entry.screens = t_screens;
+	entries.push_back(entry);
+}
+
+void ScreenTextures::attach(sf::Texture& t_texture, sf::Sprite& t_sprite)
+{
+	Entry* entry = find(t_texture);
+	if (entry == nullptr)
+	{
+		return;
+	}
+	entry->sprites.push_back(&t_sprite);
+	if (entry->resident)
+	{
+		t_sprite.setTexture(t_texture);
+	}
+}
+
+void ScreenTextures::track(const sf::Texture& t_texture)
+{
+	Entry entry;
+	entry.texture = const_cast<sf::Texture*>(&t_texture); // never loaded or evicted through here
+	entry.pinned = true;
+	entry.resident = true;
+	entry.bytes = textureBytes(t_texture);
+	entries.push_back(entry);
+	residentBytes += entry.bytes;
+}
+
+void ScreenTextures::setLock(std::mutex* t_lock)
+{
+	lock = t_lock;
+	if (lock == nullptr)
+	{
+		frameDrawn(frames); // nothing else is drawing
+	}
+}
+
+void ScreenTextures::setLikelyNext(int t_screen, unsigned t_nextScreens)
+{
+	if (t_screen >= 0 && t_screen < SCREENS)
+	{
+		likelyNext[t_screen] = t_nextScreens;
+	}
+}
+
+/// <summary>
+/// loads the screen's textures when it changes, otherwise prefetches at most one texture
+/// </summary>
+bool ScreenTextures::use(int t_screen)
+{
+	frames++;
+	if (t_screen == currentScreen)
+	{
+		if (prefetching)
+		{
+			prefetchOne();
+		}
+		return false;
+	}
+
+	std::unique_lock<std::mutex> locked = lockTextures();
+	currentScreen = t_screen;
+	useCount++;
+	unsigned bit = screenBit(t_screen);
+	for (Entry& entry : entries)
+	{
+		if (!entry.pinned && (entry.screens & bit) != 0)
+		{
+			entry.lastUsed = useCount;
+			if (!entry.resident)
+			{
+				load(entry);
+			}
+		}
+	}
+	trimToBudget(bit);
+	prefetching = t_screen >= 0 && t_screen < SCREENS && likelyNext[t_screen] != 0;
+	return true;
+}
+
+/// <summary>
+/// frees the evicted textures that no frame still waiting to be drawn can use
+/// </summary>
+void ScreenTextures::frameDrawn(long long t_frame)
+{
+	for (Entry& entry : entries)
+	{
+		if (entry.freeAfterFrame >= 0 && t_frame >= entry.freeAfterFrame)
+		{
+			release(entry);
+		}
+	}
+}
+
+int ScreenTextures::getResidentCount() const
+{
+	int count = 0;
+	for (const Entry& entry : entries)
+	{
+		if (entry.resident)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+void ScreenTextures::report() const
+{
+	std::cout << "textures: " << getResidentCount() << "/" << entries.size() << " resident, "
+		<< residentBytes / 1024 << "KB of " << budget / 1024 << "KB budget" << std::endl;
+	for (const Entry& entry : entries)
+	{
+		if (!entry.pinned)
+		{
+			std::cout << "  " << (entry.resident ? "resident " : "unloaded ") << entry.bytes / 1024 << "KB " << entry.file << std::endl;
+		}
+	}
+}
+
+ScreenTextures::Entry* ScreenTextures::find(const sf::Texture& t_texture)
+{
+	for (Entry& entry : entries)
+	{
+		if (entry.texture == &t_texture)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+bool ScreenTextures::load(Entry& t_entry)
+{
+	if (t_entry.freeAfterFrame >= 0)
+	{
+		t_entry.freeAfterFrame = -1; // wanted back before it was freed, the pixels are all still there
+		t_entry.resident = true;
+		residentBytes += t_entry.bytes;
+		return true;
+	}
+	if (!loadTextureCached(*t_entry.texture, t_entry.file))
+	{
+		LOG_ERROR("Failed to load %s", t_entry.file.c_str());
+		t_entry.failed = true;
+		return false;
+	}
+	t_entry.resident = true;
+	t_entry.bytes = textureBytes(*t_entry.texture);
+	residentBytes += t_entry.bytes;
+	for (sf::Sprite* sprite : t_entry.sprites)
+	{
+		sprite->setTexture(*t_entry.texture, sprite->getTextureRect() == sf::IntRect()); // keep a rect that was already picked
+	}
+	return true;
+}
+
+/// <summary>
+/// takes the texture out of the budget. it's freed straight away when this thread does the drawing,
+/// otherwise once the window thread has drawn the frame being captured now, since the frames before it
+/// may still draw the texture. bytes is kept so the report still says how big it is
+/// </summary>
+void ScreenTextures::evict(Entry& t_entry)
+{
+	t_entry.resident = false;
+	residentBytes -= t_entry.bytes;
+	if (lock == nullptr)
+	{
+		release(t_entry);
+		return;
+	}
+	t_entry.freeAfterFrame = frames;
+}
+
+/// <summary>
+/// frees the texture, the sprites keep pointing at the empty texture object until it's loaded again
+/// </summary>
+void ScreenTextures::release(Entry& t_entry)
+{
+	*t_entry.texture = sf::Texture();
+	t_entry.freeAfterFrame = -1;
+}
+
+/// <summary>
+/// drops least recently used textures that none of t_keepScreens draw until under budget
+/// </summary>
+void ScreenTextures::trimToBudget(unsigned t_keepScreens)
+{
+	while (residentBytes > budget)
+	{
+		Entry* oldest = nullptr;
+		for (Entry& entry : entries)
+		{
+			if (entry.resident && !entry.pinned && (entry.screens & t_keepScreens) == 0
+				&& (oldest == nullptr || entry.lastUsed < oldest->lastUsed))
+			{
+				oldest = &entry;
+			}
+		}
+		if (oldest == nullptr)
+		{
+			return; // the screen alone is over budget, nothing else can go
+		}
+		evict(*oldest);
+	}
+}
+
+/// <summary>
+/// loads one texture of the likely next screens, stops once they're all in or the budget is full
+/// </summary>
+void ScreenTextures::prefetchOne()
+{
+	std::unique_lock<std::mutex> locked = lockTextures();
+	unsigned next = likelyNext[currentScreen];
+	for (Entry& entry : entries)
+	{
+		if (entry.resident || entry.pinned || entry.failed || (entry.screens & next) == 0)
+		{
+			continue;
+		}
+		if (!load(entry))
+		{
+			return;
+		}
+		entry.lastUsed = useCount;
+		trimToBudget(screenBit(currentScreen) | next);
+		if (residentBytes > budget)
+		{
+			evict(entry); // doesn't fit next to the current screen after all
+			prefetching = false;
+		}
+		return;
+	}
+	prefetching = false;
+}
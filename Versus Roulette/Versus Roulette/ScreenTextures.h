@@ -0,0 +1,89 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Keeps the big full screen textures out of memory until their screen comes up.
+/// Each texture says which screens draw it. Entering a screen loads what it needs, and then
+/// the least recently used textures of other screens are dropped until the total is back under
+/// the budget. While a screen is up, the textures of the screens likely to come next are
+/// loaded one per frame so switching to them doesn't stall.
+/// Small shared textures are only tracked, so the resident total covers them too.
+/// When another thread draws the frames, a frame captured before a screen change can still be waiting
+/// to be drawn with the old screen's textures, so evicted textures are only freed once the window
+/// thread has drawn a frame from after the eviction.
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ScreenTextures
+{
+public:
+	static const int SCREENS = 6; // MAIN_MENU .. FREE_FOR_ALL
+	static const std::size_t DEFAULT_BUDGET = 48 * 1024 * 1024;
+
+	static unsigned screenBit(int t_screen) { return 1u << t_screen; }
+
+	// the texture stays empty until one of t_screens (screenBit mask) is used
+	void add(sf::Texture& t_texture, const std::string& t_file, unsigned t_screens);
+	// t_sprite gets the texture whenever it's loaded, its texture rect is kept if it has one
+	void attach(sf::Texture& t_texture, sf::Sprite& t_sprite);
+	// counts an already loaded texture that's never evicted
+	void track(const sf::Texture& t_texture);
+
+	void setLikelyNext(int t_screen, unsigned t_nextScreens);
+	void setBudget(std::size_t t_bytes) { budget = t_bytes; }
+	// held while textures are loaded or freed, for when another thread draws with them.
+	// nullptr once that thread has stopped, which frees anything still waiting on it
+	void setLock(std::mutex* t_lock);
+	std::size_t getBudget() const { return budget; }
+
+	// call every frame before drawing t_screen, true when the screen changed since the last call
+	bool use(int t_screen);
+	// number of the frame last passed to use(), for the drawing thread to hand back to frameDrawn
+	long long getFrame() const { return frames; }
+	// drawing thread, with the lock held: t_frame is on screen, so nothing older will be drawn again
+	void frameDrawn(long long t_frame);
+
+	std::size_t getResidentBytes() const { return residentBytes; }
+	int getResidentCount() const;
+	void report() const;
+
+private:
+	struct Entry
+	{
+		sf::Texture* texture = nullptr;
+		std::string file;
+		unsigned screens = 0;
+		bool pinned = false;
+		bool resident = false;
+		bool failed = false; // file wouldn't load, prefetch leaves it alone
+		std::size_t bytes = 0;
+		std::uint64_t lastUsed = 0;
+		long long freeAfterFrame = -1; // evicted but still held until the window thread draws this frame
+		std::vector<sf::Sprite*> sprites;
+	};
+
+	Entry* find(const sf::Texture& t_texture);
+	bool load(Entry& t_entry);
+	void evict(Entry& t_entry);
+	void release(Entry& t_entry);
+	void trimToBudget(unsigned t_keepScreens);
+	void prefetchOne();
+
+	std::unique_lock<std::mutex> lockTextures() { return lock != nullptr ? std::unique_lock<std::mutex>(*lock) : std::unique_lock<std::mutex>(); }
+
+	std::vector<Entry> entries;
+	std::mutex* lock = nullptr;
+	unsigned likelyNext[SCREENS] = {};
+	std::size_t budget = DEFAULT_BUDGET;
+	std::size_t residentBytes = 0;
+	std::uint64_t useCount = 0;
+	long long frames = 0;
+	int currentScreen = -1;
+	bool prefetching = false;
+};
@@ -0,0 +1,373 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Search based robots. A policy only sees an Observation, so the search runs on what the seat
+/// knows: health, both inventories (as counts, which slot an item sits in doesn't matter), how many
+/// live and blank shots are left and the scanner result. Shots it can't see are chance nodes weighted
+/// by the live / blank counts, the opponent is assumed to play the move that's worst for us.
+/// Searching stops at the end of the round, the next deal is unknown, and scores the position on health
+/// and items kept. With a depth limit it's a quick lookahead bot, without one it solves the round
+/// exactly (memoised, the same belief always has the same value).
+/// The policy is specialised on the rule set: the memo key gives each field the bits that rule set
+/// needs, and one whose key won't fit in 64 bits searches without the table (a depth limit then).
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include "MatchState.h"
+
+const double static WIN_SCORE = 100.0;
+const double static ITEM_SCORE = 0.3; // an item kept for the next round, against one point of health
+const std::size_t static MAX_MEMO_ENTRIES = 1 << 20; // the table is dropped and rebuilt past this
+
+/// <summary>
+/// bits it takes to hold 0 to t_largest
+/// </summary>
+constexpr int keyBits(int t_largest)
+{
+	return t_largest > 0 ? 1 + keyBits(t_largest >> 1) : 0;
+}
+
+/// <summary>
+/// everything the searching seat knows about the round
+/// </summary>
+struct RoundBelief
+{
+	int health[2];
+	int items[2][ITEM_TYPES]; // how many of each item, OIL_DRINK is index 0
+	int liveRounds;
+	int blankRounds;
+	bool doubleDamage;
+	bool paused[2];
+	int knownShot; // -1 unknown, otherwise what the scanner said the next shot is
+	int turn;
+};
+
+template <typename Rules>
+class BasicSearchPolicy
+{
+public:
+	static const int EXACT = -1; // no depth limit, solve the round
+
+	explicit BasicSearchPolicy(int t_depth = 3, const char* t_name = "search-3") : depth(t_depth), name(t_name) {}
+
+	const char* getName() const { return name; }
+	Action chooseAction(const BasicObservation<Rules>& t_view);
+
+	long long getNodes() const { return nodes; }
+
+private:
+	// what chooseAction picks between, items by type rather than slot
+	enum Move { SHOOT_SELF_MOVE, SHOOT_OPPONENT_MOVE, FIRST_ITEM_MOVE };
+
+	// memo key fields, sized for the rule set. health clamps at about four times the starting health
+	static constexpr int HEALTH_BITS = keyBits(Rules::startingHealth) + 2;
+	static constexpr int ITEM_BITS = keyBits(Rules::ITEM_CAPACITY);
+	static constexpr int SHOT_BITS = keyBits(Rules::SHOT_CAPACITY);
+	static constexpr int KEY_BITS = 2 * (HEALTH_BITS + ITEM_TYPES * ITEM_BITS + 1) + 2 * SHOT_BITS + 4;
+	static constexpr bool MEMOISED = KEY_BITS <= 64;
+
+	static std::uint64_t key(const RoundBelief& t_belief);
+	double value(const RoundBelief& t_belief, int t_depth);
+	double moveValue(const RoundBelief& t_belief, int t_move, int t_depth);
+	double shotOutcome(RoundBelief t_belief, int t_move, bool t_live, int t_depth);
+	bool isUseful(const RoundBelief& t_belief, int t_move) const;
+	double evaluate(const RoundBelief& t_belief) const;
+
+	int depth;
+	const char* name;
+	int seat = ENEMY; // whose point of view the values are from
+	long long nodes = 0;
+	std::unordered_map<std::uint64_t, double> memo[2]; // exact values, one table per point of view
+};
+
+using SearchPolicy = BasicSearchPolicy<ClassicRules>;
+
+/// <summary>
+/// the exact round solver under its usual name
+/// </summary>
+inline SearchPolicy solverPolicy()
+{
+	return SearchPolicy(SearchPolicy::EXACT, "solver");
+}
+
+/// <summary>
+/// packs the belief into KEY_BITS, each field clamped to what its bits hold
+/// </summary>
+template <typename Rules>
+std::uint64_t BasicSearchPolicy<Rules>::key(const RoundBelief& t_belief)
+{
+	std::uint64_t packed = 0;
+	auto add = [&packed](int t_value, int t_bits)
+	{
+		int limit = (1 << t_bits) - 1;
+		packed = (packed << t_bits) | static_cast<std::uint64_t>(t_value < 0 ? 0 : (t_value > limit ? limit : t_value));
+	};
+	for (int seat = 0; seat < 2; seat++)
+	{
+		add(t_belief.health[seat], HEALTH_BITS);
+		for (int item = 0; item < ITEM_TYPES; item++)
+		{
+			add(t_belief.items[seat][item], ITEM_BITS);
+		}
+		add(t_belief.paused[seat] ? 1 : 0, 1);
+	}
+	add(t_belief.liveRounds, SHOT_BITS);
+	add(t_belief.blankRounds, SHOT_BITS);
+	add(t_belief.doubleDamage ? 1 : 0, 1);
+	add(t_belief.knownShot + 1, 2);
+	add(t_belief.turn, 1);
+	return packed;
+}
+
+template <typename Rules>
+Action BasicSearchPolicy<Rules>::chooseAction(const BasicObservation<Rules>& t_view)
+{
+	seat = t_view.getSeat();
+	RoundBelief belief;
+	belief.health[seat] = t_view.getHealth();
+	belief.health[1 - seat] = t_view.getOpponentHealth();
+	for (int item = 0; item < ITEM_TYPES; item++)
+	{
+		belief.items[0][item] = 0;
+		belief.items[1][item] = 0;
+	}
+	for (int slot = 0; slot < Rules::ITEM_CAPACITY; slot++)
+	{
+		if (t_view.getItem(slot) != 0)
+		{
+			belief.items[seat][t_view.getItem(slot) - 1]++;
+		}
+		if (t_view.getOpponentItem(slot) != 0)
+		{
+			belief.items[1 - seat][t_view.getOpponentItem(slot) - 1]++;
+		}
+	}
+	belief.liveRounds = t_view.getLiveRounds();
+	belief.blankRounds = t_view.getBlankRounds();
+	belief.doubleDamage = t_view.getDoubleDamage();
+	belief.paused[seat] = false; // it's our move, so it isn't holding us up
+	belief.paused[1 - seat] = t_view.getOpponentPaused();
+	belief.knownShot = t_view.getKnowItsLive() ? 1 : (t_view.getKnowItsBlank() ? 0 : -1);
+	belief.turn = seat;
+
+	if (memo[seat].size() > MAX_MEMO_ENTRIES)
+	{
+		memo[seat].clear();
+	}
+
+	int bestMove = SHOOT_OPPONENT_MOVE;
+	double bestValue = -2.0 * WIN_SCORE;
+	for (int move = 0; move < FIRST_ITEM_MOVE + ITEM_TYPES; move++)
+	{
+		if (!isUseful(belief, move))
+		{
+			continue;
+		}
+		double moveScore = moveValue(belief, move, depth);
+		if (moveScore > bestValue)
+		{
+			bestValue = moveScore;
+			bestMove = move;
+		}
+	}
+
+	if (bestMove == SHOOT_SELF_MOVE)
+	{
+		return shootSelfAction();
+	}
+	if (bestMove == SHOOT_OPPONENT_MOVE)
+	{
+		return shootOpponentAction();
+	}
+	return useItemAction(t_view.findItem(bestMove - FIRST_ITEM_MOVE + 1));
+}
+
+/// <summary>
+/// value of t_belief for seat, the side to move picks its best (or our worst) move
+/// </summary>
+template <typename Rules>
+double BasicSearchPolicy<Rules>::value(const RoundBelief& t_belief, int t_depth)
+{
+	nodes++;
+	if (t_belief.health[seat] <= 0)
+	{
+		return -WIN_SCORE;
+	}
+	if (t_belief.health[1 - seat] <= 0)
+	{
+		return WIN_SCORE;
+	}
+	if (t_belief.liveRounds + t_belief.blankRounds == 0 || t_depth == 0)
+	{
+		return evaluate(t_belief);
+	}
+
+	const bool memoise = MEMOISED && t_depth == EXACT;
+	std::uint64_t beliefKey = 0;
+	if (memoise)
+	{
+		beliefKey = key(t_belief);
+		typename std::unordered_map<std::uint64_t, double>::const_iterator found = memo[seat].find(beliefKey);
+		if (found != memo[seat].end())
+		{
+			return found->second;
+		}
+	}
+
+	bool maximise = t_belief.turn == seat;
+	double best = maximise ? -2.0 * WIN_SCORE : 2.0 * WIN_SCORE;
+	for (int move = 0; move < FIRST_ITEM_MOVE + ITEM_TYPES; move++)
+	{
+		if (!isUseful(t_belief, move))
+		{
+			continue;
+		}
+		double moveScore = moveValue(t_belief, move, t_depth == EXACT ? EXACT : t_depth - 1);
+		best = maximise ? (moveScore > best ? moveScore : best) : (moveScore < best ? moveScore : best);
+	}
+
+	if (memoise)
+	{
+		memo[seat][beliefKey] = best;
+	}
+	return best;
+}
+
+/// <summary>
+/// expected value after the side to move plays t_move, averaging over the shot when it isn't known
+/// </summary>
+template <typename Rules>
+double BasicSearchPolicy<Rules>::moveValue(const RoundBelief& t_belief, int t_move, int t_depth)
+{
+	bool needsShot = t_move == SHOOT_SELF_MOVE || t_move == SHOOT_OPPONENT_MOVE
+		|| t_move == FIRST_ITEM_MOVE + SCANNER - 1 || t_move == FIRST_ITEM_MOVE + RUBBISH_BIN - 1;
+	if (!needsShot)
+	{
+		RoundBelief next = t_belief;
+		int mover = next.turn;
+		next.items[mover][t_move - FIRST_ITEM_MOVE]--;
+		switch (t_move - FIRST_ITEM_MOVE + 1)
+		{
+		case OIL_DRINK:
+			next.health[mover]++;
+			break;
+		case PAUSE_REMOTE:
+			next.paused[1 - mover] = true;
+			break;
+		case OVERCHARGER:
+			next.doubleDamage = true;
+			break;
+		}
+		return value(next, t_depth);
+	}
+
+	if (t_belief.knownShot != -1)
+	{
+		return shotOutcome(t_belief, t_move, t_belief.knownShot == 1, t_depth);
+	}
+	int shots = t_belief.liveRounds + t_belief.blankRounds;
+	double expected = 0.0;
+	if (t_belief.liveRounds > 0)
+	{
+		expected += static_cast<double>(t_belief.liveRounds) / shots * shotOutcome(t_belief, t_move, true, t_depth);
+	}
+	if (t_belief.blankRounds > 0)
+	{
+		expected += static_cast<double>(t_belief.blankRounds) / shots * shotOutcome(t_belief, t_move, false, t_depth);
+	}
+	return expected;
+}
+
+/// <summary>
+/// t_move played with the next shot being t_live, same rules as MatchState
+/// </summary>
+template <typename Rules>
+double BasicSearchPolicy<Rules>::shotOutcome(RoundBelief t_belief, int t_move, bool t_live, int t_depth)
+{
+	int mover = t_belief.turn;
+	int other = 1 - mover;
+	if (t_move == FIRST_ITEM_MOVE + SCANNER - 1)
+	{
+		t_belief.items[mover][SCANNER - 1]--;
+		t_belief.knownShot = t_live ? 1 : 0;
+		return value(t_belief, t_depth);
+	}
+	if (t_move == FIRST_ITEM_MOVE + RUBBISH_BIN - 1)
+	{
+		t_belief.items[mover][RUBBISH_BIN - 1]--;
+	}
+	else
+	{
+		int target = t_move == SHOOT_SELF_MOVE ? mover : other;
+		if (t_live)
+		{
+			t_belief.health[target] -= t_belief.doubleDamage ? 2 : 1;
+		}
+		if (t_move == SHOOT_OPPONENT_MOVE || t_live)
+		{
+			if (t_belief.paused[other])
+			{
+				t_belief.paused[other] = false;
+			}
+			else
+			{
+				t_belief.turn = other;
+			}
+		}
+		t_belief.doubleDamage = false;
+	}
+	if (t_live)
+	{
+		t_belief.liveRounds--;
+	}
+	else
+	{
+		t_belief.blankRounds--;
+	}
+	t_belief.knownShot = -1;
+	return value(t_belief, t_depth);
+}
+
+/// <summary>
+/// legal and not a plain waste (a second scan, pause or overcharge does nothing), keeps the tree small
+/// </summary>
+template <typename Rules>
+bool BasicSearchPolicy<Rules>::isUseful(const RoundBelief& t_belief, int t_move) const
+{
+	if (t_move < FIRST_ITEM_MOVE)
+	{
+		return true;
+	}
+	int mover = t_belief.turn;
+	int item = t_move - FIRST_ITEM_MOVE + 1;
+	if (t_belief.items[mover][item - 1] == 0)
+	{
+		return false;
+	}
+	switch (item)
+	{
+	case SCANNER:
+		return t_belief.knownShot == -1;
+	case PAUSE_REMOTE:
+		return !t_belief.paused[1 - mover];
+	case OVERCHARGER:
+		return !t_belief.doubleDamage;
+	}
+	return true;
+}
+
+/// <summary>
+/// end of the round (or of the lookahead): health lead plus a little for items carried over
+/// </summary>
+template <typename Rules>
+double BasicSearchPolicy<Rules>::evaluate(const RoundBelief& t_belief) const
+{
+	double score = t_belief.health[seat] - t_belief.health[1 - seat];
+	for (int item = 0; item < ITEM_TYPES; item++)
+	{
+		score += ITEM_SCORE * (t_belief.items[seat][item] - t_belief.items[1 - seat][item]);
+	}
+	return score;
+}
@@ -0,0 +1,153 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "SessionRecording.h"
+#include "Game.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+bool saveSession(const std::string& t_path, const SessionRecording& t_session)
+{
+	std::FILE* file = std::fopen(t_path.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	SessionHeader header{ SESSION_MAGIC, SESSION_VERSION, static_cast<std::uint32_t>(t_session.keys.size()),
+		t_session.checksum, t_session.seed, t_session.ticks };
+	bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	if (written && !t_session.keys.empty())
+	{
+		written = std::fwrite(t_session.keys.data(), sizeof(SessionKey), t_session.keys.size(), file) == t_session.keys.size();
+	}
+	return std::fclose(file) == 0 && written;
+}
+
+bool loadSession(const std::string& t_path, SessionRecording& t_session)
+{
+	std::FILE* file = std::fopen(t_path.c_str(), "rb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	SessionHeader header;
+	bool read = std::fread(&header, sizeof(header), 1, file) == 1
+		&& header.magic == SESSION_MAGIC && header.version == SESSION_VERSION;
+	SessionRecording loaded;
+	if (read)
+	{
+		loaded.seed = header.seed;
+		loaded.ticks = header.ticks;
+		loaded.checksum = header.checksum;
+		loaded.keys.resize(header.keyCount);
+		read = header.keyCount == 0 || std::fread(loaded.keys.data(), sizeof(SessionKey), header.keyCount, file) == header.keyCount;
+	}
+	std::fclose(file);
+	if (!read)
+	{
+		return false;
+	}
+	t_session = loaded;
+	return true;
+}
+
+/// <summary>
+/// the draw checksum a session rendered to last time, false when there isn't one yet
+/// </summary>
+static bool loadGoldenDraws(const std::string& t_path, std::uint32_t& t_checksum)
+{
+	std::ifstream file(t_path);
+	return static_cast<bool>(file >> t_checksum);
+}
+
+static int checkSession(const std::string& t_path, long long t_tickBudgetMicroseconds, long long t_averageBudgetMicroseconds, bool t_render)
+{
+	SessionRecording session;
+	if (!loadSession(t_path, session))
+	{
+		std::cout << t_path << ": can't read session" << std::endl;
+		return 1;
+	}
+
+	Game replay(true);
+	RecordingRenderBackend draws;
+	ReplayResult result = replay.replaySession(session, t_render ? &draws : nullptr, t_tickBudgetMicroseconds);
+
+	long long average = result.ticks == 0 ? 0 : result.totalMicroseconds / static_cast<long long>(result.ticks);
+	std::cout << t_path << ": " << result.ticks << " ticks, " << session.keys.size() << " keys, " << result.totalMicroseconds / 1000.0
+		<< "ms total, " << average << "us avg, slowest " << result.slowestTickMicroseconds << "us, "
+		<< result.ticksOverBudget << " over " << t_tickBudgetMicroseconds << "us" << std::endl;
+
+	int failures = 0;
+	if (result.ticks != session.ticks || result.checksum != session.checksum)
+	{
+		std::cout << "  FAIL: ended on tick " << result.ticks << " with checksum " << result.checksum << ", recorded "
+			<< session.ticks << " / " << session.checksum << std::endl;
+		failures++;
+	}
+	if (average > t_averageBudgetMicroseconds)
+	{
+		std::cout << "  FAIL: average tick over the " << t_averageBudgetMicroseconds << "us budget" << std::endl;
+		failures++;
+	}
+	if (result.ticksOverBudget * 1000 > static_cast<long long>(result.ticks))
+	{
+		std::cout << "  FAIL: too many ticks over the " << t_tickBudgetMicroseconds << "us budget" << std::endl;
+		failures++;
+	}
+	if (t_render)
+	{
+		std::string golden = t_path + ".golden";
+		std::uint32_t expected = 0;
+		if (!loadGoldenDraws(golden, expected))
+		{
+			std::ofstream(golden) << result.drawChecksum << '\n';
+			std::cout << "  no draw checksum to compare with, wrote this build's to " << golden << std::endl;
+		}
+		else if (expected != result.drawChecksum)
+		{
+			std::cout << "  FAIL: draws differ from " << golden << std::endl;
+			failures++;
+		}
+	}
+	return failures == 0 ? 0 : 1;
+}
+
+int runReplayCheck(const std::string& t_path, long long t_tickBudgetMicroseconds, long long t_averageBudgetMicroseconds, bool t_render)
+{
+	std::vector<std::string> files;
+	std::error_code error;
+	if (std::filesystem::is_directory(t_path, error))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(t_path, error))
+		{
+			if (entry.path().extension() == ".vrss")
+			{
+				files.push_back(entry.path().string());
+			}
+		}
+		std::sort(files.begin(), files.end());
+	}
+	else
+	{
+		files.push_back(t_path);
+	}
+	if (files.empty())
+	{
+		std::cout << "no sessions in " << t_path << std::endl;
+		return 1;
+	}
+
+	int failed = 0;
+	for (const std::string& file : files)
+	{
+		failed += checkSession(file, t_tickBudgetMicroseconds, t_averageBudgetMicroseconds, t_render);
+	}
+	std::cout << files.size() - failed << " of " << files.size() << " sessions passed" << std::endl;
+	return failed;
+}
@@ -0,0 +1,66 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// A played session kept as its seed and every key press with the update tick it was handled on.
+/// Game is deterministic per tick, so feeding the keys back through a headless Game in the same ticks
+/// plays the session again exactly. "--record-session" writes one, "--replay-check" plays a file or a
+/// folder of them back, times every tick against a budget and checks the state at the end matches.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const std::uint32_t static SESSION_VERSION = 1;
+const std::uint32_t static SESSION_MAGIC = 0x53535256; // "VRSS" read as little endian
+
+struct SessionHeader
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint32_t keyCount;
+	std::uint32_t checksum; // Game::sessionChecksum after the last tick
+	std::uint64_t seed;
+	std::uint64_t ticks; // updates run before the session ended
+};
+
+struct SessionKey
+{
+	std::uint32_t tick; // handled before this update
+	std::int32_t key; // sf::Keyboard::Key
+};
+
+struct SessionRecording
+{
+	std::uint64_t seed = 0;
+	std::uint64_t ticks = 0;
+	std::uint32_t checksum = 0;
+	std::vector<SessionKey> keys;
+};
+
+bool saveSession(const std::string& t_path, const SessionRecording& t_session);
+bool loadSession(const std::string& t_path, SessionRecording& t_session);
+
+/// <summary>
+/// what Game::replaySession measured
+/// </summary>
+struct ReplayResult
+{
+	std::uint64_t ticks = 0;
+	std::uint32_t checksum = 0;
+	std::uint32_t drawChecksum = 0; // only when the replay also rendered
+	long long totalMicroseconds = 0;
+	long long slowestTickMicroseconds = 0;
+	long long ticksOverBudget = 0;
+};
+
+/// <summary>
+/// entry point for "--replay-check [session file or folder] [tick budget us] [average budget us] [render]".
+/// a session fails if its checksum differs, its average tick is over budget, or more than one tick in a
+/// thousand is over the tick budget (one slow tick is usually the OS, not the code).
+/// with render every tick is also drawn to a recording backend and the draws are checked against
+/// "<session>.golden", which is written the first time and never overwritten. the goldens belong to the
+/// build that wrote them, so make them on the shipped SFML build. returns the number of sessions that failed
+/// </summary>
+int runReplayCheck(const std::string& t_path, long long t_tickBudgetMicroseconds, long long t_averageBudgetMicroseconds, bool t_render);
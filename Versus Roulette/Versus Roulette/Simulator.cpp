@@ -0,0 +1,336 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Simulator.h"
+#include "TurnScript.h"
+#include "SearchPolicy.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/// <summary>
+/// runs one matchup and prints the result line
+/// </summary>
+template <typename PlayerPolicy, typename EnemyPolicy>
+static void benchmarkMatchup(PlayerPolicy t_playerPolicy, EnemyPolicy t_enemyPolicy, int t_matches, std::uint64_t t_seed)
+{
+	FastRandom random(t_seed);
+	MatchState state;
+	int playerWins = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; match++)
+	{
+		if (playMatch(state, t_playerPolicy, t_enemyPolicy, random) == PLAYER)
+		{
+			playerWins++;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << t_playerPolicy.getName() << " vs " << t_enemyPolicy.getName()
+		<< ": player wins " << 100.0 * playerWins / t_matches << "%, "
+		<< static_cast<long long>(t_matches / (seconds > 0.0 ? seconds : 1e-9)) << " matches/s" << std::endl;
+}
+
+void runSimulatorBenchmark(int t_matches, std::uint64_t t_seed)
+{
+	if (t_matches <= 0)
+	{
+		return;
+	}
+	benchmarkMatchup(HeuristicPolicy(), HeuristicPolicy(), t_matches, t_seed);
+	benchmarkMatchup(HeuristicPolicy(), RandomPolicy(t_seed), t_matches, t_seed);
+	benchmarkMatchup(RandomPolicy(t_seed), HeuristicPolicy(), t_matches, t_seed);
+	benchmarkMatchup(RandomPolicy(t_seed), RandomPolicy(t_seed + 1), t_matches, t_seed);
+
+	// same matchup again through the type erased wrapper Game uses, to show what it costs
+	AnyPolicy erasedPlayer = HeuristicPolicy();
+	AnyPolicy erasedEnemy = HeuristicPolicy();
+	std::cout << "(type erased) ";
+	benchmarkMatchup(std::move(erasedPlayer), std::move(erasedEnemy), t_matches, t_seed);
+
+	// and through the coroutine turn script Game's AI turns use, which has to agree match for match
+	FastRandom loopRandom(t_seed);
+	FastRandom scriptRandom(t_seed);
+	HeuristicPolicy playerPolicy;
+	HeuristicPolicy enemyPolicy;
+	MatchState loopState;
+	MatchState scriptState;
+	int mismatches = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; match++)
+	{
+		playScriptedMatch(scriptState, playerPolicy, enemyPolicy, scriptRandom);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	scriptRandom.seed(t_seed);
+	for (int match = 0; match < t_matches; match++)
+	{
+		playMatch(loopState, playerPolicy, enemyPolicy, loopRandom);
+		playScriptedMatch(scriptState, playerPolicy, enemyPolicy, scriptRandom);
+		if (loopState.checksum() != scriptState.checksum())
+		{
+			mismatches++;
+		}
+	}
+	std::cout << "(turn script) heuristic vs heuristic: " << static_cast<long long>(t_matches / (seconds > 0.0 ? seconds : 1e-9))
+		<< " matches/s, " << mismatches << " matches differ from the plain loop" << std::endl;
+}
+
+
+/// <summary>
+/// the actions t_seat can take, into t_moves, returns how many
+/// </summary>
+static int legalActions(const MatchState& t_state, Action* t_moves)
+{
+	int count = 0;
+	t_moves[count++] = shootSelfAction();
+	t_moves[count++] = shootOpponentAction();
+	for (int slot = 0; slot < MAX_ITEMS; slot++)
+	{
+		if (t_state.inventory[t_state.turn][slot] != 0)
+		{
+			t_moves[count++] = useItemAction(slot);
+		}
+	}
+	return count;
+}
+
+/// <summary>
+/// leaf count to t_depth, a finished match or round is a leaf (the next deal is a chance node)
+/// </summary>
+static long long perftMakeUnmake(MatchState& t_state, int t_depth)
+{
+	if (t_depth == 0 || t_state.isOver() || t_state.needsNewRound())
+	{
+		return 1;
+	}
+	Action moves[2 + MAX_ITEMS];
+	int moveCount = legalActions(t_state, moves);
+	long long leaves = 0;
+	for (int move = 0; move < moveCount; move++)
+	{
+		UndoRecord undo = t_state.makeMove(t_state.turn, moves[move]);
+		leaves += perftMakeUnmake(t_state, t_depth - 1);
+		t_state.undoMove(undo);
+	}
+	return leaves;
+}
+
+static long long perftCopy(const MatchState& t_state, int t_depth)
+{
+	if (t_depth == 0 || t_state.isOver() || t_state.needsNewRound())
+	{
+		return 1;
+	}
+	Action moves[2 + MAX_ITEMS];
+	int moveCount = legalActions(t_state, moves);
+	long long leaves = 0;
+	for (int move = 0; move < moveCount; move++)
+	{
+		MatchState child = t_state;
+		child.apply(child.turn, moves[move]);
+		leaves += perftCopy(child, t_depth - 1);
+	}
+	return leaves;
+}
+
+/// <summary>
+/// perftMakeUnmake that also checks each undo against a copy, and at the first t_roundChecks round ends
+/// undoes every possible next round. returns the number of undos that didn't restore the state
+/// </summary>
+static long long verifyUndo(MatchState& t_state, int t_depth, int& t_roundChecks)
+{
+	long long mismatches = 0;
+	if (t_state.needsNewRound() && !t_state.isOver())
+	{
+		if (t_roundChecks == 0)
+		{
+			return 0;
+		}
+		t_roundChecks--;
+		// every load and every deal at least once, pairing them all would be loads x deals round starts
+		const MatchState before = t_state;
+		const std::uint64_t loads = t_state.taserLoadCount();
+		const int deals = t_state.itemDealCount();
+		double totalChance = 0.0;
+		for (std::uint64_t index = 0; index < std::max<std::uint64_t>(loads, deals); index++)
+		{
+			RoundUndo undo = t_state.startRoundAt(index % loads, static_cast<int>(index % deals));
+			t_state.undoRound(undo);
+			if (t_state.checksum() != before.checksum())
+			{
+				mismatches++;
+			}
+		}
+		for (int deal = 0; deal < deals; deal++)
+		{
+			MatchState dealt = t_state;
+			totalChance += dealt.dealItemsAt(deal);
+		}
+		if (totalChance < 0.999999 || totalChance > 1.000001)
+		{
+			mismatches++; // the deals don't cover every outcome
+		}
+		return mismatches;
+	}
+	if (t_depth == 0 || t_state.isOver())
+	{
+		return 0;
+	}
+	Action moves[2 + MAX_ITEMS];
+	int moveCount = legalActions(t_state, moves);
+	for (int move = 0; move < moveCount; move++)
+	{
+		const MatchState before = t_state;
+		MatchState expected = t_state;
+		expected.apply(expected.turn, moves[move]);
+		UndoRecord undo = t_state.makeMove(t_state.turn, moves[move]);
+		if (t_state.checksum() != expected.checksum())
+		{
+			mismatches++;
+		}
+		mismatches += verifyUndo(t_state, t_depth - 1, t_roundChecks);
+		t_state.undoMove(undo);
+		if (t_state.checksum() != before.checksum())
+		{
+			mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+void runMakeUnmakeBenchmark(int t_depth, int t_positions, std::uint64_t t_seed)
+{
+	FastRandom random(t_seed);
+	RandomPolicy playerPolicy(t_seed);
+	RandomPolicy enemyPolicy(t_seed + 1);
+	std::vector<MatchState> positions;
+	for (int position = 0; position < t_positions; position++)
+	{
+		MatchState state;
+		state.reset();
+		state.startRound(random);
+		int moves = random.nextInt(3);
+		for (int move = 0; move < moves && !state.isOver() && !state.needsNewRound(); move++)
+		{
+			Observation view(state, state.turn);
+			state.apply(state.turn, state.turn == PLAYER ? playerPolicy.chooseAction(view) : enemyPolicy.chooseAction(view));
+		}
+		if (!state.isOver() && !state.needsNewRound())
+		{
+			positions.push_back(state);
+		}
+	}
+
+	long long mismatches = 0;
+	for (MatchState& position : positions)
+	{
+		int roundChecks = 16; // round starts are checked at the first few round ends, they're slow to enumerate
+		mismatches += verifyUndo(position, t_depth, roundChecks);
+	}
+
+	long long makeLeaves = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (MatchState& position : positions)
+	{
+		makeLeaves += perftMakeUnmake(position, t_depth);
+	}
+	double makeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	long long copyLeaves = 0;
+	start = std::chrono::steady_clock::now();
+	for (const MatchState& position : positions)
+	{
+		copyLeaves += perftCopy(position, t_depth);
+	}
+	double copySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << positions.size() << " positions to depth " << t_depth << ": " << makeLeaves << " leaves, make/unmake "
+		<< static_cast<long long>(makeLeaves / std::max(makeSeconds, 1e-9)) << " leaves/s, copy "
+		<< static_cast<long long>(copyLeaves / std::max(copySeconds, 1e-9)) << " leaves/s"
+		<< (makeLeaves == copyLeaves ? "" : " (LEAF COUNTS DIFFER)") << ", " << mismatches << " bad undos" << std::endl;
+}
+
+/// <summary>
+/// t_rules as a RuleConfig, the same rules read from memory instead of folded into the code
+/// </summary>
+template <typename Rules>
+static RuleConfig runtimeRules(const Rules& t_rules)
+{
+	return RuleConfig{ { 1, 1, 1, 1, 1 }, t_rules.magazineSize, t_rules.startingHealth, t_rules.itemsPerRound, t_rules.maxRounds };
+}
+
+/// <summary>
+/// t_matches of one variant played with its rule set, so every rule is a constant, and again from the same
+/// seed with the rules read from a RuleConfig, which has to end every match the same way. then a few matches
+/// of the variant's own search policy against the heuristic
+/// </summary>
+template <typename Rules>
+static void benchmarkVariant(const char* t_name, int t_matches, std::uint64_t t_seed)
+{
+	const Rules rules;
+	const RuleConfig runtime = runtimeRules(rules);
+	BasicMatchState<Rules> state;
+	HeuristicPolicy playerPolicy;
+	HeuristicPolicy enemyPolicy;
+	NullMatchObserver observer;
+
+	FastRandom random(t_seed);
+	long long playerWins = 0;
+	std::uint32_t endings = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; match++)
+	{
+		playerWins += playMatch(state, playerPolicy, enemyPolicy, random, rules, observer) == PLAYER ? 1 : 0;
+		endings = endings * 31 + state.checksum();
+	}
+	double fixedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	random.seed(t_seed);
+	std::uint32_t runtimeEndings = 0;
+	start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; match++)
+	{
+		playMatch(state, playerPolicy, enemyPolicy, random, runtime, observer);
+		runtimeEndings = runtimeEndings * 31 + state.checksum();
+	}
+	double runtimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	const int searchMatches = std::max(t_matches / 1000, 1);
+	BasicSearchPolicy<Rules> searchPolicy(2, "search-2");
+	random.seed(t_seed);
+	long long searchWins = 0;
+	start = std::chrono::steady_clock::now();
+	for (int match = 0; match < searchMatches; match++)
+	{
+		searchWins += playMatch(state, searchPolicy, enemyPolicy, random, rules, observer) == PLAYER ? 1 : 0;
+	}
+	double searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double fixedRate = t_matches / std::max(fixedSeconds, 1e-9);
+	double runtimeRate = t_matches / std::max(runtimeSeconds, 1e-9);
+	std::cout << t_name << " (" << sizeof(BasicMatchState<Rules>) << " bytes): player wins " << 100.0 * playerWins / t_matches
+		<< "%, specialised " << static_cast<long long>(fixedRate) << " matches/s, runtime rules "
+		<< static_cast<long long>(runtimeRate) << " matches/s, " << fixedRate / runtimeRate << "x"
+		<< (endings == runtimeEndings ? "" : " RESULTS DIFFER") << "; search-2 wins " << 100.0 * searchWins / searchMatches
+		<< "% at " << static_cast<long long>(searchMatches / std::max(searchSeconds, 1e-9)) << " matches/s" << std::endl;
+}
+
+void runRuleVariantBenchmark(int t_matches, std::uint64_t t_seed)
+{
+	if (t_matches <= 0)
+	{
+		return;
+	}
+	benchmarkVariant<ClassicRules>("classic 6 shots 4 slots 5 health", t_matches, t_seed);
+	benchmarkVariant<FixedRules<6, 4, 12, 2>>("12 health", t_matches, t_seed);
+	benchmarkVariant<FixedRules<16, 4, 5, 2>>("16 shots", t_matches, t_seed);
+	benchmarkVariant<FixedRules<16, 8, 8, 4>>("16 shots 8 slots 8 health", t_matches, t_seed);
+	benchmarkVariant<FixedRules<32, 8, 10, 4>>("32 shots 8 slots 10 health", t_matches, t_seed);
+	benchmarkVariant<FixedRules<64, 8, 20, 4>>("64 shots 8 slots 20 health", t_matches / 4, t_seed);
+}
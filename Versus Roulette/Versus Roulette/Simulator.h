@@ -0,0 +1,94 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Headless match loop. No window, sprites or sounds, just a match state and two policies.
+/// The loop takes any rule set's state, played with the rule set itself or a RuleConfig.
+#pragma once
+
+#include <cstdint>
+#include "MatchState.h"
+#include "Policy.h"
+
+/// <summary>
+/// hooks for anything that wants to watch a simulated match (stats, logs).
+/// playMatch takes the observer as a template parameter, so the empty one costs nothing
+/// </summary>
+struct NullMatchObserver
+{
+	template <typename State> void onRoundStart(const State&) {}
+	template <typename State> void onAction(const State& /*t_before*/, int /*t_seat*/, Action /*t_action*/, const State& /*t_after*/) {}
+	template <typename State> void onMatchEnd(const State&, int /*t_winner*/) {}
+};
+
+/// <summary>
+/// plays a match on from whatever position t_state holds and returns the winning seat (NO_WINNER for a draw).
+/// policies are template parameters so each decision is a plain (inlinable) call.
+/// an illegal choice is treated as shooting the opponent so a bad policy can't stall the match
+/// </summary>
+template <typename Rules, typename Config, typename PlayerPolicy, typename EnemyPolicy, typename MatchObserver>
+int continueMatch(BasicMatchState<Rules>& t_state, PlayerPolicy& t_playerPolicy, EnemyPolicy& t_enemyPolicy, FastRandom& t_random,
+	const Config& t_rules, MatchObserver& t_observer)
+{
+	while (!t_state.isOver() && !t_state.isOutOfRounds(t_rules))
+	{
+		if (t_state.needsNewRound())
+		{
+			t_state.startRound(t_random, t_rules);
+			t_observer.onRoundStart(t_state);
+		}
+
+		const int seat = t_state.turn;
+		BasicObservation<Rules> view(t_state, seat);
+		Action action = seat == PLAYER ? t_playerPolicy.chooseAction(view) : t_enemyPolicy.chooseAction(view);
+		if (!t_state.isLegal(seat, action))
+		{
+			action = shootOpponentAction();
+		}
+		const BasicMatchState<Rules> before = t_state;
+		t_state.apply(seat, action);
+		t_observer.onAction(before, seat, action, t_state);
+	}
+	const int winner = t_state.winner();
+	t_observer.onMatchEnd(t_state, winner);
+	return winner;
+}
+
+/// <summary>
+/// plays one full match from a fresh state
+/// </summary>
+template <typename Rules, typename Config, typename PlayerPolicy, typename EnemyPolicy, typename MatchObserver>
+int playMatch(BasicMatchState<Rules>& t_state, PlayerPolicy& t_playerPolicy, EnemyPolicy& t_enemyPolicy, FastRandom& t_random,
+	const Config& t_rules, MatchObserver& t_observer)
+{
+	t_state.reset(t_rules);
+	return continueMatch(t_state, t_playerPolicy, t_enemyPolicy, t_random, t_rules, t_observer);
+}
+
+/// <summary>
+/// plays one full match under the state's own rule set, for ClassicRules the same matches as DEFAULT_RULES
+/// </summary>
+template <typename Rules, typename PlayerPolicy, typename EnemyPolicy>
+int playMatch(BasicMatchState<Rules>& t_state, PlayerPolicy& t_playerPolicy, EnemyPolicy& t_enemyPolicy, FastRandom& t_random)
+{
+	NullMatchObserver observer;
+	return playMatch(t_state, t_playerPolicy, t_enemyPolicy, t_random, Rules(), observer);
+}
+
+/// <summary>
+/// plays t_matches headless matches and prints win rates and matches per second
+/// </summary>
+void runSimulatorBenchmark(int t_matches, std::uint64_t t_seed);
+
+/// <summary>
+/// entry point for "--perft [depth] [positions] [seed]": counts every action sequence to t_depth from
+/// random mid round positions with makeMove / undoMove and again by copying the state, checks undo puts
+/// every field back (round starts included, over every taser load and item deal) and prints nodes/s for both
+/// </summary>
+void runMakeUnmakeBenchmark(int t_depth, int t_positions, std::uint64_t t_seed);
+
+/// <summary>
+/// entry point for "--rule-variants [matches] [seed]": heuristic vs heuristic under each compile time rule
+/// variant, played with the rule set against the same state reading a RuleConfig, plus the variant's search policy
+/// </summary>
+void runRuleVariantBenchmark(int t_matches, std::uint64_t t_seed);
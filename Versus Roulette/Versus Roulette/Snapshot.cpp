@@ -0,0 +1,107 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Snapshot.h"
+#include "InvariantChecker.h"
+#include "Simulator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+MatchSnapshot makeSnapshot(const MatchState& t_state, std::uint64_t t_seed)
+{
+	MatchSnapshot snapshot;
+	std::memset(&snapshot, 0, sizeof(snapshot)); // no stray padding bytes in the file
+	snapshot.magic = SNAPSHOT_MAGIC;
+	snapshot.version = SNAPSHOT_VERSION;
+	snapshot.size = sizeof(MatchSnapshot);
+	snapshot.seed = t_seed;
+	std::memcpy(&snapshot.state, &t_state, sizeof(MatchState));
+	return snapshot;
+}
+
+/// <summary>
+/// header matches this build and the state is one the rules could have reached: the same invariants
+/// the checker holds every match to (the taser, its counts and the inventories agree with each other)
+/// and both robots still standing, so the next shot can't read outside the taser
+/// </summary>
+bool isValidSnapshot(const MatchSnapshot& t_snapshot)
+{
+	const MatchState& state = t_snapshot.state;
+	if (t_snapshot.magic != SNAPSHOT_MAGIC || t_snapshot.version != SNAPSHOT_VERSION || t_snapshot.size != sizeof(MatchSnapshot))
+	{
+		return false;
+	}
+	if (state.health[PLAYER] <= 0 || state.health[ENEMY] <= 0 || state.round < 0)
+	{
+		return false;
+	}
+	return checkMatchInvariants(state, DEFAULT_RULES) == nullptr;
+}
+
+bool saveSnapshot(const std::string& t_path, const MatchSnapshot& t_snapshot)
+{
+	std::FILE* file = std::fopen(t_path.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	bool written = std::fwrite(&t_snapshot, sizeof(MatchSnapshot), 1, file) == 1;
+	return std::fclose(file) == 0 && written;
+}
+
+bool loadSnapshot(const std::string& t_path, MatchSnapshot& t_snapshot)
+{
+	std::FILE* file = std::fopen(t_path.c_str(), "rb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	MatchSnapshot loaded;
+	bool read = std::fread(&loaded, sizeof(MatchSnapshot), 1, file) == 1;
+	std::fclose(file);
+	if (!read || !isValidSnapshot(loaded))
+	{
+		return false;
+	}
+	t_snapshot = loaded;
+	return true;
+}
+
+void runSnapshotBenchmark(const std::string& t_path, int t_matches)
+{
+	MatchSnapshot snapshot;
+	if (!loadSnapshot(t_path, snapshot))
+	{
+		std::cout << "problem loading snapshot " << t_path << std::endl;
+		return;
+	}
+
+	FastRandom random(snapshot.seed);
+	HeuristicPolicy playerPolicy;
+	HeuristicPolicy enemyPolicy;
+	NullMatchObserver observer;
+	MatchState state;
+	int wins[2] = { 0, 0 };
+
+	auto start = std::chrono::steady_clock::now();
+	for (int match = 0; match < t_matches; match++)
+	{
+		state = snapshot.state; // restarting from the position is one copy
+		int winner = continueMatch(state, playerPolicy, enemyPolicy, random, DEFAULT_RULES, observer);
+		if (winner != NO_WINNER)
+		{
+			wins[winner]++;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "from " << t_path << " (round " << snapshot.state.round << ", health "
+		<< snapshot.state.health[PLAYER] << "-" << snapshot.state.health[ENEMY] << "): player wins "
+		<< 100.0 * wins[PLAYER] / (t_matches > 0 ? t_matches : 1) << "%, enemy wins "
+		<< 100.0 * wins[ENEMY] / (t_matches > 0 ? t_matches : 1) << "%, "
+		<< static_cast<long long>(t_matches / (seconds > 0.0 ? seconds : 1e-9)) << " matches/s" << std::endl;
+}
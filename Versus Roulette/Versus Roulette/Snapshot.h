@@ -0,0 +1,44 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Save file for a match in progress. The file is the MatchSnapshot struct byte for byte,
+/// so saving and loading is a single write / read and a header check.
+/// Snapshots double as starting positions for the simulator ("--simulate-from").
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "MatchState.h"
+
+// bump whenever MatchState or MatchSnapshot changes layout, old files are then refused
+const std::uint32_t static SNAPSHOT_VERSION = 1;
+const std::uint32_t static SNAPSHOT_MAGIC = 0x56535256; // "VRSV" read as little endian
+
+static const char* const QUICKSAVE_FILE = "quicksave.vrs"; // F5 saves here, F9 loads
+
+struct MatchSnapshot
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint32_t size; // sizeof(MatchSnapshot) when written, catches builds with a different layout
+	std::uint32_t reserved;
+	std::uint64_t seed; // seeds the FastRandom that continues the match headless
+	MatchState state;
+};
+
+static_assert(std::is_trivially_copyable<MatchSnapshot>::value, "snapshots are written with a single memcpy");
+static_assert(sizeof(MatchState) == 96, "MatchState layout changed, bump SNAPSHOT_VERSION and update this size");
+
+MatchSnapshot makeSnapshot(const MatchState& t_state, std::uint64_t t_seed);
+bool isValidSnapshot(const MatchSnapshot& t_snapshot);
+
+bool saveSnapshot(const std::string& t_path, const MatchSnapshot& t_snapshot);
+bool loadSnapshot(const std::string& t_path, MatchSnapshot& t_snapshot);
+
+/// <summary>
+/// entry point for "--simulate-from [file] [matches]": plays the saved position out
+/// heuristic vs heuristic and reports how often each seat wins from there
+/// </summary>
+void runSnapshotBenchmark(const std::string& t_path, int t_matches);
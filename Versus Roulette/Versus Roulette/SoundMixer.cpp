@@ -0,0 +1,206 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "SoundMixer.h"
+#include "Logger.h"
+#include <iostream>
+
+/// <summary>
+/// how long the mixer thread sleeps when there's nothing queued, the worst case play() latency
+/// </summary>
+const std::chrono::microseconds static MIXER_POLL_INTERVAL{ 1000 };
+
+SoundMixer::SoundMixer() :
+	voicesStarted(0),
+	running(false),
+	played(0),
+	dropped(0),
+	stolen(0),
+	totalLatencyNs(0),
+	maxLatencyNs(0)
+{
+}
+
+SoundMixer::~SoundMixer()
+{
+	stop();
+}
+
+/// <summary>
+/// loads an effect into its slot, a missing file just leaves the effect silent
+/// </summary>
+bool SoundMixer::loadEffect(SoundEffect t_effect, const std::string& t_file, float t_volume, int t_priority, int t_maxInstances)
+{
+	Effect& effect = effects[t_effect];
+	effect.volume = t_volume;
+	effect.priority = t_priority;
+	effect.maxInstances = t_maxInstances < 1 ? 1 : t_maxInstances;
+	effect.loaded = effect.buffer.loadFromFile(t_file);
+	if (!effect.loaded)
+	{
+		LOG_ERROR("sound effect %s not loading", t_file.c_str());
+	}
+	return effect.loaded;
+}
+
+void SoundMixer::start()
+{
+	if (running.load())
+	{
+		return;
+	}
+	running.store(true);
+	thread = std::thread(&SoundMixer::run, this);
+}
+
+void SoundMixer::stop()
+{
+	if (!running.exchange(false))
+	{
+		return;
+	}
+	thread.join();
+	for (Voice& voice : voices)
+	{
+		voice.sound.stop();
+		voice.effect = -1;
+	}
+	if (played.load() > 0)
+	{
+		std::cout << "sound effects: " << played.load() << " played, " << stolen.load() << " voices stolen, "
+			<< dropped.load() << " dropped, play latency avg " << getAverageLatency() << "us max " << getMaxLatency() << "us" << std::endl;
+	}
+}
+
+/// <summary>
+/// queues an effect, never blocks or allocates. the mixer thread picks a voice for it
+/// </summary>
+void SoundMixer::play(SoundEffect t_effect)
+{
+	if (!running.load(std::memory_order_relaxed) || !commands.push(Command{ t_effect, std::chrono::steady_clock::now() }))
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+double SoundMixer::getAverageLatency() const
+{
+	std::uint64_t count = played.load(std::memory_order_relaxed);
+	return count == 0 ? 0.0 : totalLatencyNs.load(std::memory_order_relaxed) / 1000.0 / count;
+}
+
+/// <summary>
+/// mixer thread: drains the queue then sleeps a little, voices that finished are freed as it goes
+/// </summary>
+void SoundMixer::run()
+{
+	while (running.load(std::memory_order_relaxed))
+	{
+		Command command;
+		if (!commands.pop(command))
+		{
+			std::this_thread::sleep_for(MIXER_POLL_INTERVAL);
+			continue;
+		}
+		do
+		{
+			if (!startVoice(command.effect))
+			{
+				continue;
+			}
+
+			std::uint64_t latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - command.queuedAt).count());
+			totalLatencyNs.fetch_add(latency, std::memory_order_relaxed);
+			if (latency > maxLatencyNs.load(std::memory_order_relaxed))
+			{
+				maxLatencyNs.store(latency, std::memory_order_relaxed); // only this thread writes it
+			}
+			played.fetch_add(1, std::memory_order_relaxed);
+		} while (commands.pop(command));
+	}
+}
+
+bool SoundMixer::startVoice(SoundEffect t_effect)
+{
+	const Effect& effect = effects[t_effect];
+	if (!effect.loaded)
+	{
+		return false;
+	}
+	int index = pickVoice(t_effect);
+	if (index < 0)
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	Voice& voice = voices[index];
+	if (voice.effect >= 0)
+	{
+		voice.sound.stop();
+		stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+	voice.sound.setBuffer(effect.buffer);
+	voice.sound.setVolume(effect.volume);
+	voice.sound.play();
+	voice.effect = t_effect;
+	voice.startedAt = ++voicesStarted;
+	return true;
+}
+
+/// <summary>
+/// a free voice if there is one. at the effect's instance cap its own oldest copy is reused,
+/// otherwise the oldest voice of the lowest priority that isn't above this effect's. -1 drops the play
+/// </summary>
+int SoundMixer::pickVoice(SoundEffect t_effect)
+{
+	int instances = 0;
+	int oldestInstance = -1;
+	int freeVoice = -1;
+	int victim = -1;
+	for (int i = 0; i < VOICES; i++)
+	{
+		Voice& voice = voices[i];
+		if (voice.effect >= 0 && voice.sound.getStatus() == sf::SoundSource::Stopped)
+		{
+			voice.effect = -1; // finished by itself
+		}
+		if (voice.effect < 0)
+		{
+			if (freeVoice < 0)
+			{
+				freeVoice = i;
+			}
+			continue;
+		}
+		if (voice.effect == t_effect)
+		{
+			instances++;
+			if (oldestInstance < 0 || voice.startedAt < voices[oldestInstance].startedAt)
+			{
+				oldestInstance = i;
+			}
+		}
+		int priority = effects[voice.effect].priority;
+		if (priority <= effects[t_effect].priority)
+		{
+			if (victim < 0 || priority < effects[voices[victim].effect].priority
+				|| (priority == effects[voices[victim].effect].priority && voice.startedAt < voices[victim].startedAt))
+			{
+				victim = i;
+			}
+		}
+	}
+
+	if (instances >= effects[t_effect].maxInstances)
+	{
+		return oldestInstance;
+	}
+	if (freeVoice >= 0)
+	{
+		return freeVoice;
+	}
+	return victim;
+}
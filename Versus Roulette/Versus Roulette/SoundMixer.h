@@ -0,0 +1,100 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Sound effect mixer. All the effects share a fixed pool of voices, so the same effect can overlap
+/// itself instead of being restarted. When the pool is full the quietest-priority, oldest voice is
+/// stolen, and each effect has a cap on how many copies of it can play at once.
+/// play() only writes a command into a lock-free ring, a mixer thread owns every sf::Sound and
+/// talks to the audio API, so the game thread never waits on it and never allocates.
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "SpscQueue.h"
+
+enum SoundEffect
+{
+	SFX_ROBOT_OUCH,
+	SFX_ZAP,
+	SFX_BLANK,
+	SFX_MENU_BEEP,
+	SFX_MENU_BOOP,
+	SFX_OIL_DRINK,
+	SFX_SCANNER,
+	SFX_PAUSE_REMOTE,
+	SFX_OVERCHARGER,
+	SFX_RUBBISH_BIN,
+	SFX_COUNT
+};
+
+class SoundMixer
+{
+public:
+	static const int VOICES = 16;
+	static const int QUEUE_SIZE = 64; // power of 2, a full queue drops the play rather than wait
+
+	SoundMixer();
+	~SoundMixer();
+
+	// before start(), higher priority voices are stolen last
+	bool loadEffect(SoundEffect t_effect, const std::string& t_file, float t_volume, int t_priority, int t_maxInstances);
+	void start();
+	void stop(); // waits for the mixer thread and stops every voice, prints the latency stats
+
+	void play(SoundEffect t_effect); // game thread only
+
+	// the time from play() to the voice being started, in microseconds
+	double getAverageLatency() const;
+	double getMaxLatency() const { return maxLatencyNs.load(std::memory_order_relaxed) / 1000.0; }
+	std::uint64_t getPlayedCount() const { return played.load(std::memory_order_relaxed); }
+	std::uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+	std::uint64_t getStolenCount() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+	struct Command
+	{
+		SoundEffect effect;
+		std::chrono::steady_clock::time_point queuedAt;
+	};
+
+	struct Effect
+	{
+		sf::SoundBuffer buffer;
+		float volume = 100.0f;
+		int priority = 0;
+		int maxInstances = 1;
+		bool loaded = false;
+	};
+
+	struct Voice
+	{
+		sf::Sound sound;
+		int effect = -1; // -1 when free
+		std::uint64_t startedAt = 0; // play order, lowest is the oldest
+	};
+
+	void run();
+	bool startVoice(SoundEffect t_effect);
+	int pickVoice(SoundEffect t_effect);
+
+	std::array<Effect, SFX_COUNT> effects;
+	std::array<Voice, VOICES> voices;
+	std::uint64_t voicesStarted; // mixer thread only
+
+	SpscQueue<Command, QUEUE_SIZE> commands; // game thread to mixer thread
+
+	std::thread thread;
+	std::atomic<bool> running;
+
+	std::atomic<std::uint64_t> played;
+	std::atomic<std::uint64_t> dropped;
+	std::atomic<std::uint64_t> stolen;
+	std::atomic<std::uint64_t> totalLatencyNs;
+	std::atomic<std::uint64_t> maxLatencyNs;
+};
@@ -0,0 +1,642 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Spectator.h"
+#include "TextureCache.h"
+#include "Logger.h"
+#include "Player.h"
+#include "Enemy.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+// stream starts with "VRSP" and a version byte, then packets of
+// type(1) ticksSinceLastPacket(varint) and either every field (keyframe) or a field delta
+static const char STREAM_MAGIC[4] = { 'V', 'R', 'S', 'P' };
+static const unsigned char STREAM_VERSION = 1;
+static const int STREAM_HEADER_SIZE = 5;
+static const unsigned char KEYFRAME_PACKET = 1;
+static const unsigned char DELTA_PACKET = 2;
+
+static std::string streamHeader()
+{
+	std::string header(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+	header.push_back(static_cast<char>(STREAM_VERSION));
+	return header;
+}
+
+MatchView SpectatorFrame::getView() const
+{
+	MatchView view;
+	for (int index = 0; index < MatchView::FIELDS; index++)
+	{
+		view.field[index] = field[index];
+	}
+	return view;
+}
+
+void SpectatorFrame::setView(const MatchView& t_view)
+{
+	for (int index = 0; index < MatchView::FIELDS; index++)
+	{
+		field[index] = t_view.field[index];
+	}
+}
+
+SpectatorBroadcaster::SpectatorBroadcaster() :
+	listening{ false },
+	last{},
+	hasLast{ false },
+	ticksSinceLast{ 0 },
+	ticksSinceKeyframe{ 0 },
+	packets{ 0 },
+	deltaBytes{ 0 },
+	deltaPackets{ 0 }
+{
+}
+
+SpectatorBroadcaster::~SpectatorBroadcaster()
+{
+	close();
+}
+
+bool SpectatorBroadcaster::open(unsigned short t_port, const std::string& t_recordingFile)
+{
+	close();
+	if (t_port != 0)
+	{
+		if (listener.listen(t_port) != sf::Socket::Done)
+		{
+			std::cout << "problem listening for spectators on port " << t_port << std::endl;
+			return false;
+		}
+		listener.setBlocking(false);
+		listening = true;
+	}
+	if (!t_recordingFile.empty())
+	{
+		recording.open(t_recordingFile, std::ios::binary);
+		if (!recording)
+		{
+			std::cout << "problem opening spectator recording " << t_recordingFile << std::endl;
+			close();
+			return false;
+		}
+		recording << streamHeader();
+	}
+	hasLast = false;
+	return true;
+}
+
+void SpectatorBroadcaster::close()
+{
+	if (packets > 0)
+	{
+		std::cout << "spectator stream: " << packets << " packets, deltas averaged "
+			<< (deltaPackets ? static_cast<double>(deltaBytes) / deltaPackets : 0.0) << " bytes" << std::endl;
+	}
+	packets = 0;
+	deltaBytes = 0;
+	deltaPackets = 0;
+	viewers.clear();
+	if (listening)
+	{
+		listener.close();
+		listening = false;
+	}
+	if (recording.is_open())
+	{
+		recording.close();
+	}
+}
+
+/// <summary>
+/// sends a packet if anything on screen changed since the last one
+/// </summary>
+void SpectatorBroadcaster::update(const SpectatorFrame& t_frame)
+{
+	if (!isOpen())
+	{
+		return;
+	}
+	ticksSinceLast++;
+	ticksSinceKeyframe++;
+	acceptViewers();
+
+	bool changed = !hasLast || !std::equal(std::begin(t_frame.field), std::end(t_frame.field), std::begin(last.field));
+	bool keyframeDue = !hasLast || ticksSinceKeyframe >= KEYFRAME_INTERVAL;
+	if (changed || (keyframeDue && recording.is_open()))
+	{
+		// viewers already have a keyframe from when they joined, only the recording needs the periodic ones
+		std::string delta = makePacket(!hasLast, t_frame);
+		if (recording.is_open())
+		{
+			recording << (keyframeDue ? makePacket(true, t_frame) : delta);
+		}
+		if (changed)
+		{
+			for (auto& viewer : viewers)
+			{
+				viewer->outgoing += delta;
+			}
+			deltaBytes += static_cast<long long>(delta.size());
+			deltaPackets++;
+		}
+		packets++;
+		last = t_frame;
+		hasLast = true;
+		ticksSinceLast = 0;
+		if (keyframeDue)
+		{
+			ticksSinceKeyframe = 0;
+		}
+	}
+	flushViewers();
+}
+
+void SpectatorBroadcaster::acceptViewers()
+{
+	if (!listening)
+	{
+		return;
+	}
+	std::unique_ptr<Viewer> viewer(new Viewer());
+	while (listener.accept(viewer->socket) == sf::Socket::Done)
+	{
+		viewer->socket.setBlocking(false);
+		viewer->outgoing = streamHeader();
+		if (hasLast)
+		{
+			viewer->outgoing += makePacket(true, last);
+		}
+		viewers.push_back(std::move(viewer));
+		viewer.reset(new Viewer());
+	}
+}
+
+/// <summary>
+/// sends what each viewer's socket will take, anyone too far behind is dropped rather than holding up the rest
+/// </summary>
+void SpectatorBroadcaster::flushViewers()
+{
+	for (std::size_t index = 0; index < viewers.size();)
+	{
+		Viewer& viewer = *viewers[index];
+		sf::Socket::Status status = sf::Socket::Done;
+		while (!viewer.outgoing.empty())
+		{
+			std::size_t sent = 0;
+			status = viewer.socket.send(viewer.outgoing.data(), viewer.outgoing.size(), sent);
+			viewer.outgoing.erase(0, sent);
+			if (status != sf::Socket::Done)
+			{
+				break;
+			}
+		}
+		if (status == sf::Socket::Disconnected || status == sf::Socket::Error || viewer.outgoing.size() > static_cast<std::size_t>(MAX_SPECTATOR_BACKLOG))
+		{
+			viewers.erase(viewers.begin() + static_cast<std::ptrdiff_t>(index));
+			continue;
+		}
+		index++;
+	}
+}
+
+std::string SpectatorBroadcaster::makePacket(bool t_keyframe, const SpectatorFrame& t_frame) const
+{
+	std::string packet;
+	packet.push_back(static_cast<char>(t_keyframe ? KEYFRAME_PACKET : DELTA_PACKET));
+	unsigned int ticks = static_cast<unsigned int>(ticksSinceLast);
+	while (ticks >= 0x80)
+	{
+		packet.push_back(static_cast<char>((ticks & 0x7F) | 0x80));
+		ticks >>= 7;
+	}
+	packet.push_back(static_cast<char>(ticks));
+
+	if (t_keyframe)
+	{
+		packet.append(reinterpret_cast<const char*>(t_frame.field), SpectatorFrame::FIELDS);
+	}
+	else
+	{
+		unsigned char delta[SpectatorFrame::FIELDS + SpectatorFrame::FIELDS / 8 + 1];
+		int size = encodeFieldDelta(t_frame.field, last.field, SpectatorFrame::FIELDS, delta);
+		packet.append(reinterpret_cast<const char*>(delta), static_cast<std::size_t>(size));
+	}
+	return packet;
+}
+
+SpectatorDecoder::SpectatorDecoder() :
+	offset{ 0 },
+	hasHeader{ false },
+	hasKeyframe{ false },
+	broken{ false },
+	frame{}
+{
+}
+
+void SpectatorDecoder::feed(const char* t_data, std::size_t t_size)
+{
+	buffer.erase(0, offset);
+	offset = 0;
+	buffer.append(t_data, t_size);
+}
+
+bool SpectatorDecoder::next(SpectatorFrame& t_frame, int& t_ticks)
+{
+	while (!broken)
+	{
+		const unsigned char* data = reinterpret_cast<const unsigned char*>(buffer.data()) + offset;
+		std::size_t left = buffer.size() - offset;
+		if (!hasHeader)
+		{
+			if (left < static_cast<std::size_t>(STREAM_HEADER_SIZE))
+			{
+				return false;
+			}
+			if (!std::equal(STREAM_MAGIC, STREAM_MAGIC + sizeof(STREAM_MAGIC), reinterpret_cast<const char*>(data))
+				|| data[4] != STREAM_VERSION)
+			{
+				LOG_WARNING("not a spectator stream this version can read");
+				broken = true;
+				return false;
+			}
+			hasHeader = true;
+			offset += STREAM_HEADER_SIZE;
+			continue;
+		}
+
+		// type and ticks
+		std::size_t read = 1;
+		unsigned int ticks = 0;
+		int shift = 0;
+		while (true)
+		{
+			if (read >= left)
+			{
+				return false;
+			}
+			unsigned char byte = data[read++];
+			ticks |= static_cast<unsigned int>(byte & 0x7F) << shift;
+			shift += 7;
+			if ((byte & 0x80) == 0)
+			{
+				break;
+			}
+		}
+
+		if (data[0] == KEYFRAME_PACKET)
+		{
+			if (left - read < static_cast<std::size_t>(SpectatorFrame::FIELDS))
+			{
+				return false;
+			}
+			for (int index = 0; index < SpectatorFrame::FIELDS; index++)
+			{
+				frame.field[index] = static_cast<signed char>(data[read + index]);
+			}
+			read += SpectatorFrame::FIELDS;
+			hasKeyframe = true;
+		}
+		else if (data[0] == DELTA_PACKET)
+		{
+			if (left - read < static_cast<std::size_t>(fieldMaskBytes(SpectatorFrame::FIELDS))
+				|| left - read < static_cast<std::size_t>(fieldDeltaSize(data + read, SpectatorFrame::FIELDS)))
+			{
+				return false;
+			}
+			read += applyFieldDelta(frame.field, SpectatorFrame::FIELDS, data + read);
+		}
+		else
+		{
+			LOG_WARNING("spectator stream has an unknown packet type %d", static_cast<int>(data[0]));
+			broken = true;
+			return false;
+		}
+		offset += read;
+
+		if (hasKeyframe)
+		{
+			t_frame = frame;
+			t_ticks = static_cast<int>(ticks);
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>
+/// draws a SpectatorFrame with the gameplay screen's assets and layout
+/// </summary>
+class SpectatorScreen
+{
+public:
+	SpectatorScreen();
+
+	void show(const SpectatorFrame& t_frame);
+	void update(); // once a tick, moves the animations on
+	void draw(sf::RenderWindow& t_window);
+
+private:
+	Player myPlayer;
+	Enemy myEnemy;
+	SpectatorFrame frame;
+	bool hasFrame;
+
+	sf::Font font;
+	sf::Text turnMessage;
+	sf::Text liveRoundsMessage;
+	sf::Text blankRoundsMessage;
+
+	sf::Texture gameplayTexture;
+	sf::Sprite gameplaySprite;
+	sf::Texture upperBarTexture;
+	sf::Sprite upperBarSprite;
+	sf::Texture tableTexture;
+	sf::Sprite tableSprite;
+	sf::Texture playerHealthBarTexture;
+	sf::Sprite playerHealthBarSprite;
+	sf::Texture enemyHealthBarTexture;
+	sf::Sprite enemyHealthBarSprite;
+	sf::Texture liveTaserTexture;
+	sf::Sprite liveTaserSprite;
+	sf::Texture emptyTaserTexture;
+	sf::Sprite emptyTaserSprite;
+	sf::Texture itemSheetTexture;
+	sf::Sprite itemSprite;
+};
+
+SpectatorScreen::SpectatorScreen() :
+	frame{},
+	hasFrame{ false }
+{
+	if (!font.loadFromFile("ASSETS\\FONTS\\ariblk.ttf"))
+	{
+		LOG_ERROR("problem loading arial black font");
+	}
+	sf::Text* messages[] = { &turnMessage, &liveRoundsMessage, &blankRoundsMessage };
+	for (sf::Text* message : messages)
+	{
+		message->setFont(font);
+		message->setCharacterSize(25U);
+		message->setStyle(sf::Text::Italic | sf::Text::Bold);
+		message->setFillColor(sf::Color::White);
+	}
+	turnMessage.setCharacterSize(30U);
+	turnMessage.setPosition(180.0f, 45.0f);
+	liveRoundsMessage.setPosition(470.0f, 15.0f);
+	blankRoundsMessage.setPosition(600.0f, 15.0f);
+
+	if (!loadTextureCached(gameplayTexture, "ASSETS\\IMAGES\\gameplay screen.png"))
+	{
+		LOG_ERROR("Failed to gameplay screen image!");
+	}
+	gameplaySprite.setTexture(gameplayTexture);
+
+	if (!loadTextureCached(upperBarTexture, "ASSETS\\IMAGES\\upperBar.png"))
+	{
+		LOG_ERROR("Failed to load upper bar image!");
+	}
+	upperBarSprite.setTexture(upperBarTexture);
+
+	if (!loadTextureCached(tableTexture, "ASSETS\\IMAGES\\table.png"))
+	{
+		LOG_ERROR("Failed to load table image!");
+	}
+	tableSprite.setTexture(tableTexture);
+	tableSprite.setPosition(0, 50);
+
+	if (!loadTextureCached(playerHealthBarTexture, "ASSETS\\IMAGES\\playerHealth.png"))
+	{
+		LOG_ERROR("Failed to load player health bar image!");
+	}
+	playerHealthBarSprite.setTexture(playerHealthBarTexture);
+	playerHealthBarSprite.setPosition(150, 250);
+	playerHealthBarSprite.setScale(-1, 1);
+
+	if (!loadTextureCached(enemyHealthBarTexture, "ASSETS\\IMAGES\\enemyHealth.png"))
+	{
+		LOG_ERROR("Failed to load enemy health bar image!");
+	}
+	enemyHealthBarSprite.setTexture(enemyHealthBarTexture);
+	enemyHealthBarSprite.setPosition(720, 250);
+	enemyHealthBarSprite.setScale(-1, 1);
+
+	if (!loadTextureCached(liveTaserTexture, "ASSETS\\IMAGES\\liveTaserCharge.png"))
+	{
+		LOG_ERROR("Failed to load live taser image!");
+	}
+	liveTaserSprite.setTexture(liveTaserTexture);
+	liveTaserSprite.setPosition(500, 0);
+
+	if (!loadTextureCached(emptyTaserTexture, "ASSETS\\IMAGES\\emptyTaserCharge.png"))
+	{
+		LOG_ERROR("Failed to load empty taser image!");
+	}
+	emptyTaserSprite.setTexture(emptyTaserTexture);
+	emptyTaserSprite.setPosition(630, 0);
+
+	if (!loadTextureCached(itemSheetTexture, "ASSETS\\IMAGES\\Item-Sheet.png"))
+	{
+		LOG_ERROR("Failed to load item sheet image!");
+	}
+	itemSprite.setTexture(itemSheetTexture);
+	itemSprite.setScale(0.5f, 0.5f);
+}
+
+void SpectatorScreen::show(const SpectatorFrame& t_frame)
+{
+	// a robot starts an animation when its counter moves, even if it's the same one as last time
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		int animation = t_frame.field[SpectatorFrame::ANIMATION + seat];
+		bool started = !hasFrame || t_frame.field[SpectatorFrame::ANIMATIONS_STARTED + seat] != frame.field[SpectatorFrame::ANIMATIONS_STARTED + seat];
+		if (started && animation != 0)
+		{
+			if (seat == PLAYER)
+			{
+				myPlayer.setAnimationPlaying(true, animation);
+			}
+			else
+			{
+				myEnemy.setAnimationPlaying(true, animation);
+			}
+		}
+	}
+	frame = t_frame;
+	hasFrame = true;
+}
+
+void SpectatorScreen::update()
+{
+	if (myPlayer.getAnimationPlaying())
+	{
+		myPlayer.playAnimation();
+	}
+	if (myEnemy.getAnimationPlaying())
+	{
+		myEnemy.playAnimation();
+	}
+}
+
+void SpectatorScreen::draw(sf::RenderWindow& t_window)
+{
+	const sf::IntRect playerBatteryRects[STARTING_HEALTH + 1] = { PLAYER_BATTERY_0_RECT, PLAYER_BATTERY_1_RECT, PLAYER_BATTERY_2_RECT,
+		PLAYER_BATTERY_3_RECT, PLAYER_BATTERY_4_RECT, PLAYER_BATTERY_5_RECT };
+	const sf::IntRect enemyBatteryRects[STARTING_HEALTH + 1] = { ENEMY_BATTERY_0_RECT, ENEMY_BATTERY_1_RECT, ENEMY_BATTERY_2_RECT,
+		ENEMY_BATTERY_3_RECT, ENEMY_BATTERY_4_RECT, ENEMY_BATTERY_5_RECT };
+	const sf::IntRect itemRects[RUBBISH_BIN + 1] = { NULL_RECT, OIL_DRINK_RECT, SCANNER_RECT, PAUSE_REMOTE_RECT, OVERCHARGER_RECT, RUBBISH_BIN_RECT };
+	const sf::Vector2f itemPositions[2][MAX_ITEMS] =
+	{
+		{ {292, 470}, {280, 505}, {217, 470}, {205, 505} },
+		{ {477, 470}, {494, 505}, {552, 470}, {567, 505} }
+	};
+
+	MatchState state;
+	frame.getView().toState(state);
+
+	t_window.draw(gameplaySprite);
+	t_window.draw(upperBarSprite);
+	t_window.draw(tableSprite);
+	playerHealthBarSprite.setTextureRect(playerBatteryRects[std::min(std::max(state.health[PLAYER], 0), STARTING_HEALTH)]);
+	enemyHealthBarSprite.setTextureRect(enemyBatteryRects[std::min(std::max(state.health[ENEMY], 0), STARTING_HEALTH)]);
+	t_window.draw(playerHealthBarSprite);
+	t_window.draw(enemyHealthBarSprite);
+	t_window.draw(myPlayer.getBody());
+	t_window.draw(myEnemy.getBody());
+	t_window.draw(liveTaserSprite);
+	t_window.draw(emptyTaserSprite);
+
+	if (!hasFrame)
+	{
+		turnMessage.setString("Waiting for the match");
+	}
+	else if (state.isOver())
+	{
+		turnMessage.setString(state.health[PLAYER] > 0 ? "Player Wins" : "Opponent Wins");
+	}
+	else
+	{
+		turnMessage.setString(state.turn == PLAYER ? "Player Turn" : "Opponent Turn");
+	}
+	liveRoundsMessage.setString(std::to_string(state.liveRounds));
+	blankRoundsMessage.setString(std::to_string(state.blankRounds));
+	t_window.draw(turnMessage);
+	t_window.draw(liveRoundsMessage);
+	t_window.draw(blankRoundsMessage);
+
+	for (int seat = PLAYER; seat <= ENEMY; seat++)
+	{
+		for (int slot = 0; slot < MAX_ITEMS; slot++)
+		{
+			int item = state.inventory[seat][slot];
+			if (item > 0 && item <= RUBBISH_BIN)
+			{
+				itemSprite.setTextureRect(itemRects[item]);
+				itemSprite.setPosition(itemPositions[seat][slot]);
+				t_window.draw(itemSprite);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// shared 60 tick loop for both spectator modes, t_pump is called once a tick to move the stream on
+/// </summary>
+template <typename Pump>
+static void runSpectatorWindow(const std::string& t_title, Pump t_pump)
+{
+	sf::RenderWindow window{ sf::VideoMode{ static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT), 32U }, t_title };
+	SpectatorScreen screen;
+	sf::Clock clock;
+	sf::Time timeSinceLastUpdate = sf::Time::Zero;
+	sf::Time timePerFrame = sf::seconds(1.0f / 60.0f);
+	while (window.isOpen())
+	{
+		sf::Event newEvent;
+		while (window.pollEvent(newEvent))
+		{
+			if (sf::Event::Closed == newEvent.type
+				|| (sf::Event::KeyPressed == newEvent.type && sf::Keyboard::Escape == newEvent.key.code))
+			{
+				window.close();
+			}
+		}
+		timeSinceLastUpdate += clock.restart();
+		while (timeSinceLastUpdate > timePerFrame)
+		{
+			timeSinceLastUpdate -= timePerFrame;
+			if (!t_pump(screen))
+			{
+				window.close();
+			}
+			screen.update();
+		}
+		window.clear(sf::Color::White);
+		screen.draw(window);
+		window.display();
+	}
+}
+
+void runSpectator(const std::string& t_address, unsigned short t_port)
+{
+	sf::TcpSocket socket;
+	if (socket.connect(sf::IpAddress(t_address), t_port, sf::seconds(5.0f)) != sf::Socket::Done)
+	{
+		std::cout << "problem connecting to the match at " << t_address << ":" << t_port << std::endl;
+		return;
+	}
+	socket.setBlocking(false);
+	SpectatorDecoder decoder;
+
+	// live, so every frame that has arrived is shown straight away
+	runSpectatorWindow("Versus Roulette - Spectating", [&](SpectatorScreen& t_screen)
+	{
+		char buffer[4096];
+		std::size_t received = 0;
+		sf::Socket::Status status;
+		while ((status = socket.receive(buffer, sizeof(buffer), received)) == sf::Socket::Done)
+		{
+			decoder.feed(buffer, received);
+		}
+		SpectatorFrame frame;
+		int ticks = 0;
+		while (decoder.next(frame, ticks))
+		{
+			t_screen.show(frame);
+		}
+		return status != sf::Socket::Disconnected && status != sf::Socket::Error && !decoder.isBroken();
+	});
+}
+
+void runSpectatorFile(const std::string& t_file)
+{
+	std::ifstream file(t_file, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "problem opening spectator recording " << t_file << std::endl;
+		return;
+	}
+	std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	SpectatorDecoder decoder;
+	decoder.feed(contents.data(), contents.size());
+
+	// recordings play back at the speed they were recorded, using the tick gap in each packet
+	SpectatorFrame pending;
+	int pendingTicks = 0;
+	bool hasPending = decoder.next(pending, pendingTicks);
+	runSpectatorWindow("Versus Roulette - Replay", [&](SpectatorScreen& t_screen)
+	{
+		while (hasPending && pendingTicks <= 0)
+		{
+			t_screen.show(pending);
+			hasPending = decoder.next(pending, pendingTicks);
+		}
+		pendingTicks--;
+		return true; // window stays on the last frame until it's closed
+	});
+}
@@ -0,0 +1,107 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Spectator stream. The game sends what the screen shows (the visible match plus which animation
+/// each robot is playing) as a packet only on ticks where something changed, and each packet
+/// carries only the changed bytes, so a turn costs a few bytes per viewer. Keyframes (every field)
+/// go to new viewers when they connect and into recordings every KEYFRAME_INTERVAL ticks.
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MatchServer.h"
+
+const unsigned short static DEFAULT_SPECTATOR_PORT = 53700;
+const int static KEYFRAME_INTERVAL = 300; // ticks between keyframes in a recording, 5 seconds
+const int static MAX_SPECTATOR_BACKLOG = 65536; // bytes a slow viewer can fall behind before it's dropped
+
+/// <summary>
+/// everything a spectator needs for one tick, one byte per field
+/// </summary>
+struct SpectatorFrame
+{
+	static const int ANIMATION = MatchView::FIELDS; // PLAYER, ENEMY, animation playing (0 for none)
+	static const int ANIMATIONS_STARTED = ANIMATION + 2; // PLAYER, ENEMY, wraps at 256
+	static const int FIELDS = ANIMATIONS_STARTED + 2;
+
+	MatchView getView() const;
+	void setView(const MatchView& t_view);
+
+	signed char field[FIELDS];
+};
+
+/// <summary>
+/// writes the stream to a file and/or any number of viewers on a TCP port
+/// </summary>
+class SpectatorBroadcaster
+{
+public:
+	SpectatorBroadcaster();
+	~SpectatorBroadcaster();
+
+	bool open(unsigned short t_port, const std::string& t_recordingFile); // port 0 or an empty file name skips that one
+	void close();
+	bool isOpen() const { return listening || recording.is_open(); }
+
+	void update(const SpectatorFrame& t_frame); // call once a tick
+
+	int getSpectatorCount() const { return static_cast<int>(viewers.size()); }
+
+private:
+	struct Viewer
+	{
+		sf::TcpSocket socket;
+		std::string outgoing;
+	};
+
+	void acceptViewers();
+	void flushViewers();
+	std::string makePacket(bool t_keyframe, const SpectatorFrame& t_frame) const;
+
+	sf::TcpListener listener;
+	bool listening;
+	std::vector<std::unique_ptr<Viewer>> viewers;
+	std::ofstream recording;
+
+	SpectatorFrame last;
+	bool hasLast;
+	int ticksSinceLast; // goes in each packet so a recording plays back at the right speed
+	int ticksSinceKeyframe;
+
+	long long packets;
+	long long deltaBytes; // payload bytes of the delta packets, for the summary
+	long long deltaPackets;
+};
+
+/// <summary>
+/// turns stream bytes back into frames, feed it bytes and pull frames out as they complete
+/// </summary>
+class SpectatorDecoder
+{
+public:
+	SpectatorDecoder();
+
+	void feed(const char* t_data, std::size_t t_size);
+	// false when no whole packet is waiting, t_ticks is how long after the previous frame this one is
+	bool next(SpectatorFrame& t_frame, int& t_ticks);
+	bool isBroken() const { return broken; }
+
+private:
+	std::string buffer;
+	std::size_t offset;
+	bool hasHeader;
+	bool hasKeyframe; // deltas before the first keyframe have nothing to apply to
+	bool broken;
+	SpectatorFrame frame;
+};
+
+/// <summary>
+/// entry points for "--spectate [address] [port]" and "--spectate-file [file]",
+/// open a window that draws the stream with the game's own assets
+/// </summary>
+void runSpectator(const std::string& t_address, unsigned short t_port);
+void runSpectatorFile(const std::string& t_file);
@@ -0,0 +1,51 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Fixed size lock-free queue for exactly one producer thread and one consumer thread.
+/// push never blocks or allocates, it fails when the queue is full.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template <typename T, int SIZE>
+class SpscQueue
+{
+	static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SpscQueue size must be a power of 2");
+
+public:
+	// producer only
+	bool push(const T& t_item)
+	{
+		std::uint32_t tail = queueTail.load(std::memory_order_relaxed);
+		if (tail - queueHead.load(std::memory_order_acquire) >= static_cast<std::uint32_t>(SIZE))
+		{
+			return false;
+		}
+		items[tail & (SIZE - 1)] = t_item;
+		queueTail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer only
+	bool pop(T& t_item)
+	{
+		std::uint32_t head = queueHead.load(std::memory_order_relaxed);
+		if (head == queueTail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		t_item = items[head & (SIZE - 1)];
+		queueHead.store(head + 1, std::memory_order_release); // frees the slot for the producer straight away
+		return true;
+	}
+
+	bool isEmpty() const { return queueHead.load(std::memory_order_acquire) == queueTail.load(std::memory_order_acquire); }
+
+private:
+	std::array<T, SIZE> items{};
+	std::atomic<std::uint32_t> queueHead{ 0 }; // written by the consumer
+	std::atomic<std::uint32_t> queueTail{ 0 }; // written by the producer
+};
@@ -0,0 +1,356 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "TextureCache.h"
+#include "Logger.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const std::uint32_t static RAW_TEXTURE_MAGIC = 0x43545256; // "VRTC"
+const std::uint32_t static RAW_TEXTURE_VERSION = 1;
+
+/// <summary>
+/// start of a .rgba file, width * height * 4 bytes of pixels follow
+/// </summary>
+struct RawTextureHeader
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t sourceHash; // of the PNG the pixels came from
+	std::uint32_t width;
+	std::uint32_t height;
+};
+
+/// <summary>
+/// read only view of a whole file, unmapped when it goes out of scope
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile() {}
+	~MappedFile() { close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const std::string& t_file)
+	{
+		close();
+#ifdef _WIN32
+		file = CreateFileA(t_file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			close();
+			return false;
+		}
+		bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+		int descriptor = ::open(t_file.c_str(), O_RDONLY);
+		if (descriptor < 0)
+		{
+			return false;
+		}
+		struct stat status;
+		if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+		{
+			::close(descriptor);
+			return false;
+		}
+		void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+		::close(descriptor); // the mapping keeps the file
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+		bytes = static_cast<const unsigned char*>(view);
+		size = static_cast<std::size_t>(status.st_size);
+#endif
+		return bytes != nullptr;
+	}
+
+	void close()
+	{
+#ifdef _WIN32
+		if (bytes != nullptr)
+		{
+			UnmapViewOfFile(bytes);
+		}
+		if (mapping != nullptr)
+		{
+			CloseHandle(mapping);
+		}
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+		}
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (bytes != nullptr)
+		{
+			munmap(const_cast<unsigned char*>(bytes), size);
+		}
+#endif
+		bytes = nullptr;
+		size = 0;
+	}
+
+	const unsigned char* data() const { return bytes; }
+	std::size_t getSize() const { return size; }
+
+private:
+	const unsigned char* bytes = nullptr;
+	std::size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+};
+
+/// <summary>
+/// loads since the last printTextureCacheStats
+/// </summary>
+struct TextureCacheStats
+{
+	int cached = 0;
+	int decoded = 0;
+	double cachedMs = 0.0;
+	double decodedMs = 0.0;
+};
+static TextureCacheStats cacheStats;
+
+static double millisecondsSince(std::chrono::steady_clock::time_point t_start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+}
+
+static bool readWholeFile(const std::string& t_file, std::vector<char>& t_bytes)
+{
+	std::ifstream file(t_file, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+	std::streamsize size = file.tellg();
+	file.seekg(0);
+	t_bytes.resize(static_cast<std::size_t>(size));
+	return size > 0 && file.read(t_bytes.data(), size);
+}
+
+/// <summary>
+/// FNV-1a 64, same as MatchState::checksum
+/// </summary>
+static std::uint64_t hashBytes(const char* t_bytes, std::size_t t_size)
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < t_size; i++)
+	{
+		hash ^= static_cast<unsigned char>(t_bytes[i]);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/// <summary>
+/// maps t_cacheFile and returns its pixels if it was made from a PNG with t_sourceHash, otherwise nullptr
+/// </summary>
+static const unsigned char* mapCachedPixels(MappedFile& t_mapped, const std::string& t_cacheFile, std::uint64_t t_sourceHash,
+	unsigned& t_width, unsigned& t_height)
+{
+	if (!t_mapped.open(t_cacheFile) || t_mapped.getSize() < sizeof(RawTextureHeader))
+	{
+		return nullptr;
+	}
+	RawTextureHeader header;
+	std::memcpy(&header, t_mapped.data(), sizeof(header));
+	std::uint64_t pixelBytes = static_cast<std::uint64_t>(header.width) * header.height * 4;
+	if (header.magic != RAW_TEXTURE_MAGIC || header.version != RAW_TEXTURE_VERSION || header.sourceHash != t_sourceHash
+		|| header.width == 0 || header.height == 0 || t_mapped.getSize() != sizeof(header) + pixelBytes)
+	{
+		return nullptr;
+	}
+	t_width = header.width;
+	t_height = header.height;
+	return t_mapped.data() + sizeof(header);
+}
+
+/// <summary>
+/// writes to a temporary file first so a half written cache is never picked up
+/// </summary>
+static bool writeCache(const std::string& t_cacheFile, std::uint64_t t_sourceHash, const sf::Image& t_image)
+{
+	RawTextureHeader header;
+	header.magic = RAW_TEXTURE_MAGIC;
+	header.version = RAW_TEXTURE_VERSION;
+	header.sourceHash = t_sourceHash;
+	header.width = t_image.getSize().x;
+	header.height = t_image.getSize().y;
+
+	std::string temporary = t_cacheFile + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return false; // read only install, just decode every time
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(t_image.getPixelsPtr()), static_cast<std::streamsize>(header.width) * header.height * 4);
+		if (!file)
+		{
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporary, t_cacheFile, error);
+	if (error)
+	{
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
+bool loadTextureCached(sf::Texture& t_texture, const std::string& t_file)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<char> source;
+	if (!readWholeFile(t_file, source))
+	{
+		LOG_ERROR("Failed to load image %s", t_file.c_str());
+		return false;
+	}
+	std::uint64_t sourceHash = hashBytes(source.data(), source.size());
+	std::string cacheFile = t_file + ".rgba";
+
+	MappedFile mapped;
+	unsigned width = 0;
+	unsigned height = 0;
+	const unsigned char* pixels = mapCachedPixels(mapped, cacheFile, sourceHash, width, height);
+	if (pixels != nullptr && t_texture.create(width, height))
+	{
+		t_texture.update(pixels);
+		cacheStats.cached++;
+		cacheStats.cachedMs += millisecondsSince(start);
+		return true;
+	}
+
+	sf::Image image;
+	if (!image.loadFromMemory(source.data(), source.size()))
+	{
+		LOG_ERROR("Failed to decode image %s", t_file.c_str());
+		return false;
+	}
+	mapped.close(); // Windows won't replace a file that's still mapped
+	writeCache(cacheFile, sourceHash, image);
+	bool loaded = t_texture.loadFromImage(image);
+	cacheStats.decoded++;
+	cacheStats.decodedMs += millisecondsSince(start);
+	return loaded;
+}
+
+void printTextureCacheStats(const std::string& t_label)
+{
+	std::cout << t_label << ": " << cacheStats.cached << " textures from cache in " << cacheStats.cachedMs << "ms, "
+		<< cacheStats.decoded << " decoded in " << cacheStats.decodedMs << "ms" << std::endl;
+	cacheStats = TextureCacheStats();
+}
+
+/// <summary>
+/// cold is read + decode the PNG, warm is read + hash the PNG and map the cache, each pixel is copied
+/// once in both to stand in for the upload. the caches are written on the way if they're missing or stale
+/// </summary>
+void runTextureCacheBenchmark(const std::string& t_directory)
+{
+	std::vector<std::string> files;
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(t_directory, error))
+	{
+		if (entry.path().extension() == ".png")
+		{
+			files.push_back(entry.path().string());
+		}
+	}
+	if (files.empty())
+	{
+		std::cout << "no PNG files in " << t_directory << std::endl;
+		return;
+	}
+
+	std::vector<unsigned char> upload;
+	double coldMs = 0.0;
+	double warmMs = 0.0;
+	std::uint64_t pixelBytes = 0;
+	for (const std::string& file : files)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::vector<char> source;
+		sf::Image image;
+		if (!readWholeFile(file, source) || !image.loadFromMemory(source.data(), source.size()))
+		{
+			std::cout << "can't decode " << file << std::endl;
+			continue;
+		}
+		std::size_t bytes = static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4;
+		upload.assign(image.getPixelsPtr(), image.getPixelsPtr() + bytes);
+		coldMs += millisecondsSince(start);
+		pixelBytes += bytes;
+
+		std::uint64_t sourceHash = hashBytes(source.data(), source.size());
+		MappedFile check;
+		unsigned width = 0;
+		unsigned height = 0;
+		if (mapCachedPixels(check, file + ".rgba", sourceHash, width, height) == nullptr)
+		{
+			check.close();
+			writeCache(file + ".rgba", sourceHash, image);
+		}
+
+		start = std::chrono::steady_clock::now();
+		std::vector<char> warmSource;
+		MappedFile mapped;
+		const unsigned char* pixels = nullptr;
+		if (readWholeFile(file, warmSource))
+		{
+			pixels = mapCachedPixels(mapped, file + ".rgba", hashBytes(warmSource.data(), warmSource.size()), width, height);
+		}
+		if (pixels == nullptr)
+		{
+			std::cout << "no usable cache for " << file << std::endl;
+			continue;
+		}
+		upload.assign(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+		warmMs += millisecondsSince(start);
+	}
+
+	std::cout << files.size() << " textures, " << pixelBytes / (1024 * 1024) << "MB of pixels: cold (decode) " << coldMs
+		<< "ms, warm (mapped cache) " << warmMs << "ms, " << (warmMs > 0.0 ? coldMs / warmMs : 0.0) << "x faster" << std::endl;
+}
@@ -0,0 +1,21 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Decoded texture cache. The first time a PNG is loaded its RGBA pixels are written next to it
+/// as "<file>.rgba" along with a hash of the PNG. Later loads check the hash, map the file and
+/// upload the pixels straight away, so there's no PNG decode. If the PNG changes the hash won't
+/// match and the cache file is rebuilt.
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// drop-in for sf::Texture::loadFromFile
+bool loadTextureCached(sf::Texture& t_texture, const std::string& t_file);
+
+// how many textures came from the cache and how many were decoded since the last call, and how long each took
+void printTextureCacheStats(const std::string& t_label);
+
+// times decoding every PNG in t_directory against mapping its cache file (no GPU needed)
+void runTextureCacheBenchmark(const std::string& t_directory);
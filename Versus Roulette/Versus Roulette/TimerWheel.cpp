@@ -0,0 +1,202 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel() :
+	now{ 0 },
+	pendingCount{ 0 },
+	timeScale{ 1.0 },
+	accumulator{ 0.0 },
+	paused{ false }
+{
+	for (int level = 0; level < LEVELS; level++)
+	{
+		for (int slot = 0; slot < SLOTS; slot++)
+		{
+			heads[level][slot] = NONE;
+		}
+	}
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::uint32_t t_ticks, std::function<void()> t_callback)
+{
+	int index;
+	if (!freeTimers.empty())
+	{
+		index = freeTimers.back();
+		freeTimers.pop_back();
+	}
+	else
+	{
+		index = static_cast<int>(timers.size());
+		timers.push_back(Timer{});
+	}
+
+	Timer& timer = timers[index];
+	timer.due = now + (t_ticks == 0 ? 1 : t_ticks);
+	timer.callback = std::move(t_callback);
+	timer.generation++;
+	timer.active = true;
+	insert(index);
+	pendingCount++;
+	return (static_cast<TimerId>(timer.generation) << 32) | static_cast<TimerId>(index + 1);
+}
+
+bool TimerWheel::cancel(TimerId t_timer)
+{
+	int index = findTimer(t_timer);
+	if (index == NONE)
+	{
+		return false;
+	}
+	unlink(index);
+	release(index);
+	return true;
+}
+
+void TimerWheel::cancelAll()
+{
+	for (int index = 0; index < static_cast<int>(timers.size()); index++)
+	{
+		if (timers[index].active)
+		{
+			unlink(index);
+			release(index);
+		}
+	}
+}
+
+bool TimerWheel::isPending(TimerId t_timer) const
+{
+	return findTimer(t_timer) != NONE;
+}
+
+void TimerWheel::advance(std::uint32_t t_ticks)
+{
+	for (std::uint32_t count = 0; count < t_ticks; count++)
+	{
+		tick();
+	}
+}
+
+void TimerWheel::update()
+{
+	if (paused)
+	{
+		return;
+	}
+	accumulator += timeScale;
+	while (accumulator >= 1.0)
+	{
+		accumulator -= 1.0;
+		tick();
+	}
+}
+
+/// <summary>
+/// moves time on one tick: pulls the next slot of each higher level down when the level below wraps,
+/// then fires everything in the level 0 slot for this tick
+/// </summary>
+void TimerWheel::tick()
+{
+	now++;
+	for (int level = 1; level < LEVELS; level++)
+	{
+		if (((now >> (SLOT_BITS * (level - 1))) & (SLOTS - 1)) != 0)
+		{
+			break; // the level below hasn't wrapped, so nothing further up is due to come down
+		}
+		int slot = static_cast<int>((now >> (SLOT_BITS * level)) & (SLOTS - 1));
+		while (heads[level][slot] != NONE)
+		{
+			int index = heads[level][slot];
+			unlink(index);
+			insert(index);
+		}
+	}
+
+	// callbacks can schedule (always into a later slot) or cancel other timers, so take one at a time
+	int slot = static_cast<int>(now & (SLOTS - 1));
+	while (heads[0][slot] != NONE)
+	{
+		int index = heads[0][slot];
+		unlink(index);
+		std::function<void()> callback = std::move(timers[index].callback);
+		release(index);
+		callback();
+	}
+}
+
+void TimerWheel::insert(int t_index)
+{
+	Timer& timer = timers[t_index];
+	std::uint64_t delta = timer.due > now ? timer.due - now : 0;
+
+	int level = 0;
+	while (level < LEVELS - 1 && delta >= (static_cast<std::uint64_t>(1) << (SLOT_BITS * (level + 1))))
+	{
+		level++;
+	}
+	std::uint64_t due = timer.due;
+	std::uint64_t furthest = now + (static_cast<std::uint64_t>(1) << (SLOT_BITS * LEVELS)) - 1;
+	if (due > furthest)
+	{
+		due = furthest; // beyond the wheel, parks in the last slot and is re-placed when it comes down
+	}
+
+	timer.level = level;
+	timer.slot = static_cast<int>((due >> (SLOT_BITS * level)) & (SLOTS - 1));
+	timer.previous = NONE;
+	timer.next = heads[level][timer.slot];
+	if (timer.next != NONE)
+	{
+		timers[timer.next].previous = t_index;
+	}
+	heads[level][timer.slot] = t_index;
+}
+
+void TimerWheel::unlink(int t_index)
+{
+	Timer& timer = timers[t_index];
+	if (timer.previous != NONE)
+	{
+		timers[timer.previous].next = timer.next;
+	}
+	else
+	{
+		heads[timer.level][timer.slot] = timer.next;
+	}
+	if (timer.next != NONE)
+	{
+		timers[timer.next].previous = timer.previous;
+	}
+	timer.next = NONE;
+	timer.previous = NONE;
+}
+
+void TimerWheel::release(int t_index)
+{
+	timers[t_index].active = false;
+	timers[t_index].callback = nullptr;
+	freeTimers.push_back(t_index);
+	pendingCount--;
+}
+
+int TimerWheel::findTimer(TimerId t_timer) const
+{
+	std::uint64_t slot = t_timer & 0xFFFFFFFFu;
+	if (slot == 0 || slot > timers.size())
+	{
+		return NONE;
+	}
+	int index = static_cast<int>(slot - 1);
+	const Timer& timer = timers[index];
+	if (!timer.active || timer.generation != static_cast<std::uint32_t>(t_timer >> 32))
+	{
+		return NONE;
+	}
+	return index;
+}
@@ -0,0 +1,73 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Hierarchical timing wheel. Timers are kept in slots by how far off they are (4 levels of 256 ticks),
+/// so scheduling and cancelling are O(1) and a tick only touches the slot that is due, no matter how
+/// many timers are waiting. Far off timers drop down a level each time their slot comes round.
+/// Also the one place game time is scaled, paused or fast-forwarded.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class TimerWheel
+{
+public:
+	typedef std::uint64_t TimerId;
+	static const TimerId NO_TIMER = 0; // never handed out, safe to cancel
+
+	TimerWheel();
+
+	// calls t_callback t_ticks ticks from now (at least 1, callbacks never run inside schedule)
+	TimerId schedule(std::uint32_t t_ticks, std::function<void()> t_callback);
+	bool cancel(TimerId t_timer); // false if it already fired or was cancelled
+	void cancelAll();
+	bool isPending(TimerId t_timer) const;
+
+	void advance(std::uint32_t t_ticks = 1); // runs t_ticks ticks now, ignores pause and scale (fast-forward)
+	void update(); // once a game tick: advances by the time scale unless paused
+
+	void setTimeScale(double t_scale) { timeScale = t_scale < 0.0 ? 0.0 : t_scale; }
+	double getTimeScale() const { return timeScale; }
+	void setPaused(bool t_paused) { paused = t_paused; }
+	bool isPaused() const { return paused; }
+
+	std::uint64_t getNow() const { return now; }
+	int getPendingCount() const { return pendingCount; }
+
+private:
+	static const int LEVELS = 4;
+	static const int SLOT_BITS = 8;
+	static const int SLOTS = 1 << SLOT_BITS;
+	static const int NONE = -1;
+
+	struct Timer
+	{
+		std::uint64_t due;
+		std::function<void()> callback;
+		std::uint32_t generation; // bumped on reuse so an old TimerId can't cancel someone else's timer
+		int next;
+		int previous;
+		int level;
+		int slot;
+		bool active;
+	};
+
+	void tick();
+	void insert(int t_index);
+	void unlink(int t_index);
+	void release(int t_index);
+	int findTimer(TimerId t_timer) const;
+
+	std::vector<Timer> timers;
+	std::vector<int> freeTimers;
+	int heads[LEVELS][SLOTS]; // first timer in each slot, NONE when empty
+
+	std::uint64_t now;
+	int pendingCount;
+	double timeScale;
+	double accumulator; // part ticks from a time scale that isn't a whole number
+	bool paused;
+};
@@ -0,0 +1,371 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Tournament.h"
+#include "Simulator.h"
+#include "SearchPolicy.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+const long long static TOURNAMENT_BLOCK_GAMES = 256; // games per checkpointed block
+const std::uint32_t static CHECKPOINT_VERSION = 1;
+
+std::vector<TournamentEntrant> defaultEntrants(std::uint64_t t_seed)
+{
+	std::vector<TournamentEntrant> entrants;
+	entrants.push_back({ "heuristic", []() { return AnyPolicy(HeuristicPolicy()); } });
+
+	HeuristicParameters careful;
+	careful.selfShotMargin = 1; // only shoots itself when blanks are ahead
+	HeuristicParameters binHappy;
+	binHappy.rubbishBinMargin = 0;
+	binHappy.overchargeOnOdds = true;
+	HeuristicParameters variant;
+	entrants.push_back({ "heuristic-items", [variant]() { return AnyPolicy(HeuristicVariantPolicy(variant, "heuristic-items")); } });
+	entrants.push_back({ "heuristic-careful", [careful]() { return AnyPolicy(HeuristicVariantPolicy(careful, "heuristic-careful")); } });
+	entrants.push_back({ "heuristic-aggressive", [binHappy]() { return AnyPolicy(HeuristicVariantPolicy(binHappy, "heuristic-aggressive")); } });
+
+	entrants.push_back({ "random", [t_seed]() { return AnyPolicy(RandomPolicy(t_seed)); } });
+	entrants.push_back({ "search-1", []() { return AnyPolicy(SearchPolicy(1, "search-1")); } });
+	entrants.push_back({ "search-3", []() { return AnyPolicy(SearchPolicy(3, "search-3")); } });
+	entrants.push_back({ "solver", []() { return AnyPolicy(solverPolicy()); } });
+	return entrants;
+}
+
+/// <summary>
+/// minorisation-maximisation fit of Bradley-Terry strengths (Hunter 2004), draws count half a win each.
+/// every pairing that was played gets one extra drawn game so an entrant that never wins still has a rating.
+/// the intervals come from the Fisher information of each rating on its own
+/// </summary>
+std::vector<EntrantRating> fitRatings(const std::vector<PairingScore>& t_scores, int t_entrants)
+{
+	std::vector<double> played(t_entrants * t_entrants, 0.0);
+	std::vector<double> scored(t_entrants, 0.0);
+	for (int first = 0; first < t_entrants; first++)
+	{
+		for (int second = first + 1; second < t_entrants; second++)
+		{
+			const PairingScore& score = t_scores[first * t_entrants + second];
+			if (score.games() == 0)
+			{
+				continue;
+			}
+			double games = static_cast<double>(score.games()) + 1.0;
+			played[first * t_entrants + second] = games;
+			played[second * t_entrants + first] = games;
+			scored[first] += score.wins + 0.5 * score.draws + 0.5;
+			scored[second] += score.losses + 0.5 * score.draws + 0.5;
+		}
+	}
+
+	std::vector<double> strength(t_entrants, 1.0);
+	for (int iteration = 0; iteration < 10000; iteration++)
+	{
+		double largestChange = 0.0;
+		for (int entrant = 0; entrant < t_entrants; entrant++)
+		{
+			double denominator = 0.0;
+			for (int other = 0; other < t_entrants; other++)
+			{
+				if (other != entrant)
+				{
+					denominator += played[entrant * t_entrants + other] / (strength[entrant] + strength[other]);
+				}
+			}
+			if (denominator > 0.0)
+			{
+				double updated = scored[entrant] / denominator;
+				largestChange = std::max(largestChange, std::fabs(std::log(updated / strength[entrant])));
+				strength[entrant] = updated;
+			}
+		}
+		double logMean = 0.0;
+		for (double value : strength)
+		{
+			logMean += std::log(value);
+		}
+		logMean /= t_entrants;
+		for (double& value : strength)
+		{
+			value /= std::exp(logMean);
+		}
+		if (largestChange < 1e-9)
+		{
+			break;
+		}
+	}
+
+	const double eloPerNat = 400.0 / std::log(10.0);
+	std::vector<EntrantRating> ratings(t_entrants);
+	for (int entrant = 0; entrant < t_entrants; entrant++)
+	{
+		double information = 0.0;
+		for (int other = 0; other < t_entrants; other++)
+		{
+			if (other != entrant)
+			{
+				double expected = strength[entrant] / (strength[entrant] + strength[other]);
+				information += played[entrant * t_entrants + other] * expected * (1.0 - expected);
+			}
+		}
+		ratings[entrant].elo = eloPerNat * std::log(strength[entrant]);
+		ratings[entrant].interval = information > 0.0 ? 1.96 * eloPerNat / std::sqrt(information) : 0.0;
+	}
+	return ratings;
+}
+
+/// <summary>
+/// the header line and entrant names, a checkpoint only resumes the same tournament
+/// </summary>
+static std::string checkpointHeader(const std::vector<TournamentEntrant>& t_entrants, long long t_gamesPerSeat, std::uint64_t t_seed)
+{
+	std::ostringstream header;
+	header << "VRTOURNAMENT " << CHECKPOINT_VERSION << " " << t_seed << " " << t_gamesPerSeat << " " << TOURNAMENT_BLOCK_GAMES
+		<< " " << t_entrants.size() << "\n";
+	for (const TournamentEntrant& entrant : t_entrants)
+	{
+		header << entrant.name << "\n";
+	}
+	return header.str();
+}
+
+/// <summary>
+/// reads the finished blocks back, false if the file is for a different tournament.
+/// t_keepBytes is where the last complete line ends: a line cut short by a crash is dropped and
+/// that block played again, and so is a header cut short, which leaves nothing worth keeping
+/// </summary>
+static bool loadCheckpoint(const std::string& t_path, const std::string& t_header, std::vector<PairingScore>& t_blocks, std::vector<char>& t_done,
+	std::size_t& t_keepBytes)
+{
+	std::ifstream file(t_path, std::ios::binary);
+	std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	t_keepBytes = 0;
+	if (contents.size() < t_header.size())
+	{
+		return t_header.compare(0, contents.size(), contents) == 0;
+	}
+	if (contents.compare(0, t_header.size(), t_header) != 0)
+	{
+		return false;
+	}
+	t_keepBytes = t_header.size();
+	std::size_t lineEnd;
+	while ((lineEnd = contents.find('\n', t_keepBytes)) != std::string::npos)
+	{
+		std::istringstream fields(contents.substr(t_keepBytes, lineEnd - t_keepBytes));
+		t_keepBytes = lineEnd + 1;
+		std::string tag;
+		long long block = -1;
+		PairingScore score;
+		if (fields >> tag >> block >> score.wins >> score.draws >> score.losses && tag == "block"
+			&& block >= 0 && block < static_cast<long long>(t_blocks.size()))
+		{
+			t_blocks[block] = score;
+			t_done[block] = 1;
+		}
+	}
+	return true;
+}
+
+void runTournament(const std::vector<TournamentEntrant>& t_entrants, long long t_gamesPerSeat, std::uint64_t t_seed,
+	const std::string& t_checkpointFile, int t_threads)
+{
+	const int entrantCount = static_cast<int>(t_entrants.size());
+	if (entrantCount < 2 || t_gamesPerSeat <= 0)
+	{
+		return;
+	}
+	int threadCount = t_threads > 0 ? t_threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+	// block = (pairing, seat order, slice of games)
+	std::vector<std::pair<int, int>> pairings;
+	for (int first = 0; first < entrantCount; first++)
+	{
+		for (int second = first + 1; second < entrantCount; second++)
+		{
+			pairings.push_back({ first, second });
+		}
+	}
+	const long long blocksPerSeat = (t_gamesPerSeat + TOURNAMENT_BLOCK_GAMES - 1) / TOURNAMENT_BLOCK_GAMES;
+	const long long blockCount = static_cast<long long>(pairings.size()) * 2 * blocksPerSeat;
+	std::vector<PairingScore> blockScores(blockCount);
+	std::vector<char> done(blockCount, 0);
+
+	std::string header = checkpointHeader(t_entrants, t_gamesPerSeat, t_seed);
+	std::FILE* checkpoint = nullptr;
+	if (!t_checkpointFile.empty())
+	{
+		std::size_t keepBytes = 0;
+		std::error_code error;
+		if (std::filesystem::exists(t_checkpointFile, error))
+		{
+			if (!loadCheckpoint(t_checkpointFile, header, blockScores, done, keepBytes))
+			{
+				std::cout << t_checkpointFile << " is from a different tournament, delete it or pick another file" << std::endl;
+				return;
+			}
+			std::filesystem::resize_file(t_checkpointFile, keepBytes, error); // appending after a cut short line would spoil the next one
+			if (error)
+			{
+				std::cout << "can't trim checkpoint " << t_checkpointFile << std::endl;
+				return;
+			}
+		}
+		bool resuming = keepBytes > 0;
+		checkpoint = std::fopen(t_checkpointFile.c_str(), "a");
+		if (checkpoint == nullptr)
+		{
+			std::cout << "can't write checkpoint " << t_checkpointFile << std::endl;
+			return;
+		}
+		if (!resuming)
+		{
+			std::fputs(header.c_str(), checkpoint);
+			std::fflush(checkpoint);
+		}
+	}
+
+	std::vector<long long> pending;
+	for (long long block = 0; block < blockCount; block++)
+	{
+		if (!done[block])
+		{
+			pending.push_back(block);
+		}
+	}
+	if (pending.size() < static_cast<std::size_t>(blockCount))
+	{
+		std::cout << "resuming, " << blockCount - static_cast<long long>(pending.size()) << " of " << blockCount << " blocks already played" << std::endl;
+	}
+
+	std::atomic<std::size_t> nextPending{ 0 };
+	std::mutex resultLock;
+	long long gamesPlayed = 0;
+	std::size_t blocksFinished = 0;
+	auto start = std::chrono::steady_clock::now();
+	auto lastReport = start;
+
+	auto worker = [&]()
+	{
+		MatchState state;
+		NullMatchObserver observer;
+		for (std::size_t next = nextPending++; next < pending.size(); next = nextPending++)
+		{
+			long long block = pending[next];
+			const std::pair<int, int>& pairing = pairings[block / (2 * blocksPerSeat)];
+			bool firstIsPlayer = (block / blocksPerSeat) % 2 == 0;
+			long long slice = block % blocksPerSeat;
+			AnyPolicy first = t_entrants[pairing.first].make();
+			AnyPolicy second = t_entrants[pairing.second].make();
+
+			PairingScore score;
+			long long lastGame = std::min((slice + 1) * TOURNAMENT_BLOCK_GAMES, t_gamesPerSeat);
+			for (long long game = slice * TOURNAMENT_BLOCK_GAMES; game < lastGame; game++)
+			{
+				// the same deal for every pairing and both seat orders
+				FastRandom random(t_seed ^ (static_cast<std::uint64_t>(game) * 0xD1B54A32D192ED03ULL));
+				int winner = firstIsPlayer ? playMatch(state, first, second, random, DEFAULT_RULES, observer)
+					: playMatch(state, second, first, random, DEFAULT_RULES, observer);
+				if (winner == NO_WINNER)
+				{
+					score.draws++;
+				}
+				else if ((winner == PLAYER) == firstIsPlayer)
+				{
+					score.wins++;
+				}
+				else
+				{
+					score.losses++;
+				}
+			}
+
+			std::lock_guard<std::mutex> locked(resultLock);
+			blockScores[block] = score;
+			gamesPlayed += score.games();
+			blocksFinished++;
+			if (checkpoint != nullptr)
+			{
+				std::fprintf(checkpoint, "block %lld %lld %lld %lld\n", block, score.wins, score.draws, score.losses);
+				std::fflush(checkpoint);
+			}
+			auto now = std::chrono::steady_clock::now();
+			if (now - lastReport > std::chrono::seconds(10))
+			{
+				lastReport = now;
+				double seconds = std::chrono::duration<double>(now - start).count();
+				std::cout << blocksFinished << " / " << pending.size() << " blocks, " << static_cast<long long>(gamesPlayed / seconds) << " games/s" << std::endl;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int thread = 1; thread < threadCount; thread++)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (checkpoint != nullptr)
+	{
+		std::fclose(checkpoint);
+	}
+
+	std::vector<PairingScore> scores(entrantCount * entrantCount);
+	for (long long block = 0; block < blockCount; block++)
+	{
+		const std::pair<int, int>& pairing = pairings[block / (2 * blocksPerSeat)];
+		PairingScore& total = scores[pairing.first * entrantCount + pairing.second];
+		total.wins += blockScores[block].wins;
+		total.draws += blockScores[block].draws;
+		total.losses += blockScores[block].losses;
+	}
+	std::vector<EntrantRating> ratings = fitRatings(scores, entrantCount);
+
+	std::vector<int> order(entrantCount);
+	for (int entrant = 0; entrant < entrantCount; entrant++)
+	{
+		order[entrant] = entrant;
+	}
+	std::sort(order.begin(), order.end(), [&ratings](int t_first, int t_second) { return ratings[t_first].elo > ratings[t_second].elo; });
+
+	std::cout << std::fixed << std::setprecision(0);
+	for (int entrant : order)
+	{
+		double points = 0.0;
+		long long games = 0;
+		for (int other = 0; other < entrantCount; other++)
+		{
+			if (other == entrant)
+			{
+				continue;
+			}
+			const PairingScore& score = scores[std::min(entrant, other) * entrantCount + std::max(entrant, other)];
+			points += (entrant < other ? score.wins : score.losses) + 0.5 * score.draws;
+			games += score.games();
+		}
+		std::cout << std::setw(22) << std::left << t_entrants[entrant].name << std::right << std::setw(6) << ratings[entrant].elo
+			<< " +-" << std::setw(4) << ratings[entrant].interval << std::setprecision(1) << std::setw(8)
+			<< (games ? 100.0 * points / games : 0.0) << "% of " << games << std::setprecision(0) << std::endl;
+	}
+	std::cout << std::defaultfloat << std::setprecision(6);
+	std::cout << gamesPlayed << " games in " << seconds << "s on " << threadCount << " threads, "
+		<< static_cast<long long>(gamesPlayed / std::max(seconds, 1e-9)) << " games/s, "
+		<< static_cast<long long>(gamesPlayed / std::max(seconds, 1e-9) / threadCount) << " games/s/core" << std::endl;
+}
@@ -0,0 +1,55 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Round robin tournament between policies. Every pairing plays the same seeded deals from both
+/// seats, spread over every core in blocks. Finished blocks are appended to a checkpoint file as they
+/// complete, so a long tournament that's stopped picks up where it left off when run again.
+/// Ratings are a Bradley-Terry (Elo scale) fit over all the results with 95% intervals.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Policy.h"
+
+struct TournamentEntrant
+{
+	std::string name;
+	std::function<AnyPolicy()> make; // a fresh policy for each block, some keep state
+};
+
+/// <summary>
+/// heuristic, its variants, random, the lookahead bots and the round solver
+/// </summary>
+std::vector<TournamentEntrant> defaultEntrants(std::uint64_t t_seed);
+
+/// <summary>
+/// wins, draws and losses of the first entrant of a pairing
+/// </summary>
+struct PairingScore
+{
+	long long wins = 0;
+	long long draws = 0;
+	long long losses = 0;
+
+	long long games() const { return wins + draws + losses; }
+};
+
+struct EntrantRating
+{
+	double elo; // 0 is the average entrant
+	double interval; // +- for 95%
+};
+
+/// <summary>
+/// fits ratings to the pairwise scores, t_scores[first * count + second] for first < second
+/// </summary>
+std::vector<EntrantRating> fitRatings(const std::vector<PairingScore>& t_scores, int t_entrants);
+
+/// <summary>
+/// entry point for "--tournament [games per seat] [seed] [checkpoint file] [threads]"
+/// </summary>
+void runTournament(const std::vector<TournamentEntrant>& t_entrants, long long t_gamesPerSeat, std::uint64_t t_seed,
+	const std::string& t_checkpointFile, int t_threads);
@@ -0,0 +1,49 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Lock-free triple buffer for one writer thread and one reader thread. The writer fills its own
+/// slot and publishes it by swapping it with the middle slot, and the reader swaps the middle slot
+/// for its own whenever something new was published. Neither side ever waits, the reader always
+/// gets the latest complete value, and values the reader was too slow for are skipped.
+#pragma once
+
+#include <atomic>
+
+template <typename T>
+class TripleBuffer
+{
+public:
+	// writer only: the slot to fill in, stays the writer's until publish()
+	T& back() { return slots[backIndex]; }
+
+	void publish()
+	{
+		int previous = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+		backIndex = previous & INDEX;
+	}
+
+	// reader only: true if a newer value was published since the last call, front() then has it
+	bool consume()
+	{
+		if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+		{
+			return false;
+		}
+		int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+		frontIndex = previous & INDEX;
+		return true;
+	}
+
+	// reader only: the latest value consumed
+	const T& front() const { return slots[frontIndex]; }
+
+private:
+	static const int INDEX = 3;
+	static const int FRESH = 4;
+
+	T slots[3];
+	int backIndex = 0;
+	int frontIndex = 1;
+	std::atomic<int> middle{ 2 };
+};
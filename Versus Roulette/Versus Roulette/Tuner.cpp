@@ -0,0 +1,347 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+
+#include "Tuner.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// games are handed out to threads in blocks, each block has its own seed so the
+// totals don't depend on which thread happened to play it
+static const long long BLOCK_GAMES = 4096;
+
+// parameter ranges searched by the random search and the evolution strategy
+static const int MAX_ITEM_WEIGHT = 10;
+static const int MIN_HEALTH = 2;
+static const int MAX_HEALTH = 8;
+
+/// <summary>
+/// counts rounds and actions for the match length report
+/// </summary>
+struct LengthObserver
+{
+	void onRoundStart(const MatchState&) { rounds++; }
+	void onAction(const MatchState&, int, Action, const MatchState&) { actions++; }
+	void onMatchEnd(const MatchState&, int) {}
+
+	long long rounds = 0;
+	long long actions = 0;
+};
+
+double TuneResult::getUnfairness() const
+{
+	return std::fabs(getPlayerWinRate() - 0.5);
+}
+
+std::string describeRules(const RuleConfig& t_rules)
+{
+	std::ostringstream text;
+	text << "weights " << t_rules.itemWeights[0];
+	for (int index = 1; index < ITEM_TYPES; index++)
+	{
+		text << "/" << t_rules.itemWeights[index];
+	}
+	text << " shots " << t_rules.magazineSize << " health " << t_rules.startingHealth
+		<< " items " << t_rules.itemsPerRound;
+	return text.str();
+}
+
+BalanceTuner::BalanceTuner(std::uint64_t t_seed, long long t_gamesPerCandidate, int t_threads) :
+	seed{ t_seed },
+	gamesPerCandidate{ t_gamesPerCandidate },
+	threadCount{ t_threads },
+	candidatesTried{ 0 },
+	haveBest{ false }
+{
+	if (threadCount <= 0)
+	{
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	if (threadCount <= 0)
+	{
+		threadCount = 1;
+	}
+}
+
+/// <summary>
+/// plays gamesPerCandidate matches of t_rules across all threads.
+/// every candidate replays the same block seeds, so candidates are compared on the same luck
+/// </summary>
+TuneResult BalanceTuner::evaluate(const RuleConfig& t_rules)
+{
+	const long long blockCount = (gamesPerCandidate + BLOCK_GAMES - 1) / BLOCK_GAMES;
+	std::atomic<long long> nextBlock{ 0 };
+	std::vector<TuneResult> threadTotals(threadCount);
+
+	auto worker = [&](int t_thread)
+	{
+		TuneResult totals; // kept local so threads never write to shared cache lines while playing
+		MatchState state;
+		HeuristicPolicy playerPolicy;
+		HeuristicPolicy enemyPolicy;
+		LengthObserver observer;
+
+		for (long long block = nextBlock++; block < blockCount; block = nextBlock++)
+		{
+			FastRandom random(seed ^ (static_cast<std::uint64_t>(block) * 0xD1B54A32D192ED03ULL));
+			long long firstGame = block * BLOCK_GAMES;
+			long long lastGame = std::min(firstGame + BLOCK_GAMES, gamesPerCandidate);
+			for (long long game = firstGame; game < lastGame; game++)
+			{
+				int winner = playMatch(state, playerPolicy, enemyPolicy, random, t_rules, observer);
+				if (winner == PLAYER)
+				{
+					totals.playerWins++;
+				}
+				else if (winner == NO_WINNER)
+				{
+					totals.draws++;
+				}
+				totals.games++;
+			}
+		}
+		totals.rounds = observer.rounds;
+		totals.actions = observer.actions;
+		threadTotals[t_thread] = totals;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int thread = 1; thread < threadCount; thread++)
+	{
+		threads.emplace_back(worker, thread);
+	}
+	worker(0);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	TuneResult result;
+	result.rules = t_rules;
+	for (const TuneResult& totals : threadTotals)
+	{
+		result.games += totals.games;
+		result.playerWins += totals.playerWins;
+		result.draws += totals.draws;
+		result.rounds += totals.rounds;
+		result.actions += totals.actions;
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	record(result);
+	return result;
+}
+
+/// <summary>
+/// prints a candidate and keeps it if it's the fairest so far
+/// </summary>
+void BalanceTuner::record(const TuneResult& t_result)
+{
+	std::cout << "#" << candidatesTried++ << " " << describeRules(t_result.rules)
+		<< " | player wins " << 100.0 * t_result.getPlayerWinRate() << "%"
+		<< " | draws " << 100.0 * t_result.draws / std::max(t_result.games, 1LL) << "%"
+		<< " | rounds " << t_result.getMeanRounds()
+		<< " | actions " << t_result.getMeanActions()
+		<< " | " << static_cast<long long>(t_result.games / std::max(t_result.seconds, 1e-9)) << " games/s"
+		<< std::endl;
+
+	if (!haveBest || t_result.getUnfairness() < best.getUnfairness())
+	{
+		best = t_result;
+		haveBest = true;
+	}
+}
+
+bool BalanceTuner::isValid(const RuleConfig& t_rules) const
+{
+	int totalWeight = 0;
+	for (int index = 0; index < ITEM_TYPES; index++)
+	{
+		if (t_rules.itemWeights[index] < 0)
+		{
+			return false;
+		}
+		totalWeight += t_rules.itemWeights[index];
+	}
+	return totalWeight > 0
+		&& t_rules.magazineSize >= 2 && t_rules.magazineSize <= MAX_SHOTS
+		&& t_rules.startingHealth >= 1
+		&& t_rules.itemsPerRound >= 0 && t_rules.itemsPerRound <= MAX_ITEMS;
+}
+
+/// <summary>
+/// every magazine size, health and items per round combination with the default item weights
+/// </summary>
+void BalanceTuner::runGrid()
+{
+	RuleConfig rules = DEFAULT_RULES;
+	for (int shots = 2; shots <= MAX_SHOTS; shots++)
+	{
+		for (int health = MIN_HEALTH; health <= MAX_HEALTH; health++)
+		{
+			for (int items = 0; items <= MAX_ITEMS; items++)
+			{
+				rules.magazineSize = shots;
+				rules.startingHealth = health;
+				rules.itemsPerRound = items;
+				evaluate(rules);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// t_candidates rule sets drawn uniformly from the search ranges
+/// </summary>
+void BalanceTuner::runRandomSearch(int t_candidates)
+{
+	FastRandom random(seed + 1);
+	for (int candidate = 0; candidate < t_candidates; candidate++)
+	{
+		RuleConfig rules = DEFAULT_RULES;
+		do
+		{
+			for (int index = 0; index < ITEM_TYPES; index++)
+			{
+				rules.itemWeights[index] = random.nextInt(MAX_ITEM_WEIGHT + 1);
+			}
+			rules.magazineSize = 2 + random.nextInt(MAX_SHOTS - 1);
+			rules.startingHealth = MIN_HEALTH + random.nextInt(MAX_HEALTH - MIN_HEALTH + 1);
+			rules.itemsPerRound = random.nextInt(MAX_ITEMS + 1);
+		} while (!isValid(rules));
+		evaluate(rules);
+	}
+}
+
+/// <summary>
+/// small separable CMA-ES style search: sample around a mean with a per parameter step size,
+/// move the mean to the weighted best quarter and shrink or grow each step size to match
+/// how spread out those winners were
+/// </summary>
+void BalanceTuner::runEvolution(int t_generations, int t_populationSize)
+{
+	const int DIMENSIONS = ITEM_TYPES + 3;
+	const double lower[DIMENSIONS] = { 0, 0, 0, 0, 0, 2, MIN_HEALTH, 0 };
+	const double upper[DIMENSIONS] = { MAX_ITEM_WEIGHT, MAX_ITEM_WEIGHT, MAX_ITEM_WEIGHT, MAX_ITEM_WEIGHT, MAX_ITEM_WEIGHT,
+		MAX_SHOTS, MAX_HEALTH, MAX_ITEMS };
+
+	std::vector<double> mean = { 1, 1, 1, 1, 1, MAX_SHOTS, STARTING_HEALTH, ITEMS_PER_ROUND };
+	std::vector<double> sigma(DIMENSIONS);
+	for (int dimension = 0; dimension < DIMENSIONS; dimension++)
+	{
+		sigma[dimension] = (upper[dimension] - lower[dimension]) / 4.0;
+	}
+
+	const int parents = std::max(1, t_populationSize / 4);
+	std::vector<double> recombination(parents);
+	double weightSum = 0.0;
+	for (int parent = 0; parent < parents; parent++)
+	{
+		recombination[parent] = std::log(parents + 0.5) - std::log(parent + 1.0);
+		weightSum += recombination[parent];
+	}
+	for (double& weight : recombination)
+	{
+		weight /= weightSum;
+	}
+
+	FastRandom random(seed + 2);
+	for (int generation = 0; generation < t_generations; generation++)
+	{
+		std::vector<std::vector<double>> samples;
+		std::vector<double> scores;
+		while (static_cast<int>(samples.size()) < t_populationSize)
+		{
+			std::vector<double> sample(DIMENSIONS);
+			RuleConfig rules = DEFAULT_RULES;
+			for (int dimension = 0; dimension < DIMENSIONS; dimension++)
+			{
+				// Box-Muller normal sample, clamped into the search range
+				double u1 = std::max(random.nextDouble(), 1e-12);
+				double u2 = random.nextDouble();
+				double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+				sample[dimension] = std::min(upper[dimension], std::max(lower[dimension], mean[dimension] + sigma[dimension] * normal));
+			}
+			for (int index = 0; index < ITEM_TYPES; index++)
+			{
+				rules.itemWeights[index] = static_cast<int>(std::lround(sample[index]));
+			}
+			rules.magazineSize = static_cast<int>(std::lround(sample[ITEM_TYPES]));
+			rules.startingHealth = static_cast<int>(std::lround(sample[ITEM_TYPES + 1]));
+			rules.itemsPerRound = static_cast<int>(std::lround(sample[ITEM_TYPES + 2]));
+			if (!isValid(rules))
+			{
+				continue;
+			}
+			samples.push_back(sample);
+			scores.push_back(evaluate(rules).getUnfairness());
+		}
+
+		std::vector<int> order(samples.size());
+		for (int index = 0; index < static_cast<int>(order.size()); index++)
+		{
+			order[index] = index;
+		}
+		std::sort(order.begin(), order.end(), [&](int t_a, int t_b) { return scores[t_a] < scores[t_b]; });
+
+		std::vector<double> newMean(DIMENSIONS, 0.0);
+		for (int parent = 0; parent < parents; parent++)
+		{
+			for (int dimension = 0; dimension < DIMENSIONS; dimension++)
+			{
+				newMean[dimension] += recombination[parent] * samples[order[parent]][dimension];
+			}
+		}
+		for (int dimension = 0; dimension < DIMENSIONS; dimension++)
+		{
+			double spread = 0.0;
+			for (int parent = 0; parent < parents; parent++)
+			{
+				double step = samples[order[parent]][dimension] - mean[dimension];
+				spread += recombination[parent] * step * step;
+			}
+			// blend towards the winners' spread, never below half a step so rounding can still move
+			sigma[dimension] = std::max(0.5, 0.7 * sigma[dimension] + 0.3 * std::sqrt(spread));
+		}
+		mean = newMean;
+
+		std::cout << "generation " << generation << " best unfairness " << 100.0 * scores[order[0]] << "%" << std::endl;
+	}
+}
+
+void runBalanceTuner(const std::string& t_mode, long long t_gamesPerCandidate, std::uint64_t t_seed, int t_candidates)
+{
+	BalanceTuner tuner(t_seed, t_gamesPerCandidate);
+	std::cout << "tuning with " << tuner.getThreadCount() << " threads, " << t_gamesPerCandidate
+		<< " games per candidate, seed " << t_seed << std::endl;
+
+	tuner.evaluate(DEFAULT_RULES); // baseline to compare against
+	if (t_mode == "grid")
+	{
+		tuner.runGrid();
+	}
+	else if (t_mode == "random")
+	{
+		tuner.runRandomSearch(t_candidates);
+	}
+	else if (t_mode == "evolve")
+	{
+		tuner.runEvolution(std::max(1, t_candidates / 12), 12);
+	}
+	else
+	{
+		std::cout << "unknown tuning mode " << t_mode << " (grid, random or evolve)" << std::endl;
+		return;
+	}
+
+	const TuneResult& best = tuner.getBest();
+	std::cout << "fairest: " << describeRules(best.rules) << " | player wins " << 100.0 * best.getPlayerWinRate()
+		<< "% | rounds " << best.getMeanRounds() << " | actions " << best.getMeanActions() << std::endl;
+}
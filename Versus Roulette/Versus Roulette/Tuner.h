@@ -0,0 +1,66 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// Balance tuner: searches RuleConfig space (item weights, magazine size, starting health,
+/// items per round) by playing heuristic vs heuristic matches on every core and scoring
+/// how close the player seat's win rate is to 50%.
+/// The same seed always gives the same numbers, whatever the thread count.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MatchState.h"
+
+/// <summary>
+/// totals for one candidate rule set
+/// </summary>
+struct TuneResult
+{
+	RuleConfig rules;
+	long long games = 0;
+	long long playerWins = 0;
+	long long draws = 0; // matches that hit maxRounds level on health
+	long long rounds = 0;
+	long long actions = 0;
+	double seconds = 0.0;
+
+	double getPlayerWinRate() const { return games ? (playerWins + 0.5 * draws) / games : 0.0; } // draws count as half
+	double getUnfairness() const; // distance of the player win rate from 50%, lower is fairer
+	double getMeanRounds() const { return games ? static_cast<double>(rounds) / games : 0.0; }
+	double getMeanActions() const { return games ? static_cast<double>(actions) / games : 0.0; }
+};
+
+class BalanceTuner
+{
+public:
+	BalanceTuner(std::uint64_t t_seed, long long t_gamesPerCandidate, int t_threads = 0);
+
+	TuneResult evaluate(const RuleConfig& t_rules);
+
+	void runGrid();
+	void runRandomSearch(int t_candidates);
+	void runEvolution(int t_generations, int t_populationSize);
+
+	const TuneResult& getBest() const { return best; }
+	int getThreadCount() const { return threadCount; }
+
+private:
+	void record(const TuneResult& t_result);
+	bool isValid(const RuleConfig& t_rules) const;
+
+	std::uint64_t seed;
+	long long gamesPerCandidate;
+	int threadCount;
+	int candidatesTried;
+	TuneResult best;
+	bool haveBest;
+};
+
+std::string describeRules(const RuleConfig& t_rules);
+
+/// <summary>
+/// entry point for "--tune grid|random|evolve [gamesPerCandidate] [seed] [candidates]"
+/// </summary>
+void runBalanceTuner(const std::string& t_mode, long long t_gamesPerCandidate, std::uint64_t t_seed, int t_candidates);
@@ -0,0 +1,237 @@
+/// <summary>
+/// @author Tymoteusz Walichnowski
+/// @date October 2026
+/// </summary>
+/// An AI turn written as one straight-line coroutine: it co_awaits a delay or the robots' animations
+/// between steps, and Game resumes it once a tick. Nothing re-runs while it waits, the tick just counts
+/// down. Headless hosts hand out waits that are already over, so the same script runs straight through.
+/// Needs C++20 (the project builds with /std:c++20).
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+#include "MatchState.h"
+#include "TimerWheel.h"
+
+const int static AI_ITEM_FRAMES = 30; // frames between each item an AI uses
+const int static AI_SHOOT_FRAMES = 180; // frames into its turn before an AI takes its shot
+
+class TurnScript
+{
+public:
+	struct promise_type
+	{
+		int framesLeft = 0; // ticks until the current delay is over, when it isn't on a TimerWheel
+		std::function<bool()> waitUntil; // resumes once this returns true
+		TimerWheel* wheel = nullptr; // wheel holding the current delay, it resumes the script itself
+		TimerWheel::TimerId timer = TimerWheel::NO_TIMER;
+
+		TurnScript get_return_object() { return TurnScript(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; } // first step happens on the first tick
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+
+	/// <summary>
+	/// co_await TurnScript::Delay{ frames, wheel }, a delay of 0 doesn't suspend at all.
+	/// with a wheel the timer resumes the script, otherwise tick() counts the frames down
+	/// </summary>
+	struct Delay
+	{
+		int frames;
+		TimerWheel* wheel = nullptr;
+
+		bool await_ready() const noexcept { return frames <= 0; }
+		void await_suspend(std::coroutine_handle<promise_type> t_handle)
+		{
+			if (wheel == nullptr)
+			{
+				t_handle.promise().framesLeft = frames;
+				return;
+			}
+			t_handle.promise().wheel = wheel;
+			t_handle.promise().timer = wheel->schedule(static_cast<std::uint32_t>(frames), [t_handle]()
+			{
+				t_handle.promise().timer = TimerWheel::NO_TIMER;
+				t_handle.resume();
+			});
+		}
+		void await_resume() const noexcept {}
+	};
+
+	/// <summary>
+	/// co_await TurnScript::WaitUntil{ condition }, an empty condition counts as already true
+	/// </summary>
+	struct WaitUntil
+	{
+		std::function<bool()> condition;
+
+		bool await_ready() const { return !condition || condition(); }
+		void await_suspend(std::coroutine_handle<promise_type> t_handle) { t_handle.promise().waitUntil = std::move(condition); }
+		void await_resume() const noexcept {}
+	};
+
+	TurnScript() = default;
+	TurnScript(TurnScript&& t_other) noexcept : handle(std::exchange(t_other.handle, nullptr)) {}
+	TurnScript& operator=(TurnScript&& t_other) noexcept
+	{
+		if (this != &t_other)
+		{
+			destroy();
+			handle = std::exchange(t_other.handle, nullptr);
+		}
+		return *this;
+	}
+	TurnScript(const TurnScript&) = delete;
+	TurnScript& operator=(const TurnScript&) = delete;
+	~TurnScript() { destroy(); }
+
+	bool isDone() const { return !handle || handle.done(); }
+
+	/// <summary>
+	/// called once a tick, resumes the script only when what it's waiting on is over
+	/// </summary>
+	void tick()
+	{
+		if (isDone())
+		{
+			return;
+		}
+		promise_type& promise = handle.promise();
+		if (promise.timer != TimerWheel::NO_TIMER)
+		{
+			return; // the wheel will resume it
+		}
+		if (promise.framesLeft > 0 && --promise.framesLeft > 0)
+		{
+			return;
+		}
+		if (promise.waitUntil)
+		{
+			if (!promise.waitUntil())
+			{
+				return;
+			}
+			promise.waitUntil = nullptr;
+		}
+		handle.resume();
+	}
+
+	/// <summary>
+	/// runs the script to the end, skipping any waits
+	/// </summary>
+	void runToEnd()
+	{
+		while (!isDone())
+		{
+			cancelTimer();
+			handle.promise().framesLeft = 0;
+			handle.promise().waitUntil = nullptr;
+			handle.resume();
+		}
+	}
+
+private:
+	explicit TurnScript(std::coroutine_handle<promise_type> t_handle) : handle(t_handle) {}
+
+	void cancelTimer()
+	{
+		promise_type& promise = handle.promise();
+		if (promise.timer != TimerWheel::NO_TIMER)
+		{
+			promise.wheel->cancel(promise.timer);
+			promise.timer = TimerWheel::NO_TIMER;
+		}
+	}
+
+	void destroy()
+	{
+		if (handle)
+		{
+			cancelTimer(); // the wheel mustn't resume a script that's gone
+			handle.destroy();
+			handle = nullptr;
+		}
+	}
+
+	std::coroutine_handle<promise_type> handle;
+};
+
+/// <summary>
+/// one AI turn for t_seat: items one at a time, then the shot once the turn has gone on AI_SHOOT_FRAMES
+/// and nobody is mid animation. Ends after the shot, the host starts another if the turn carries on.
+/// TurnHost provides observeMatch(), applyAction(seat, action), turnDelay(frames) and animationsFinished()
+/// </summary>
+template <typename TurnHost, typename Policy>
+TurnScript playTurnScript(TurnHost& t_host, Policy& t_policy, int t_seat)
+{
+	int framesWaited = 0;
+	while (true)
+	{
+		Action action;
+		{
+			const auto& state = t_host.observeMatch();
+			if (state.isOver() || state.needsNewRound()) // a rubbish bin can empty the taser mid turn
+			{
+				co_return;
+			}
+			action = t_policy.chooseAction(Observation(state, t_seat));
+			if (!state.isLegal(t_seat, action))
+			{
+				action = shootOpponentAction();
+			}
+		}
+
+		if (action.type == USE_ITEM_ACTION)
+		{
+			co_await t_host.turnDelay(AI_ITEM_FRAMES);
+			framesWaited += AI_ITEM_FRAMES;
+			if (t_host.observeMatch().isLegal(t_seat, action)) // the other seat may have used an item meanwhile
+			{
+				t_host.applyAction(t_seat, action);
+			}
+			continue;
+		}
+
+		co_await t_host.turnDelay(AI_SHOOT_FRAMES + 1 - framesWaited);
+		co_await t_host.animationsFinished();
+		t_host.applyAction(t_seat, action);
+		co_return;
+	}
+}
+
+/// <summary>
+/// TurnHost for a bare MatchState, every wait is already over
+/// </summary>
+struct HeadlessTurnHost
+{
+	MatchState& state;
+
+	const MatchState& observeMatch() const { return state; }
+	void applyAction(int t_seat, Action t_action) { state.apply(t_seat, t_action); }
+	TurnScript::Delay turnDelay(int) const { return TurnScript::Delay{ 0 }; }
+	TurnScript::WaitUntil animationsFinished() const { return TurnScript::WaitUntil{}; }
+};
+
+/// <summary>
+/// plays a match out through playTurnScript instead of continueMatch's loop, same result for the same seed
+/// </summary>
+template <typename PlayerPolicy, typename EnemyPolicy>
+int playScriptedMatch(MatchState& t_state, PlayerPolicy& t_playerPolicy, EnemyPolicy& t_enemyPolicy, FastRandom& t_random)
+{
+	t_state.reset();
+	HeadlessTurnHost host{ t_state };
+	while (!t_state.isOver() && !t_state.isOutOfRounds())
+	{
+		if (t_state.needsNewRound())
+		{
+			t_state.startRound(t_random);
+		}
+		TurnScript script = t_state.turn == PLAYER ? playTurnScript(host, t_playerPolicy, PLAYER) : playTurnScript(host, t_enemyPolicy, ENEMY);
+		script.runToEnd();
+	}
+	return t_state.winner();
+}
@@ -21,14 +21,248 @@
 
 
 #include "Game.h"
+#include "Simulator.h"
+#include "Tuner.h"
+#include "MatchStats.h"
+#include "Snapshot.h"
+#include "Lockstep.h"
+#include "MatchServer.h"
+#include "Spectator.h"
+#include "TextureCache.h"
+#include "SessionRecording.h"
+#include "InvariantChecker.h"
+#include "Tournament.h"
+#include "FreeForAll.h"
+#include "FreeForAllScreen.h"
+#include "ParticleSystem.h"
+#include "MatchGrid.h"
+#include "MatchExport.h"
+#include <cstdlib>
+#include <cstring>
+#include <thread>
 
 /// <summary>
 /// main enrtry point
+/// "--simulate [matches] [seed]" benchmarks the AI policies headless instead of opening the window
+/// "--tune grid|random|evolve [gamesPerCandidate] [seed] [candidates]" runs the balance tuner
+/// "--stats [matches] [seed] [csv file] [binary file]" collects match statistics
+/// "--export [matches] [seed] [file] [threads]" writes every action of every match to a columnar file,
+/// "--export-read [file]" checks one and prints the size of each column, exits 1 if it is damaged
+/// "--simulate-from [snapshot file] [matches]" plays a quick save out headless
+/// "--rule-variants [matches] [seed]" times the compile time rule variants against runtime configured rules
+/// "--perft [depth] [positions] [seed]" checks make / undo on the match state and times it against copying
+/// "--check-invariants [matches] [seed] [threads]" plays random matches checking the rules after every action, exits 1 if any match broke one
+/// "--tournament [games per seat] [seed] [checkpoint file] [threads]" rates every AI against every other
+/// "--ffa [matches] [seed]" times free for all matches from 2 to 16 robots, "--ffa-watch [robots] [seed]" watches one
+/// "--grid [matches] [seed] [threads]" watches 16 to 64 AI matches at once, played on worker threads
+/// "--host [port]" and "--join [address] [port]" play a two player match over the network
+/// "--net-selftest [port] [matches]" checks the network match code over loopback
+/// "--server [port] [shards]" hosts headless matches for network clients
+/// "--load [address] [port] [connections] [matches per connection] [total matches]" load tests the server
+/// "--broadcast [port] [recording file]" plays as normal and streams the match to spectators
+/// "--spectate [address] [port]" and "--spectate-file [recording file]" watch a broadcast
+/// "--render-bench [null|record] [frames] [golden file]" times render() without a window,
+/// record compares the draw lists with the golden file, or writes it if there isn't one yet, and exits 1 if they differ
+/// "--texture-cache-bench [image folder]" times PNG decoding against the decoded texture cache
+/// "--particle-bench [particles] [frames]" times the particle update and vertex building
+/// "--texture-budget [MB]" anywhere on the command line caps the memory kept by screen textures
+/// "--single-thread" anywhere on the command line updates and draws on one thread like before
+/// "--record-session [file]" anywhere on the command line saves every key press for "--replay-check"
+/// "--replay-check [session file or folder] [tick budget us] [average budget us] [render]" plays
+/// recorded sessions headless (SESSIONS by default), exits 1 if any has a different end state or ticks over budget
 /// </summary>
 /// <returns>success or failure</returns>
-int main()
+int main(int argc, char* argv[])
 {
+	if (argc > 1 && std::strcmp(argv[1], "--simulate") == 0)
+	{
+		int matches = argc > 2 ? std::atoi(argv[2]) : 1000000;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		runSimulatorBenchmark(matches, seed);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--tune") == 0)
+	{
+		std::string mode = argc > 2 ? argv[2] : "grid";
+		long long games = argc > 3 ? std::atoll(argv[3]) : 1000000;
+		unsigned long long seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+		int candidates = argc > 5 ? std::atoi(argv[5]) : 60;
+		runBalanceTuner(mode, games, seed, candidates);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--stats") == 0)
+	{
+		long long matches = argc > 2 ? std::atoll(argv[2]) : 1000000;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		runStatisticsCollection(matches, seed, argc > 4 ? argv[4] : "stats.csv", argc > 5 ? argv[5] : "");
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--export") == 0)
+	{
+		long long matches = argc > 2 ? std::atoll(argv[2]) : 1000000;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		runMatchExport(matches, seed, argc > 4 ? argv[4] : "matches.vrcx", argc > 5 ? std::atoi(argv[5]) : 0);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--export-read") == 0)
+	{
+		return runExportSummary(argc > 2 ? argv[2] : "matches.vrcx") ? 0 : 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--simulate-from") == 0)
+	{
+		runSnapshotBenchmark(argc > 2 ? argv[2] : QUICKSAVE_FILE, argc > 3 ? std::atoi(argv[3]) : 1000000);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--rule-variants") == 0)
+	{
+		int matches = argc > 2 ? std::atoi(argv[2]) : 1000000;
+		runRuleVariantBenchmark(matches, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--ffa") == 0)
+	{
+		int matches = argc > 2 ? std::atoi(argv[2]) : 100000;
+		runFreeForAllBenchmark(matches, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--ffa-watch") == 0)
+	{
+		int seats = argc > 2 ? std::atoi(argv[2]) : 6;
+		runFreeForAllWindow(seats, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--grid") == 0)
+	{
+		int matches = argc > 2 ? std::atoi(argv[2]) : 36;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		runMatchGrid(matches, seed, argc > 4 ? std::atoi(argv[4]) : 0);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--perft") == 0)
+	{
+		int depth = argc > 2 ? std::atoi(argv[2]) : 10;
+		int positions = argc > 3 ? std::atoi(argv[3]) : 1000;
+		runMakeUnmakeBenchmark(depth, positions, argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1);
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--check-invariants") == 0)
+	{
+		long long matches = argc > 2 ? std::atoll(argv[2]) : 100000000;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		return runInvariantCheck(matches, seed, argc > 4 ? std::atoi(argv[4]) : 0) == 0 ? 0 : 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--tournament") == 0)
+	{
+		long long games = argc > 2 ? std::atoll(argv[2]) : 10000;
+		unsigned long long seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+		runTournament(defaultEntrants(seed), games, seed, argc > 4 ? argv[4] : "tournament.ckpt", argc > 5 ? std::atoi(argv[5]) : 0);
+		return 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--net-selftest") == 0)
+	{
+		unsigned short port = static_cast<unsigned short>(argc > 2 ? std::atoi(argv[2]) : DEFAULT_NET_PORT);
+		return runNetworkSelfTest(port, argc > 3 ? std::atoi(argv[3]) : 1000) ? 0 : 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--server") == 0)
+	{
+		unsigned short port = static_cast<unsigned short>(argc > 2 ? std::atoi(argv[2]) : DEFAULT_SERVER_PORT);
+		runMatchServer(port, argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency()));
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--load") == 0)
+	{
+		unsigned short port = static_cast<unsigned short>(argc > 3 ? std::atoi(argv[3]) : DEFAULT_SERVER_PORT);
+		runLoadGenerator(argc > 2 ? argv[2] : "127.0.0.1", port, argc > 4 ? std::atoi(argv[4]) : 100,
+			argc > 5 ? std::atoi(argv[5]) : 100, argc > 6 ? std::atoll(argv[6]) : 1000000);
+		return 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--spectate") == 0)
+	{
+		runSpectator(argc > 2 ? argv[2] : "127.0.0.1", static_cast<unsigned short>(argc > 3 ? std::atoi(argv[3]) : DEFAULT_SPECTATOR_PORT));
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--spectate-file") == 0)
+	{
+		runSpectatorFile(argc > 2 ? argv[2] : "match.vrsp");
+		return 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--texture-cache-bench") == 0)
+	{
+		runTextureCacheBenchmark(argc > 2 ? argv[2] : "ASSETS\\IMAGES");
+		return 1;
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--particle-bench") == 0)
+	{
+		int particles = argc > 2 ? std::atoi(argv[2]) : 30000;
+		runParticleBenchmark(particles, argc > 3 ? std::atoi(argv[3]) : 600);
+		return 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--replay-check") == 0)
+	{
+		long long tickBudget = argc > 3 ? std::atoll(argv[3]) : 4000;
+		long long averageBudget = argc > 4 ? std::atoll(argv[4]) : 500;
+		bool render = argc > 5 && std::strcmp(argv[5], "render") == 0;
+		return runReplayCheck(argc > 2 ? argv[2] : "SESSIONS", tickBudget, averageBudget, render) == 0 ? 0 : 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "--render-bench") == 0)
+	{
+		std::string mode = argc > 2 ? argv[2] : "null";
+		int frames = argc > 3 ? std::atoi(argv[3]) : 3600;
+		std::string golden = argc > 4 ? argv[4] : "render.golden";
+		Game headlessGame(true);
+		if (mode == "record")
+		{
+			RecordingRenderBackend recording;
+			headlessGame.runRenderBenchmark(recording, frames);
+			int differences = recording.compare(golden);
+			if (differences < 0)
+			{
+				recording.save(golden);
+				std::cout << "wrote " << recording.getLines().size() << " draws to " << golden << std::endl;
+				return 0;
+			}
+			std::cout << differences << " draws differ from " << golden << std::endl;
+			return differences == 0 ? 0 : 1; // a check, so 0 is a pass like any other tool
+		}
+		NullRenderBackend null;
+		headlessGame.runRenderBenchmark(null, frames);
+		return 0;
+	}
+
 	Game game;
+	for (int arg = 1; arg < argc; arg++)
+	{
+		if (std::strcmp(argv[arg], "--texture-budget") == 0 && arg + 1 < argc)
+		{
+			game.setTextureBudget(static_cast<std::size_t>(std::atoll(argv[arg + 1])) * 1024 * 1024);
+		}
+		if (std::strcmp(argv[arg], "--single-thread") == 0)
+		{
+			game.setThreadedRendering(false);
+		}
+		if (std::strcmp(argv[arg], "--record-session") == 0 && arg + 1 < argc)
+		{
+			game.startSessionRecording(argv[arg + 1]);
+		}
+	}
+	if (argc > 1 && std::strcmp(argv[1], "--host") == 0)
+	{
+		game.hostNetworkMatch(static_cast<unsigned short>(argc > 2 ? std::atoi(argv[2]) : DEFAULT_NET_PORT));
+	}
+	else if (argc > 1 && std::strcmp(argv[1], "--join") == 0)
+	{
+		game.joinNetworkMatch(argc > 2 ? argv[2] : "127.0.0.1", static_cast<unsigned short>(argc > 3 ? std::atoi(argv[3]) : DEFAULT_NET_PORT));
+	}
+	else if (argc > 1 && std::strcmp(argv[1], "--broadcast") == 0)
+	{
+		game.startBroadcast(static_cast<unsigned short>(argc > 2 ? std::atoi(argv[2]) : DEFAULT_SPECTATOR_PORT), argc > 3 ? argv[3] : "");
+	}
 	game.run();
 
 	return 1; // success